@@ -0,0 +1,94 @@
+#ifndef BATCHFIT_HPP
+#define BATCHFIT_HPP
+
+/**
+ * @file batchfit.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Fit lines and circles to many small clusters of a flat point array at once
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "circle.hpp"
+#include "parallel.hpp"
+#include "sline.hpp"
+
+namespace ns_geo {
+#pragma region BatchFitter
+
+  /**
+   * @brief fit a model to each cluster of a flat point array
+   *
+   * @attention the cluster 'k' is 'points[offsets[k], offsets[k + 1])', so there are
+   * 'offsets.size() - 1' clusters, each with at least one point. the clusters are spread over
+   * the threads in chunks and fitted in place by the span forms of 'SLine2::fit' and
+   * 'Circle::fit', which keep everything on the stack, so no fit allocates and no scratch
+   * has to be kept per thread. the models are written into 'out', which is resized to the
+   * number of clusters, so a reused one doesn't allocate either unless it has to grow.
+   */
+  class BatchFitter {
+  public:
+    using value_type = double;
+    using point_type = Point2<value_type>;
+    using pointset_type = PointSet2<value_type>;
+    using self_type = BatchFitter;
+
+  public:
+    /**
+     * @brief the total least squares line of each cluster
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static void lines(const pointset_type &points, const std::vector<std::size_t> &offsets, std::vector<SLine2> &out,
+                      std::size_t threads = 0) {
+      std::size_t num = clusters(offsets);
+      out.resize(num, SLine2(0.0, 1.0, 0.0));
+      SLine2 *res = out.data();
+      const point_type *pts = points.data();
+      parallelFor(
+          0, num, [&](std::size_t k, std::size_t) { res[k] = SLine2::fit(pts + offsets[k], offsets[k + 1] - offsets[k]); },
+          threads, GRAIN);
+    }
+
+    /**
+     * @brief the geometric circle of each cluster
+     *
+     * @param iter the max number of Levenberg-Marquardt iterations of a fit
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static void circles(const pointset_type &points, const std::vector<std::size_t> &offsets, std::vector<Circle> &out,
+                        const ushort iter = 10, std::size_t threads = 0) {
+      std::size_t num = clusters(offsets);
+      out.resize(num, Circle(point_type(0.0, 0.0), 0.0));
+      Circle *res = out.data();
+      const point_type *pts = points.data();
+      parallelFor(
+          0, num, [&](std::size_t k, std::size_t) { res[k] = Circle::fit(pts + offsets[k], offsets[k + 1] - offsets[k], iter); },
+          threads, GRAIN);
+    }
+
+    /**
+     * @brief the offsets of clusters of the given sizes
+     */
+    static std::vector<std::size_t> offsets(const std::vector<std::size_t> &sizes) {
+      std::vector<std::size_t> res(sizes.size() + 1, 0);
+      for (std::size_t k = 0; k != sizes.size(); ++k)
+        res[k + 1] = res[k] + sizes[k];
+      return res;
+    }
+
+  protected:
+    // the clusters a worker claims at a time, they are small
+    static constexpr std::size_t GRAIN = 256;
+
+    static inline std::size_t clusters(const std::vector<std::size_t> &offsets) {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
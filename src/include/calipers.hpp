@@ -0,0 +1,264 @@
+#ifndef CALIPERS_HPP
+#define CALIPERS_HPP
+
+/**
+ * @file calipers.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Convex hulls and the rotating calipers: diameter, width and oriented bounding rectangles
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "parallel.hpp"
+#include "polygon.hpp"
+
+namespace ns_geo {
+#pragma region RotatingCalipers
+
+  /**
+   * @brief measure point sets by rotating a pair of calipers around their convex hull
+   *
+   * @attention the hull is Andrew's monotone chain, O(n log n), counter-clockwise without
+   * collinear vertices. the calipers then visit every hull edge once while the opposite
+   * supporting lines advance monotonically, so all the measures together take O(h) for h hull
+   * vertices. the oriented rectangles have a side on a hull edge, which holds for both the
+   * minimum area and the minimum perimeter ones. the batch form keeps one scratch buffer per
+   * thread, so the clusters are processed without allocating per call.
+   */
+  template <typename Ty = float>
+  class RotatingCalipers {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using pointset_type = PointSet2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using self_type = RotatingCalipers<value_type>;
+
+    /**
+     * @brief the two points farthest apart
+     */
+    struct Diameter {
+      double length = 0.0;
+      point_type p1, p2;
+    };
+
+    /**
+     * @brief the narrowest strip holding the points, between the line through a hull edge and
+     * the parallel line through the opposite vertex
+     */
+    struct Width {
+      double length = 0.0;
+      point_type edgeFrom, edgeTo, opposite;
+    };
+
+    /**
+     * @brief a rectangle of 'width' along the direction 'angle' and 'height' across it
+     */
+    struct OrientedRect {
+      point_type center;
+      double width = 0.0, height = 0.0, angle = 0.0;
+
+      [[nodiscard]] inline double area() const { return width * height; }
+
+      [[nodiscard]] inline double perimeter() const { return 2.0 * (width + height); }
+
+      /**
+       * @brief the corners, counter-clockwise
+       */
+      [[nodiscard]] std::array<point_type, 4> corners() const {
+        double ux = std::cos(angle), uy = std::sin(angle);
+        double hw = 0.5 * width, hh = 0.5 * height;
+        std::array<point_type, 4> res;
+        const double su[4] = {-1.0, 1.0, 1.0, -1.0}, sv[4] = {-1.0, -1.0, 1.0, 1.0};
+        for (int k = 0; k != 4; ++k)
+          res[k] = point_type(static_cast<value_type>(center.x + su[k] * hw * ux - sv[k] * hh * uy),
+                              static_cast<value_type>(center.y + su[k] * hw * uy + sv[k] * hh * ux));
+        return res;
+      }
+    };
+
+    /**
+     * @brief all the measures of a point set at once
+     */
+    struct Measures {
+      Diameter diameter;
+      Width width;
+      OrientedRect minArea;
+      OrientedRect minPerimeter;
+    };
+
+    /**
+     * @brief the buffers reused from call to call
+     */
+    struct Scratch {
+      std::vector<std::array<double, 2>> points;
+      std::vector<std::array<double, 2>> hull;
+    };
+
+  public:
+    /**
+     * @brief the convex hull, counter-clockwise
+     */
+    static polygon_type hull(const pointset_type &points) {
+      Scratch scratch;
+      buildHull(points, scratch);
+      polygon_type res;
+      for (const auto &p : scratch.hull)
+        res.push_back(toPoint(p));
+      return res;
+    }
+
+    static Diameter diameter(const pointset_type &points) { return measure(points).diameter; }
+
+    static Width width(const pointset_type &points) { return measure(points).width; }
+
+    static OrientedRect minAreaRect(const pointset_type &points) { return measure(points).minArea; }
+
+    static OrientedRect minPerimeterRect(const pointset_type &points) { return measure(points).minPerimeter; }
+
+    static Measures measure(const pointset_type &points) {
+      Scratch scratch;
+      return measure(points, scratch);
+    }
+
+    /**
+     * @brief measure a point set with the given buffers
+     */
+    static Measures measure(const pointset_type &points, Scratch &scratch) {
+      buildHull(points, scratch);
+      return calipers(scratch.hull);
+    }
+
+    /**
+     * @brief measure many small clusters
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static std::vector<Measures> measure(const std::vector<pointset_type> &clusters, std::size_t threads = 0) {
+      const std::size_t grain = 64;
+      std::vector<Measures> res(clusters.size());
+      std::vector<Scratch> scratch(parallelWorkers(clusters.size(), threads, grain));
+      parallelFor(
+          0, clusters.size(), [&](std::size_t i, std::size_t worker) { res[i] = measure(clusters[i], scratch[worker]); },
+          threads, grain);
+      return res;
+    }
+
+  protected:
+    using coord_type = std::array<double, 2>;
+
+    static inline point_type toPoint(const coord_type &p) {
+      return point_type(static_cast<value_type>(p[0]), static_cast<value_type>(p[1]));
+    }
+
+    static inline double cross(const coord_type &o, const coord_type &a, const coord_type &b) {
+      return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+    }
+
+    static inline double dot(const coord_type &p, double ux, double uy) { return p[0] * ux + p[1] * uy; }
+
+    /**
+     * @brief Andrew's monotone chain into 'scratch.hull'
+     */
+    static void buildHull(const pointset_type &points, Scratch &scratch) {
+      auto &pts = scratch.points;
+      auto &hull = scratch.hull;
+      pts.clear(), hull.clear();
+      for (const auto &p : points)
+        pts.push_back({static_cast<double>(p.x), static_cast<double>(p.y)});
+      std::sort(pts.begin(), pts.end());
+      pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+      if (pts.size() < 3) {
+        hull.assign(pts.cbegin(), pts.cend());
+        return;
+      }
+      hull.resize(2 * pts.size());
+      std::size_t k = 0;
+      // the lower chain, then the upper one
+      for (std::size_t i = 0; i != pts.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0.0)
+          --k;
+        hull[k++] = pts[i];
+      }
+      for (std::size_t i = pts.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0.0)
+          --k;
+        hull[k++] = pts[i];
+      }
+      // the last point repeats the first
+      hull.resize(k - 1);
+    }
+
+    static OrientedRect rect(double ux, double uy, double u0, double u1, double v0, double v1) {
+      OrientedRect r;
+      double cu = 0.5 * (u0 + u1), cv = 0.5 * (v0 + v1);
+      r.center = point_type(static_cast<value_type>(cu * ux - cv * uy), static_cast<value_type>(cu * uy + cv * ux));
+      r.width = u1 - u0, r.height = v1 - v0, r.angle = std::atan2(uy, ux);
+      return r;
+    }
+
+    static Measures calipers(const std::vector<coord_type> &hull) {
+      Measures res;
+      std::size_t h = hull.size();
+      if (h == 0)
+        return res;
+      if (h < 3) {
+        // a point or a segment, the rectangles collapse onto it
+        const auto &a = hull.front(), &b = hull.back();
+        double len = std::hypot(b[0] - a[0], b[1] - a[1]);
+        res.diameter = Diameter{len, toPoint(a), toPoint(b)};
+        res.width = Width{0.0, toPoint(a), toPoint(b), toPoint(a)};
+        double ux = 1.0, uy = 0.0;
+        if (len > 0.0)
+          ux = (b[0] - a[0]) / len, uy = (b[1] - a[1]) / len;
+        double v = -a[0] * uy + a[1] * ux;
+        res.minArea = res.minPerimeter = rect(ux, uy, dot(a, ux, uy), dot(b, ux, uy), v, v);
+        return res;
+      }
+      res.width.length = res.minArea.width = res.minPerimeter.width = std::numeric_limits<double>::infinity();
+      res.minArea.height = res.minPerimeter.height = 1.0;
+      // the farthest point along the edge, across it, and against it
+      std::size_t right = 1, top = 1, left = 1;
+      for (std::size_t i = 0; i != h; ++i) {
+        const auto &a = hull[i], &b = hull[(i + 1) % h];
+        double len = std::hypot(b[0] - a[0], b[1] - a[1]);
+        double ux = (b[0] - a[0]) / len, uy = (b[1] - a[1]) / len;
+        // the hull lies on the left of the edge, along 'v'
+        double vx = -uy, vy = ux;
+        while (dot(hull[(right + 1) % h], ux, uy) > dot(hull[right], ux, uy))
+          right = (right + 1) % h;
+        if (i == 0)
+          top = right;
+        while (dot(hull[(top + 1) % h], vx, vy) > dot(hull[top], vx, vy))
+          top = (top + 1) % h;
+        if (i == 0)
+          left = top;
+        while (dot(hull[(left + 1) % h], ux, uy) < dot(hull[left], ux, uy))
+          left = (left + 1) % h;
+
+        // the vertices of the edge are antipodal to the top one
+        for (const auto *p : {&a, &b}) {
+          double d = std::hypot(hull[top][0] - (*p)[0], hull[top][1] - (*p)[1]);
+          if (d > res.diameter.length)
+            res.diameter = Diameter{d, toPoint(*p), toPoint(hull[top])};
+        }
+        double v0 = dot(a, vx, vy), v1 = dot(hull[top], vx, vy);
+        if (v1 - v0 < res.width.length)
+          res.width = Width{v1 - v0, toPoint(a), toPoint(b), toPoint(hull[top])};
+        double u0 = dot(hull[left], ux, uy), u1 = dot(hull[right], ux, uy);
+        double w = u1 - u0, t = v1 - v0;
+        if (w * t < res.minArea.area())
+          res.minArea = rect(ux, uy, u0, u1, v0, v1);
+        if (w + t < res.minPerimeter.width + res.minPerimeter.height)
+          res.minPerimeter = rect(ux, uy, u0, u1, v0, v1);
+      }
+      return res;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
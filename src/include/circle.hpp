@@ -39,39 +39,262 @@ namespace ns_geo {
 
     // Calculate the distance from a point to the nearest point on the circle
     value_type distance(const point_type &p) const {
-      return ns_geo::distance(nearest(p), p);
+      value_type deltaX = p.x - cen.x, deltaY = p.y - cen.y;
+      return std::abs(std::sqrt(deltaX * deltaX + deltaY * deltaY) - rad);
     }
 
-    // find the nearest point on the circle
+    // find the nearest point on the circle, by scaling the offset from the center to the radius
     point_type nearest(const point_type &p) const {
       value_type deltaX = p.x - cen.x, deltaY = p.y - cen.y;
-      value_type theta = std::atan2(deltaY, deltaX);
-      if (deltaY < 0.0) {
-        theta += 2.0 * M_PI;
+      value_type len2 = deltaX * deltaX + deltaY * deltaY;
+      // the center itself goes to the point at angle zero
+      if (len2 == 0.0)
+        return point_type(cen.x + rad, cen.y);
+      value_type scale = rad / std::sqrt(len2);
+      return point_type(cen.x + scale * deltaX, cen.y + scale * deltaY);
+    }
+
+    // whether the point lies inside the circle or on it
+    bool contains(const point_type &p) const {
+      value_type deltaX = p.x - cen.x, deltaY = p.y - cen.y;
+      return deltaX * deltaX + deltaY * deltaY <= rad * rad;
+    }
+
+    /**
+     * @brief the distances from many points to the circle
+     *
+     * @attention the batch kernels work on the coordinates without any trigonometry and
+     * without branches in their loops, so the compiler can vectorize them. the square roots
+     * only vectorize with '-fno-math-errno'
+     */
+    std::vector<value_type> distances(const pointset_type &points) const {
+      std::size_t n = points.size();
+      std::vector<value_type> res(n);
+      for (std::size_t i = 0; i != n; ++i) {
+        value_type deltaX = points[i].x - cen.x, deltaY = points[i].y - cen.y;
+        res[i] = std::abs(std::sqrt(deltaX * deltaX + deltaY * deltaY) - rad);
+      }
+      return res;
+    }
+
+    /**
+     * @brief the nearest points on the circle to many points
+     */
+    pointset_type nearests(const pointset_type &points) const {
+      std::size_t n = points.size();
+      std::vector<value_type> xs(n), ys(n);
+      for (std::size_t i = 0; i != n; ++i) {
+        value_type deltaX = points[i].x - cen.x, deltaY = points[i].y - cen.y;
+        value_type len2 = deltaX * deltaX + deltaY * deltaY;
+        // a point at the center selects the point at angle zero
+        bool center = len2 == 0.0;
+        value_type scale = rad / std::sqrt(center ? 1.0 : len2);
+        xs[i] = cen.x + (center ? rad : scale * deltaX);
+        ys[i] = cen.y + (center ? 0.0 : scale * deltaY);
+      }
+      pointset_type res;
+      res.reserve(n);
+      for (std::size_t i = 0; i != n; ++i)
+        res.emplace_back(xs[i], ys[i]);
+      return res;
+    }
+
+    /**
+     * @brief whether many points lie inside the circle or on it, one flag per point
+     */
+    std::vector<char> contains(const pointset_type &points) const {
+      std::size_t n = points.size();
+      std::vector<char> res(n);
+      value_type rad2 = rad * rad, cx = cen.x, cy = cen.y;
+      // raw pointers, as the stores through 'char' might alias anything
+      const point_type *src = points.data();
+      char *dst = res.data();
+      for (std::size_t i = 0; i != n; ++i) {
+        value_type deltaX = src[i].x - cx, deltaY = src[i].y - cy;
+        dst[i] = deltaX * deltaX + deltaY * deltaY <= rad2;
+      }
+      return res;
+    }
+
+    /**
+     * @brief the smallest circle enclosing all the points, by Welzl's algorithm
+     *
+     * @attention the points are visited in a random order, which makes the expected time linear.
+     * an empty point set gives a zero circle at the origin
+     */
+    static self_type enclosing(const pointset_type &points) {
+      if (points.empty())
+        return Circle(point_type(0.0, 0.0), 0.0);
+      std::vector<point_type> pts(points.cbegin(), points.cend());
+      std::default_random_engine engine;
+      std::shuffle(pts.begin(), pts.end(), engine);
+      // the slack for the rounding errors of the boundary circles
+      value_type scale = 0.0;
+      for (const auto &p : pts)
+        scale = std::max({scale, std::abs(p.x), std::abs(p.y)});
+      const value_type eps = 1E-12 * std::max(scale, 1.0);
+      auto inside = [eps](const Circle &c, const point_type &p) {
+        return std::hypot(p.x - c.cen.x, p.y - c.cen.y) <= c.rad + eps;
+      };
+      Circle cir(pts[0], 0.0);
+      for (std::size_t i = 1; i != pts.size(); ++i) {
+        if (inside(cir, pts[i]))
+          continue;
+        // 'pts[i]' lies on the boundary of the circle of the first 'i + 1' points
+        cir = diametral(pts[i], pts[0]);
+        for (std::size_t j = 1; j != i; ++j) {
+          if (inside(cir, pts[j]))
+            continue;
+          // and so does 'pts[j]'
+          cir = diametral(pts[i], pts[j]);
+          for (std::size_t k = 0; k != j; ++k)
+            if (!inside(cir, pts[k]))
+              cir = circumcircle(pts[i], pts[j], pts[k]);
+        }
       }
-      point_type target;
-      target.x = rad * std::cos(theta) + cen.x;
-      target.y = rad * std::sin(theta) + cen.y;
-      return target;
+      return cir;
+    }
+
+    /**
+     * @brief the moments of a point set about its centroid, with 'z = x^2 + y^2'
+     */
+    struct Moments {
+      point_type mean;
+      value_type xx = 0.0, yy = 0.0, xy = 0.0, xz = 0.0, yz = 0.0, zz = 0.0;
+      std::size_t num = 0;
+    };
+
+    static Moments moments(const std::vector<point_type> &points) { return moments(points.data(), points.size()); }
+
+    /**
+     * @brief the moments of the points 'points[0, num)'
+     */
+    static Moments moments(const point_type *points, std::size_t num) {
+      return moments(num, [points](std::size_t i) -> const point_type & { return points[i]; });
+    }
+
+    /**
+     * @brief the moments of the points at the indices 'idx[0, num)'
+     */
+    static Moments moments(const std::vector<point_type> &points, const std::size_t *idx, std::size_t num) {
+      return moments(num, [&points, idx](std::size_t i) -> const point_type & { return points[idx[i]]; });
     }
 
-    // using gauss-newton method to fit a circle
+    /**
+     * @brief the algebraic fit minimizing the squared 'x^2 + y^2 + Dx + Ey + F' (Kasa), the fastest,
+     * but it shrinks the circle for points on a short arc
+     *
+     * @attention the algebraic fits work on the moments alone and collinear points give an infinite radius
+     */
+    static self_type kasa(const Moments &m) {
+      value_type det = m.xx * m.yy - m.xy * m.xy;
+      value_type a = 0.5 * (m.xz * m.yy - m.yz * m.xy) / det, b = 0.5 * (m.yz * m.xx - m.xz * m.xy) / det;
+      return Circle(point_type(a + m.mean.x, b + m.mean.y), std::sqrt(a * a + b * b + m.xx + m.yy));
+    }
+
+    /**
+     * @brief the algebraic fit normalized by the gradient at the points (Pratt)
+     */
+    static self_type pratt(const Moments &m) {
+      value_type mz = m.xx + m.yy, covXY = m.xx * m.yy - m.xy * m.xy, varZ = m.zz - mz * mz;
+      value_type a2 = 4.0 * covXY - 3.0 * mz * mz - m.zz;
+      value_type a1 = varZ * mz + 4.0 * covXY * mz - m.xz * m.xz - m.yz * m.yz;
+      value_type a0 = m.xz * (m.xz * m.yy - m.yz * m.xy) + m.yz * (m.yz * m.xx - m.xz * m.xy) - varZ * covXY;
+      // the root of the characteristic polynomial next to zero by Newton's method
+      value_type x = 0.0, y = a0;
+      for (int i = 0; i != 100; ++i) {
+        value_type dy = a1 + x * (2.0 * a2 + 16.0 * x * x);
+        value_type xnew = x - y / dy;
+        if (xnew == x || !std::isfinite(xnew))
+          break;
+        value_type ynew = a0 + xnew * (a1 + xnew * (a2 + 4.0 * xnew * xnew));
+        if (std::abs(ynew) >= std::abs(y))
+          break;
+        x = xnew, y = ynew;
+      }
+      return fromRoot(m, x, 2.0 * x);
+    }
+
+    /**
+     * @brief the algebraic fit normalized by the mean gradient (Taubin), nearly as accurate
+     * as the geometric fit and the default initializer of 'fit'
+     */
+    static self_type taubin(const Moments &m) {
+      value_type mz = m.xx + m.yy, covXY = m.xx * m.yy - m.xy * m.xy, varZ = m.zz - mz * mz;
+      value_type a3 = 4.0 * mz, a2 = -3.0 * mz * mz - m.zz;
+      value_type a1 = varZ * mz + 4.0 * covXY * mz - m.xz * m.xz - m.yz * m.yz;
+      value_type a0 = m.xz * (m.xz * m.yy - m.yz * m.xy) + m.yz * (m.yz * m.xx - m.xz * m.xy) - varZ * covXY;
+      value_type x = 0.0, y = a0;
+      for (int i = 0; i != 100; ++i) {
+        value_type dy = a1 + x * (2.0 * a2 + 3.0 * a3 * x);
+        value_type xnew = x - y / dy;
+        if (xnew == x || !std::isfinite(xnew))
+          break;
+        value_type ynew = a0 + xnew * (a1 + xnew * (a2 + xnew * a3));
+        if (std::abs(ynew) >= std::abs(y))
+          break;
+        x = xnew, y = ynew;
+      }
+      return fromRoot(m, x, 0.0);
+    }
+
+    static self_type kasa(const pointset_type &points) { return kasa(moments(points)); }
+
+    static self_type pratt(const pointset_type &points) { return pratt(moments(points)); }
+
+    static self_type taubin(const pointset_type &points) { return taubin(moments(points)); }
+
+    /**
+     * @brief the geometric fit minimizing the squared distances to the circle
+     *
+     * @param iter the max number of Levenberg-Marquardt iterations, starting from the Taubin fit
+     * @attention the iterations stop as soon as the step gets negligible
+     */
     static self_type fit(const pointset_type &points, const ushort iter = 10) {
-      auto cir = Circle::ransac(points);
+      return fit(points.data(), points.size(), iter);
+    }
+
+    /**
+     * @brief the geometric fit of the points 'points[0, num)', it allocates nothing
+     */
+    static self_type fit(const point_type *points, std::size_t num, const ushort iter = 10) {
+      auto cir = Circle::taubin(moments(points, num));
+      if (!std::isfinite(cir.rad))
+        return cir;
+      value_type cost = sumSquares(points, num, cir), lambda = 1E-3;
       for (int i = 0; i != iter; ++i) {
-        Eigen::Matrix3d H = Eigen::Matrix3d::Zero();
-        Eigen::Vector3d g = Eigen::Vector3d::Zero();
-        for (const auto &p : points) {
-          value_type dis = ns_geo::distance(p, cir.cen);
-          value_type error = dis - cir.rad;
-          Eigen::Vector3d j(-(p.x - cir.cen.x) / dis, -(p.y - cir.cen.y) / dis, -1.0);
-          H += j * j.transpose();
-          g -= j * error;
+        // the normal equations, the residual of a point is its distance minus the radius
+        value_type h00 = 0.0, h01 = 0.0, h02 = 0.0, h11 = 0.0, h12 = 0.0, h22 = 0.0, g0 = 0.0, g1 = 0.0, g2 = 0.0;
+        for (std::size_t k = 0; k != num; ++k) {
+          const auto &p = points[k];
+          value_type deltaX = p.x - cir.cen.x, deltaY = p.y - cir.cen.y;
+          value_type dis = std::sqrt(deltaX * deltaX + deltaY * deltaY);
+          if (dis == 0.0)
+            continue;
+          value_type jx = -deltaX / dis, jy = -deltaY / dis, error = dis - cir.rad;
+          h00 += jx * jx, h01 += jx * jy, h02 -= jx, h11 += jy * jy, h12 -= jy, h22 += 1.0;
+          g0 -= jx * error, g1 -= jy * error, g2 += error;
+        }
+        Eigen::Matrix3d H;
+        H << h00, h01, h02, h01, h11, h12, h02, h12, h22;
+        Eigen::Vector3d g(g0, g1, g2);
+        bool accepted = false;
+        while (!accepted && lambda < 1E10) {
+          Eigen::Matrix3d A = H;
+          A.diagonal() *= 1.0 + lambda;
+          Eigen::Vector3d delta = A.ldlt().solve(g);
+          Circle next(point_type(cir.cen.x + delta(0), cir.cen.y + delta(1)), cir.rad + delta(2));
+          value_type nextCost = sumSquares(points, num, next);
+          if (nextCost <= cost) {
+            bool small = delta.norm() <= 1E-12 * (1.0 + std::abs(cir.cen.x) + std::abs(cir.cen.y) + cir.rad);
+            cir = next, cost = nextCost, lambda *= 0.1, accepted = true;
+            if (small)
+              return cir;
+          } else
+            lambda *= 10.0;
         }
-        Eigen::Vector3d delta = H.ldlt().solve(g);
-        cir.cen.x += delta(0);
-        cir.cen.y += delta(1);
-        cir.rad += delta(2);
+        if (!accepted)
+          break;
       }
       return cir;
     }
@@ -101,6 +324,65 @@ namespace ns_geo {
     [[nodiscard]] inline ns_geo::GeoType type() const override {
       return GeoType::CIRCLE;
     }
+
+  protected:
+    template <typename Getter>
+    static Moments moments(std::size_t num, Getter get) {
+      Moments m;
+      m.num = num;
+      if (num == 0)
+        return m;
+      value_type sx = 0.0, sy = 0.0;
+      for (std::size_t i = 0; i != num; ++i)
+        sx += get(i).x, sy += get(i).y;
+      m.mean = point_type(sx / num, sy / num);
+      for (std::size_t i = 0; i != num; ++i) {
+        value_type x = get(i).x - m.mean.x, y = get(i).y - m.mean.y, z = x * x + y * y;
+        m.xx += x * x, m.yy += y * y, m.xy += x * y, m.xz += x * z, m.yz += y * z, m.zz += z * z;
+      }
+      m.xx /= num, m.yy /= num, m.xy /= num, m.xz /= num, m.yz /= num, m.zz /= num;
+      return m;
+    }
+
+    /**
+     * @brief the circle of the Pratt and Taubin fits from the root 'x' of their polynomials
+     */
+    static self_type fromRoot(const Moments &m, value_type x, value_type radExtra) {
+      value_type det = x * x - x * (m.xx + m.yy) + m.xx * m.yy - m.xy * m.xy;
+      value_type a = (m.xz * (m.yy - x) - m.yz * m.xy) / det / 2.0;
+      value_type b = (m.yz * (m.xx - x) - m.xz * m.xy) / det / 2.0;
+      return Circle(point_type(a + m.mean.x, b + m.mean.y), std::sqrt(a * a + b * b + m.xx + m.yy + radExtra));
+    }
+
+    static value_type sumSquares(const point_type *points, std::size_t num, const Circle &cir) {
+      value_type cost = 0.0;
+      for (std::size_t k = 0; k != num; ++k) {
+        const auto &p = points[k];
+        value_type deltaX = p.x - cir.cen.x, deltaY = p.y - cir.cen.y;
+        value_type error = std::sqrt(deltaX * deltaX + deltaY * deltaY) - cir.rad;
+        cost += error * error;
+      }
+      return cost;
+    }
+
+    // the circle with 'p1' and 'p2' at the ends of a diameter
+    static self_type diametral(const point_type &p1, const point_type &p2) {
+      point_type cen((p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5);
+      return Circle(cen, 0.5 * std::hypot(p1.x - p2.x, p1.y - p2.y));
+    }
+
+    // the circle through three points, or the widest diametral one if they are collinear
+    static self_type circumcircle(const point_type &p1, const point_type &p2, const point_type &p3) {
+      value_type cross = (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+      if (cross == 0.0) {
+        auto c12 = diametral(p1, p2), c13 = diametral(p1, p3), c23 = diametral(p2, p3);
+        return c12.rad >= c13.rad ? (c12.rad >= c23.rad ? c12 : c23) : (c13.rad >= c23.rad ? c13 : c23);
+      }
+      Circle cir(p1, p2, p3);
+      cir.rad = std::max({std::hypot(p1.x - cir.cen.x, p1.y - cir.cen.y), std::hypot(p2.x - cir.cen.x, p2.y - cir.cen.y),
+                          std::hypot(p3.x - cir.cen.x, p3.y - cir.cen.y)});
+      return cir;
+    }
   };
   /**
    * @brief override operator '<<' for type 'Circle'
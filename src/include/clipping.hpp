@@ -0,0 +1,850 @@
+#ifndef CLIPPING_HPP
+#define CLIPPING_HPP
+
+/**
+ * @file clipping.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Boolean operations between polygons
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "polygon.hpp"
+#include "rectangle.hpp"
+#include <deque>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace ns_geo {
+#pragma region PolygonWithHoles
+
+  /**
+   * @brief a polygon with an outer ring and some holes
+   *
+   * @attention the clipper returns the outer ring counter-clockwise and the holes clockwise
+   */
+  template <typename Ty = float>
+  class PolygonWithHoles {
+  public:
+    using value_type = Ty;
+    using polygon_type = Polygon<value_type>;
+    using self_type = PolygonWithHoles<value_type>;
+
+  public:
+    polygon_type outer;
+    std::vector<polygon_type> holes;
+
+  public:
+    PolygonWithHoles() = default;
+    explicit PolygonWithHoles(const polygon_type &outer, const std::vector<polygon_type> &holes = {})
+        : outer(outer), holes(holes) {}
+
+    /**
+     * @brief the area of the outer ring minus the holes
+     */
+    [[nodiscard]] double area() const {
+      double s = std::abs(signedArea(outer));
+      for (const auto &hole : holes)
+        s -= std::abs(signedArea(hole));
+      return s;
+    }
+
+    /**
+     * @brief the shoelace area, positive for a counter-clockwise ring
+     */
+    static double signedArea(const polygon_type &ring) {
+      double s = 0.0;
+      for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+        s += static_cast<double>(ring[j].x) * ring[i].y - static_cast<double>(ring[i].x) * ring[j].y;
+      return 0.5 * s;
+    }
+  };
+
+  template <typename Ty = float>
+  using MultiPolygon = std::vector<PolygonWithHoles<Ty>>;
+
+  /**
+   * @brief overload operator "<<" for PolygonWithHoles<_Ty>
+   */
+  template <typename Ty>
+  std::ostream &operator<<(std::ostream &os, const PolygonWithHoles<Ty> &polygon) {
+    os << '{' << polygon.outer;
+    for (const auto &hole : polygon.holes)
+      os << ", " << hole;
+    os << '}';
+    return os;
+  }
+
+#pragma endregion
+
+#pragma region PolygonClipper
+
+  enum class BoolOp {
+    INTERSECTION,
+    UNION,
+    DIFFERENCE,
+    XOR
+  };
+
+  /**
+   * @brief boolean operations between polygons
+   *
+   * @attention the general case is the Martinez-Rueda plane sweep, O((n + k) log n) for n edges
+   * and k crossings. the rings of an operand combine by the even-odd rule, so holes and several
+   * parts are given as plain rings. two convex polygons, or a polygon and a rectangle, can take
+   * the Sutherland-Hodgman fast path instead. the edges of one operand may cross and touch,
+   * but shouldn't run along each other (zero-width spikes).
+   */
+  template <typename Ty = float>
+  class PolygonClipper {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using polygonwithholes_type = PolygonWithHoles<value_type>;
+    using multipolygon_type = MultiPolygon<value_type>;
+    using rectangle_type = Rectangle<value_type>;
+    using self_type = PolygonClipper<value_type>;
+
+  public:
+    /**
+     * @brief the intersection of two polygons, two convex ones take the Sutherland-Hodgman path
+     */
+    static multipolygon_type intersection(const polygon_type &a, const polygon_type &b) {
+      if (isConvex(a) && isConvex(b)) {
+        auto poly = clipConvex(a, b);
+        if (poly.size() < 3)
+          return {};
+        if (polygonwithholes_type::signedArea(poly) < 0.0)
+          std::reverse(poly.begin(), poly.end());
+        return {polygonwithholes_type(poly)};
+      }
+      return compute({a}, {b}, BoolOp::INTERSECTION);
+    }
+
+    static multipolygon_type unite(const polygon_type &a, const polygon_type &b) {
+      return compute({a}, {b}, BoolOp::UNION);
+    }
+
+    static multipolygon_type difference(const polygon_type &a, const polygon_type &b) {
+      return compute({a}, {b}, BoolOp::DIFFERENCE);
+    }
+
+    static multipolygon_type symDifference(const polygon_type &a, const polygon_type &b) {
+      return compute({a}, {b}, BoolOp::XOR);
+    }
+
+    /**
+     * @brief the boolean operation between two multipolygons
+     */
+    static multipolygon_type compute(const multipolygon_type &a, const multipolygon_type &b, BoolOp op) {
+      return compute(rings(a), rings(b), op);
+    }
+
+    /**
+     * @brief the boolean operation between two sets of rings
+     *
+     * @param subject the rings of the subject, combined by the even-odd rule
+     * @param clipping the rings of the clipping, combined by the even-odd rule
+     * @param op the operation
+     * @return multipolygon_type the disjoint parts of the result with their holes
+     */
+    static multipolygon_type compute(const std::vector<polygon_type> &subject,
+                                     const std::vector<polygon_type> &clipping, BoolOp op) {
+      double scale = 0.0;
+      for (const auto *rs : {&subject, &clipping})
+        for (const auto &ring : *rs)
+          for (const auto &p : ring)
+            scale = std::max({scale, std::abs(static_cast<double>(p.x)), std::abs(static_cast<double>(p.y))});
+      Sweep sweep(scale);
+      double sbox[4], cbox[4];
+      sweep.fill(subject, true, sbox);
+      sweep.fill(clipping, false, cbox);
+      bool disjoint = sbox[0] > cbox[2] || cbox[0] > sbox[2] || sbox[1] > cbox[3] || cbox[1] > sbox[3];
+      if (op == BoolOp::INTERSECTION && disjoint)
+        return {};
+      // no event beyond these can change the result
+      double stop = std::numeric_limits<double>::max();
+      if (op == BoolOp::INTERSECTION)
+        stop = std::min(sbox[2], cbox[2]);
+      else if (op == BoolOp::DIFFERENCE)
+        stop = sbox[2];
+      sweep.run(op, stop);
+      return sweep.connect();
+    }
+
+    /**
+     * @brief the rings of a multipolygon, for feeding a result into another operation
+     */
+    static std::vector<polygon_type> rings(const multipolygon_type &mp) {
+      std::vector<polygon_type> res;
+      for (const auto &poly : mp) {
+        res.push_back(poly.outer);
+        res.insert(res.end(), poly.holes.cbegin(), poly.holes.cend());
+      }
+      return res;
+    }
+
+    /**
+     * @brief whether the polygon is convex, the vertices may turn either way but never both
+     */
+    static bool isConvex(const polygon_type &poly) {
+      std::size_t n = poly.size();
+      if (n < 3)
+        return false;
+      int sign = 0, flips = 0, lastDx = 0, firstDx = 0;
+      for (std::size_t i = 0; i != n; ++i) {
+        const auto &a = poly[i], &b = poly[(i + 1) % n], &c = poly[(i + 2) % n];
+        double cross = (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - b.y) -
+                       (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - b.x);
+        int s = (cross > 0.0) - (cross < 0.0);
+        if (s != 0 && sign != 0 && s != sign)
+          return false;
+        if (s != 0)
+          sign = s;
+        // a simple convex ring turns its x direction twice, a star more often
+        int dx = (b.x > a.x) - (b.x < a.x);
+        if (dx != 0) {
+          if (lastDx != 0 && dx != lastDx)
+            ++flips;
+          if (firstDx == 0)
+            firstDx = dx;
+          lastDx = dx;
+        }
+      }
+      if (lastDx != firstDx)
+        ++flips;
+      return sign != 0 && flips <= 2;
+    }
+
+    /**
+     * @brief clip a polygon with a convex one (Sutherland-Hodgman)
+     *
+     * @attention the result is exact for a convex subject. a concave subject may come out
+     * with zero-width bridges between its parts, though the area is still right.
+     */
+    static polygon_type clipConvex(const polygon_type &subject, const polygon_type &convex) {
+      std::vector<std::array<double, 2>> ring(subject.size()), out;
+      for (std::size_t i = 0; i != subject.size(); ++i)
+        ring[i] = {static_cast<double>(subject[i].x), static_cast<double>(subject[i].y)};
+      double orient = polygonwithholes_type::signedArea(convex) < 0.0 ? -1.0 : 1.0;
+      for (std::size_t e = 0; e != convex.size() && !ring.empty(); ++e) {
+        const auto &p = convex[e], &q = convex[(e + 1) % convex.size()];
+        double ax = p.x, ay = p.y, dx = static_cast<double>(q.x) - ax, dy = static_cast<double>(q.y) - ay;
+        // the inner side of the edge is where 'value' isn't negative
+        auto value = [&](const std::array<double, 2> &v) { return orient * (dx * (v[1] - ay) - dy * (v[0] - ax)); };
+        clipRing(ring, out, value);
+      }
+      return toPolygon(ring);
+    }
+
+    /**
+     * @brief clip a polygon with a rectangle (Sutherland-Hodgman against the four sides)
+     *
+     * @attention as for 'clipConvex', a concave subject may come out with zero-width bridges
+     */
+    static polygon_type clipRect(const polygon_type &subject, const rectangle_type &rect) {
+      std::vector<std::array<double, 2>> ring(subject.size()), out;
+      for (std::size_t i = 0; i != subject.size(); ++i)
+        ring[i] = {static_cast<double>(subject[i].x), static_cast<double>(subject[i].y)};
+      const double limits[4] = {std::min<double>(rect.topLeftPt.x, rect.bottomRightPt.x),
+                                std::max<double>(rect.topLeftPt.x, rect.bottomRightPt.x),
+                                std::min<double>(rect.topLeftPt.y, rect.bottomRightPt.y),
+                                std::max<double>(rect.topLeftPt.y, rect.bottomRightPt.y)};
+      const double signs[4] = {1.0, -1.0, 1.0, -1.0};
+      for (int side = 0; side != 4 && !ring.empty(); ++side) {
+        int axis = side / 2;
+        auto value = [&](const std::array<double, 2> &v) { return signs[side] * (v[axis] - limits[side]); };
+        clipRing(ring, out, value);
+      }
+      return toPolygon(ring);
+    }
+
+  protected:
+    template <typename Value>
+    static void clipRing(std::vector<std::array<double, 2>> &ring, std::vector<std::array<double, 2>> &out, Value value) {
+      out.clear();
+      for (std::size_t i = 0; i != ring.size(); ++i) {
+        const auto &cur = ring[i], &nxt = ring[(i + 1) % ring.size()];
+        double vc = value(cur), vn = value(nxt);
+        if (vc >= 0.0)
+          out.push_back(cur);
+        if ((vc >= 0.0) != (vn >= 0.0)) {
+          double t = vc / (vc - vn);
+          out.push_back({cur[0] + t * (nxt[0] - cur[0]), cur[1] + t * (nxt[1] - cur[1])});
+        }
+      }
+      ring.swap(out);
+    }
+
+    static polygon_type toPolygon(const std::vector<std::array<double, 2>> &ring) {
+      polygon_type poly;
+      poly.reserve(ring.size());
+      for (const auto &v : ring)
+        poly.push_back(point_type(static_cast<value_type>(v[0]), static_cast<value_type>(v[1])));
+      return poly;
+    }
+
+    enum class EdgeType {
+      NORMAL,
+      NON_CONTRIBUTING,
+      SAME_TRANSITION,
+      DIFFERENT_TRANSITION
+    };
+
+    struct Event;
+
+    static inline double signedArea(double x0, double y0, double x1, double y1, double x2, double y2) {
+      return (x0 - x2) * (y1 - y2) - (x1 - x2) * (y0 - y2);
+    }
+
+    /**
+     * @brief the side of the line p0-p1 the point p2 lies on, +1 for the left, -1 for the right
+     * and 0 when it's within a relative tolerance of the line
+     */
+    static inline int orient(double x0, double y0, double x1, double y1, double x2, double y2) {
+      double s = signedArea(x0, y0, x1, y1, x2, y2);
+      double mag = std::abs(x0) + std::abs(y0) + std::abs(x1) + std::abs(y1) + std::abs(x2) + std::abs(y2);
+      double tol = 1E-12 * (std::abs(x1 - x0) + std::abs(y1 - y0)) * mag;
+      return s > tol ? 1 : (s < -tol ? -1 : 0);
+    }
+
+    static inline bool samePoint(const Event *a, const Event *b) {
+      return a->x == b->x && a->y == b->y;
+    }
+
+    /**
+     * @brief the order of the event queue, positive when 'a' is handled after 'b'
+     */
+    static int compareEvents(const Event *a, const Event *b) {
+      if (a->x != b->x)
+        return a->x > b->x ? 1 : -1;
+      if (a->y != b->y)
+        return a->y > b->y ? 1 : -1;
+      // the right endpoints go first
+      if (a->left != b->left)
+        return a->left ? 1 : -1;
+      // the lower segment goes first
+      if (orient(a->x, a->y, a->other->x, a->other->y, b->other->x, b->other->y) != 0)
+        return a->isBelow(b->other->x, b->other->y) ? -1 : 1;
+      if (a->subject != b->subject)
+        return a->subject ? -1 : 1;
+      return a->id > b->id ? 1 : (a->id < b->id ? -1 : 0);
+    }
+
+    /**
+     * @brief the order of the sweep line, negative when 'a' lies below 'b'
+     */
+    static int compareSegments(const Event *a, const Event *b) {
+      if (a == b)
+        return 0;
+      const Event *ao = a->other, *bo = b->other;
+      if (orient(a->x, a->y, ao->x, ao->y, b->x, b->y) != 0 || orient(a->x, a->y, ao->x, ao->y, bo->x, bo->y) != 0) {
+        // not collinear
+        if (samePoint(a, b))
+          return a->isBelow(bo->x, bo->y) ? -1 : 1;
+        if (a->x == b->x)
+          return a->y < b->y ? -1 : 1;
+        // the one inserted later is compared against the other, by its right endpoint
+        // when it starts right on the other
+        if (compareEvents(a, b) == 1) {
+          int s = orient(b->x, b->y, bo->x, bo->y, a->x, a->y);
+          if (s == 0)
+            s = orient(b->x, b->y, bo->x, bo->y, ao->x, ao->y);
+          return s > 0 ? 1 : -1;
+        }
+        int s = orient(a->x, a->y, ao->x, ao->y, b->x, b->y);
+        if (s == 0)
+          s = orient(a->x, a->y, ao->x, ao->y, bo->x, bo->y);
+        return s > 0 ? -1 : 1;
+      }
+      // collinear
+      if (a->subject != b->subject)
+        return a->subject ? -1 : 1;
+      if (samePoint(a, b)) {
+        if (ao->x == bo->x && ao->y == bo->y)
+          return a->id < b->id ? -1 : 1;
+        if (a->contour != b->contour)
+          return a->contour > b->contour ? 1 : -1;
+        return compareEvents(ao, bo) > 0 ? 1 : -1;
+      }
+      return compareEvents(a, b) == 1 ? 1 : -1;
+    }
+
+    struct SegmentLess {
+      bool operator()(const Event *a, const Event *b) const { return compareSegments(a, b) < 0; }
+    };
+
+    struct EventLater {
+      bool operator()(const Event *a, const Event *b) const { return compareEvents(a, b) > 0; }
+    };
+
+    // a multiset, so an insertion always yields the node of the new edge
+    using status_type = std::multiset<Event *, SegmentLess>;
+
+    /**
+     * @brief an endpoint of an edge, the left one of a pair carries the state of the edge
+     */
+    struct Event {
+      double x, y;
+      bool left;
+      Event *other;
+      bool subject;
+      int contour;
+      std::size_t id;
+      EdgeType type = EdgeType::NORMAL;
+      // whether the edge is an in-out transition of its own polygon, and of the other one
+      bool inOut = false;
+      bool otherInOut = false;
+      // the closest edge below that's in the result
+      Event *prevInResult = nullptr;
+      // +1 when the result lies above the edge, -1 below, 0 when not in the result
+      int transition = 0;
+      typename status_type::iterator where;
+
+      Event(double x, double y, bool left, Event *other, bool subject, int contour, std::size_t id)
+          : x(x), y(y), left(left), other(other), subject(subject), contour(contour), id(id) {}
+
+      inline bool isBelow(double px, double py) const {
+        return left ? orient(x, y, other->x, other->y, px, py) > 0 : orient(other->x, other->y, x, y, px, py) > 0;
+      }
+
+      inline bool isVertical() const { return x == other->x; }
+    };
+
+    /**
+     * @brief the state of one run of the sweep
+     */
+    struct Sweep {
+      std::deque<Event> events;
+      std::priority_queue<Event *, std::vector<Event *>, EventLater> queue;
+      std::vector<Event *> sorted;
+      int contourNum = 0;
+      // the left event being inserted, and whether it has to wait for a split neighbor
+      Event *current = nullptr;
+      bool requeue = false;
+      // the coordinates met so far, a new one within 'eps' of them snaps to them
+      std::set<double> xs, ys;
+      double eps = 0.0;
+
+      explicit Sweep(double scale) : eps(scale * 1E-12) {}
+
+      /**
+       * @brief snap the value to a close one already met, so the crossings computed
+       * from different edge pairs meet exactly where they should
+       */
+      inline double snap(std::set<double> &vals, double v) {
+        auto iter = vals.lower_bound(v - eps);
+        if (iter != vals.end() && *iter <= v + eps)
+          return *iter;
+        vals.insert(v);
+        return v;
+      }
+
+      Event *newEvent(double x, double y, bool left, Event *other, bool subject, int contour) {
+        events.emplace_back(x, y, left, other, subject, contour, events.size());
+        return &events.back();
+      }
+
+      void fill(const std::vector<polygon_type> &rings, bool subject, double box[4]) {
+        box[0] = box[1] = std::numeric_limits<double>::max();
+        box[2] = box[3] = std::numeric_limits<double>::lowest();
+        for (const auto &ring : rings) {
+          int contour = contourNum++;
+          for (std::size_t i = 0; i < ring.size(); ++i) {
+            const auto &p = ring[i], &q = ring[(i + 1) % ring.size()];
+            double px = snap(xs, p.x), py = snap(ys, p.y), qx = snap(xs, q.x), qy = snap(ys, q.y);
+            if (px == qx && py == qy)
+              continue;
+            box[0] = std::min(box[0], px), box[1] = std::min(box[1], py);
+            box[2] = std::max(box[2], px), box[3] = std::max(box[3], py);
+            Event *e1 = newEvent(px, py, false, nullptr, subject, contour);
+            Event *e2 = newEvent(qx, qy, false, e1, subject, contour);
+            e1->other = e2;
+            if (compareEvents(e1, e2) > 0)
+              e2->left = true;
+            else
+              e1->left = true;
+            queue.push(e1), queue.push(e2);
+          }
+        }
+      }
+
+      void run(BoolOp op, double stop) {
+        status_type status;
+        while (!queue.empty()) {
+          Event *event = queue.top();
+          queue.pop();
+          sorted.push_back(event);
+          if (event->x > stop)
+            break;
+          if (event->left) {
+            current = event, requeue = false;
+            event->where = status.insert(event);
+            auto it = event->where;
+            Event *prev = it == status.begin() ? nullptr : *std::prev(it);
+            Event *next = std::next(it) == status.end() ? nullptr : *std::next(it);
+            computeFields(event, prev, op);
+            if (next && possibleIntersection(event, next) == 2) {
+              computeFields(event, prev, op);
+              computeFields(next, event, op);
+            }
+            if (prev && possibleIntersection(prev, event) == 2) {
+              auto pit = prev->where;
+              Event *prevprev = pit == status.begin() ? nullptr : *std::prev(pit);
+              computeFields(prev, prevprev, op);
+              computeFields(event, prev, op);
+            }
+            if (requeue) {
+              // a neighbor got split right at this point, so its right end must be handled first
+              status.erase(event->where);
+              sorted.pop_back();
+              queue.push(event);
+            }
+          } else {
+            Event *left = event->other;
+            auto it = left->where;
+            Event *prev = it == status.begin() ? nullptr : *std::prev(it);
+            Event *next = std::next(it) == status.end() ? nullptr : *std::next(it);
+            status.erase(it);
+            if (prev && next)
+              possibleIntersection(prev, next);
+          }
+        }
+      }
+
+      static bool inResult(const Event *e, BoolOp op) {
+        switch (e->type) {
+        case EdgeType::NORMAL:
+          switch (op) {
+          case BoolOp::INTERSECTION:
+            return !e->otherInOut;
+          case BoolOp::UNION:
+            return e->otherInOut;
+          case BoolOp::DIFFERENCE:
+            return e->subject == e->otherInOut;
+          case BoolOp::XOR:
+            return true;
+          }
+          return false;
+        case EdgeType::SAME_TRANSITION:
+          return op == BoolOp::INTERSECTION || op == BoolOp::UNION;
+        case EdgeType::DIFFERENT_TRANSITION:
+          return op == BoolOp::DIFFERENCE;
+        default:
+          return false;
+        }
+      }
+
+      static int resultTransition(const Event *e, BoolOp op) {
+        bool thisIn = !e->inOut, thatIn = !e->otherInOut, in = false;
+        // a coincident pair changes the other polygon just like this one, or just the opposite
+        if (e->type == EdgeType::SAME_TRANSITION)
+          thatIn = thisIn;
+        else if (e->type == EdgeType::DIFFERENT_TRANSITION)
+          thatIn = !thisIn;
+        switch (op) {
+        case BoolOp::INTERSECTION:
+          in = thisIn && thatIn;
+          break;
+        case BoolOp::UNION:
+          in = thisIn || thatIn;
+          break;
+        case BoolOp::XOR:
+          in = thisIn != thatIn;
+          break;
+        case BoolOp::DIFFERENCE:
+          in = e->subject ? (thisIn && !thatIn) : (thatIn && !thisIn);
+          break;
+        }
+        return in ? 1 : -1;
+      }
+
+      static void computeFields(Event *e, Event *prev, BoolOp op) {
+        if (!prev) {
+          e->inOut = false;
+          e->otherInOut = true;
+        } else {
+          if (e->subject == prev->subject) {
+            e->inOut = !prev->inOut;
+            e->otherInOut = prev->otherInOut;
+          } else {
+            e->inOut = !prev->otherInOut;
+            e->otherInOut = prev->isVertical() ? !prev->inOut : prev->inOut;
+          }
+          e->prevInResult = (!inResult(prev, op) || prev->isVertical()) ? prev->prevInResult : prev;
+        }
+        e->transition = inResult(e, op) ? resultTransition(e, op) : 0;
+      }
+
+      /**
+       * @brief split the edge of the left event 'e' at the point
+       */
+      void divide(Event *e, double px, double py) {
+        if (e != current && px == current->x && py == current->y)
+          requeue = true;
+        Event *r = newEvent(px, py, false, e, e->subject, e->contour);
+        Event *l = newEvent(px, py, true, e->other, e->subject, e->contour);
+        // a rounding error may put the new left point beyond the old right one
+        if (compareEvents(l, e->other) > 0) {
+          e->other->left = true;
+          l->left = false;
+        }
+        e->other->other = l;
+        e->other = r;
+        queue.push(l), queue.push(r);
+      }
+
+      /**
+       * @brief the crossings of the segments, 0, 1 or 2 points (when they overlap)
+       */
+      static int segmentIntersection(const Event *a, const Event *b, double res[4]) {
+        const Event *ao = a->other, *bo = b->other;
+        double ax = a->x, ay = a->y, bx = b->x, by = b->y;
+        double vax = ao->x - ax, vay = ao->y - ay;
+        double vbx = bo->x - bx, vby = bo->y - by;
+        double ex = bx - ax, ey = by - ay;
+        // the same predicate as the sweep, so an endpoint found on an edge splits it there
+        int b1 = orient(ax, ay, ao->x, ao->y, bx, by), b2 = orient(ax, ay, ao->x, ao->y, bo->x, bo->y);
+        int a1 = orient(bx, by, bo->x, bo->y, ax, ay), a2 = orient(bx, by, bo->x, bo->y, ao->x, ao->y);
+        if (!(b1 == 0 && b2 == 0) && !(a1 == 0 && a2 == 0)) {
+          if (b1 * b2 > 0 || a1 * a2 > 0)
+            return 0;
+          if (b1 == 0)
+            res[0] = bx, res[1] = by;
+          else if (b2 == 0)
+            res[0] = bo->x, res[1] = bo->y;
+          else if (a1 == 0)
+            res[0] = ax, res[1] = ay;
+          else if (a2 == 0)
+            res[0] = ao->x, res[1] = ao->y;
+          else {
+            double s = std::min(std::max((ex * vby - ey * vbx) / (vax * vby - vay * vbx), 0.0), 1.0);
+            res[0] = ax + s * vax, res[1] = ay + s * vay;
+          }
+          return 1;
+        }
+        // collinear
+        double lenA = vax * vax + vay * vay;
+        double sa = (vax * ex + vay * ey) / lenA;
+        double sb = sa + (vax * vbx + vay * vby) / lenA;
+        double smin = std::min(sa, sb), smax = std::max(sa, sb);
+        if (smin > 1.0 || smax < 0.0)
+          return 0;
+        auto at = [&](double s, double *p) {
+          if (s <= 0.0)
+            p[0] = ax, p[1] = ay;
+          else if (s >= 1.0)
+            p[0] = a->other->x, p[1] = a->other->y;
+          else
+            p[0] = ax + s * vax, p[1] = ay + s * vay;
+        };
+        if (smin == 1.0 || smax == 0.0) {
+          at(smin == 1.0 ? 1.0 : 0.0, res);
+          return 1;
+        }
+        at(smin, res), at(smax, res + 2);
+        return 2;
+      }
+
+      /**
+       * @brief split the two neighboring edges where they cross
+       *
+       * @return int 0 for no split, 1 for a crossing, 2 for overlapping edges sharing the left
+       * endpoint and 3 for the other overlaps
+       */
+      int possibleIntersection(Event *e1, Event *e2) {
+        double p[4];
+        int n = segmentIntersection(e1, e2, p);
+        if (n == 0)
+          return 0;
+        for (int i = 0; i != 2 * n; i += 2)
+          p[i] = snap(xs, p[i]), p[i + 1] = snap(ys, p[i + 1]);
+        // they only touch at a shared endpoint
+        if (n == 1 && (samePoint(e1, e2) || samePoint(e1->other, e2->other)))
+          return 0;
+        if (n == 1) {
+          auto isEnd = [&](const Event *e) {
+            return (e->x == p[0] && e->y == p[1]) || (e->other->x == p[0] && e->other->y == p[1]);
+          };
+          if (!isEnd(e1))
+            divide(e1, p[0], p[1]);
+          if (!isEnd(e2))
+            divide(e2, p[0], p[1]);
+          return 1;
+        }
+        // overlapping edges, the endpoints in the sweep order
+        Event *ev[4];
+        int cnt = 0;
+        bool leftCoincide = samePoint(e1, e2), rightCoincide = samePoint(e1->other, e2->other);
+        if (!leftCoincide) {
+          if (compareEvents(e1, e2) > 0)
+            ev[cnt++] = e2, ev[cnt++] = e1;
+          else
+            ev[cnt++] = e1, ev[cnt++] = e2;
+        }
+        if (!rightCoincide) {
+          if (compareEvents(e1->other, e2->other) > 0)
+            ev[cnt++] = e2->other, ev[cnt++] = e1->other;
+          else
+            ev[cnt++] = e1->other, ev[cnt++] = e2->other;
+        }
+        if (leftCoincide) {
+          // the second edge is dropped, the first one stands for both. two edges of the
+          // same polygon cancel each other by the even-odd rule
+          e2->type = EdgeType::NON_CONTRIBUTING;
+          if (e1->subject == e2->subject)
+            e1->type = EdgeType::NON_CONTRIBUTING;
+          else
+            e1->type = e2->inOut == e1->inOut ? EdgeType::SAME_TRANSITION : EdgeType::DIFFERENT_TRANSITION;
+          if (!rightCoincide)
+            divide(ev[1]->other, ev[0]->x, ev[0]->y);
+          return 2;
+        }
+        if (rightCoincide) {
+          divide(ev[0], ev[1]->x, ev[1]->y);
+          return 3;
+        }
+        if (ev[0] != ev[3]->other) {
+          // neither contains the other
+          divide(ev[0], ev[1]->x, ev[1]->y);
+          divide(ev[1], ev[2]->x, ev[2]->y);
+          return 3;
+        }
+        // one contains the other
+        divide(ev[0], ev[1]->x, ev[1]->y);
+        divide(ev[3]->other, ev[2]->x, ev[2]->y);
+        return 3;
+      }
+
+      /**
+       * @brief a simple ring of the result, 'first' is its edge coming first in the sweep
+       */
+      struct Loop {
+        std::vector<std::array<double, 2>> points;
+        std::vector<Event *> edges;
+        Event *first = nullptr;
+        bool outer = false;
+        int parent = -1;
+      };
+
+      /**
+       * @brief a result edge directed to keep the result on its left
+       */
+      struct HalfEdge {
+        std::array<double, 2> from, to;
+        double angle;
+        Event *edge;
+      };
+
+      /**
+       * @brief trace the faces of the result edges and nest the holes
+       *
+       * @attention at a vertex a face leaves by the first edge clockwise from the way back,
+       * so faces touching at a vertex come out as separate rings. as the result is on the left,
+       * the outer rings are counter-clockwise and the holes clockwise.
+       */
+      multipolygon_type connect() {
+        std::vector<HalfEdge> hs;
+        for (Event *e : sorted)
+          if (e->left && e->transition != 0) {
+            std::array<double, 2> l{e->x, e->y}, r{e->other->x, e->other->y};
+            const auto &from = e->transition > 0 ? l : r, &to = e->transition > 0 ? r : l;
+            hs.push_back({from, to, std::atan2(to[1] - from[1], to[0] - from[0]), e});
+          }
+        auto byFrom = [](const HalfEdge &a, const HalfEdge &b) { return a.from < b.from; };
+        std::sort(hs.begin(), hs.end(), byFrom);
+        std::vector<char> used(hs.size(), 0);
+        std::vector<Loop> loops;
+        for (std::size_t i = 0; i != hs.size(); ++i) {
+          if (used[i])
+            continue;
+          Loop loop;
+          double area = 0.0;
+          for (std::size_t h = i; !used[h];) {
+            used[h] = 1;
+            const auto &he = hs[h];
+            loop.points.push_back(he.from);
+            loop.edges.push_back(he.edge);
+            area += he.from[0] * he.to[1] - he.to[0] * he.from[1];
+            if (!loop.first || compareEvents(he.edge, loop.first) < 0)
+              loop.first = he.edge;
+            double back = std::atan2(he.from[1] - he.to[1], he.from[0] - he.to[0]), best = 0.0;
+            auto range = std::equal_range(hs.begin(), hs.end(), HalfEdge{he.to, he.to, 0.0, nullptr}, byFrom);
+            std::size_t next = h;
+            for (auto iter = range.first; iter != range.second; ++iter) {
+              double turn = back - iter->angle;
+              while (turn <= 0.0)
+                turn += 2.0 * M_PI;
+              if (next == h || turn < best)
+                best = turn, next = iter - hs.begin();
+            }
+            h = next;
+          }
+          if (loop.points.size() < 3)
+            continue;
+          loop.outer = area > 0.0;
+          loops.push_back(std::move(loop));
+        }
+        return nest(loops);
+      }
+
+      /**
+       * @brief find the parents of the holes
+       *
+       * @attention the result edge right below the first edge of a hole belongs to its parent
+       * or to a sibling hole.
+       */
+      static multipolygon_type nest(std::vector<Loop> &loops) {
+        std::sort(loops.begin(), loops.end(), [](const Loop &a, const Loop &b) { return compareEvents(a.first, b.first) < 0; });
+        std::unordered_map<const Event *, int> loopOf;
+        for (std::size_t i = 0; i != loops.size(); ++i) {
+          auto &loop = loops[i];
+          if (!loop.outer) {
+            const Event *below = loop.first->prevInResult;
+            auto iter = loopOf.end();
+            while (below && (iter = loopOf.find(below)) == loopOf.end())
+              below = below->prevInResult;
+            if (below) {
+              const auto &lower = loops[iter->second];
+              loop.parent = lower.outer ? iter->second : lower.parent;
+            }
+            // an orphaned hole can only come from rounding, keep it as a part
+            loop.outer = loop.parent < 0;
+          }
+          for (const Event *e : loop.edges)
+            loopOf[e] = static_cast<int>(i);
+        }
+        multipolygon_type mp;
+        std::vector<int> part(loops.size(), -1);
+        for (std::size_t i = 0; i != loops.size(); ++i)
+          if (loops[i].outer) {
+            part[i] = static_cast<int>(mp.size());
+            mp.push_back(polygonwithholes_type(oriented(loops[i].points, true)));
+          }
+        for (std::size_t i = 0; i != loops.size(); ++i)
+          if (!loops[i].outer)
+            mp[part[loops[i].parent]].holes.push_back(oriented(loops[i].points, false));
+        return mp;
+      }
+
+      static polygon_type oriented(const std::vector<std::array<double, 2>> &ring, bool ccw) {
+        double s = 0.0;
+        for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+          s += ring[j][0] * ring[i][1] - ring[i][0] * ring[j][1];
+        polygon_type poly = toPolygon(ring);
+        if ((s > 0.0) != ccw)
+          std::reverse(poly.begin(), poly.end());
+        return poly;
+      }
+    };
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
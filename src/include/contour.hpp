@@ -0,0 +1,247 @@
+#ifndef CONTOUR_HPP
+#define CONTOUR_HPP
+
+/**
+ * @file contour.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Extract the contour lines (isolines) from a TIN
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "linestring.hpp"
+#include "parallel.hpp"
+#include <deque>
+#include <functional>
+#include <limits>
+
+namespace ns_geo {
+#pragma region ContourTracer
+
+  /**
+   * @brief slice the facets of a TIN at several levels and stitch the pieces into line strings
+   *
+   * @attention the TIN is a point set and the vertex indices of its triangles.
+   * a vertex whose z equals the level counts as above it, so every piece starts and ends
+   * strictly inside a TIN edge. the pieces are joined through the TIN edges they cut,
+   * so the stitching never compares coordinates. every line keeps the higher ground on its left.
+   */
+  template <typename Ty = float>
+  class ContourTracer {
+  public:
+    using value_type = Ty;
+    using point_type = Point3<value_type>;
+    using pointset_type = PointSet3<value_type>;
+    using triangle_type = std::array<std::size_t, 3>;
+    using tin_type = std::vector<triangle_type>;
+    using linestring_type = LineString2<value_type>;
+    using self_type = ContourTracer<value_type>;
+    /**
+     * @brief receive a finished line: sink(the index of the level, the line)
+     */
+    using sink_type = std::function<void(std::size_t, linestring_type &&)>;
+
+  private:
+    const pointset_type &_pts;
+    const tin_type &_tin;
+    // the z range of every triangle, used to skip the ones a level can't cut
+    std::vector<value_type> _zmin;
+    std::vector<value_type> _zmax;
+
+  public:
+    /**
+     * @brief construct a new ContourTracer object
+     *
+     * @param pts the vertices of the TIN
+     * @param tin the triangles of the TIN, the indices refer to 'pts'
+     * @attention both containers are referenced, not copied
+     */
+    ContourTracer(const pointset_type &pts, const tin_type &tin)
+        : _pts(pts), _tin(tin), _zmin(tin.size()), _zmax(tin.size()) {
+      for (std::size_t i = 0; i != tin.size(); ++i) {
+        const auto &tri = tin[i];
+        auto z0 = pts[tri[0]].z, z1 = pts[tri[1]].z, z2 = pts[tri[2]].z;
+        _zmin[i] = std::min(z0, std::min(z1, z2));
+        _zmax[i] = std::max(z0, std::max(z1, z2));
+      }
+    }
+
+    /**
+     * @brief trace the contours and hand every line to the sink as soon as it's finished
+     *
+     * @param levels the iso-levels
+     * @param sink the receiver, calls are serialized so it needn't be thread safe
+     * @param threads the number of threads, zero means all hardware threads
+     * @attention the levels are traced in parallel, so the lines of different levels
+     * arrive interleaved. closed rings are emitted the moment they close,
+     * the lines ending on the TIN border when their level is done.
+     */
+    void trace(const std::vector<value_type> &levels, const sink_type &sink,
+               std::size_t threads = 0) const {
+      std::mutex sinkMutex;
+      parallelFor(
+          0, levels.size(), [&](std::size_t idx, std::size_t) {
+            this->traceLevel(levels[idx], [&](linestring_type &&ls) {
+              std::lock_guard<std::mutex> lock(sinkMutex);
+              sink(idx, std::move(ls));
+            });
+          },
+          threads);
+    }
+
+    /**
+     * @brief trace the contours and collect them per level
+     *
+     * @param levels the iso-levels
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::vector<std::vector<linestring_type>> the lines of 'levels[i]' are at [i]
+     */
+    std::vector<std::vector<linestring_type>> trace(const std::vector<value_type> &levels,
+                                                    std::size_t threads = 0) const {
+      std::vector<std::vector<linestring_type>> res(levels.size());
+      // every level owns its slot, so no lock is needed here
+      parallelFor(
+          0, levels.size(), [&](std::size_t idx, std::size_t) {
+            this->traceLevel(levels[idx], [&](linestring_type &&ls) {
+              res[idx].push_back(std::move(ls));
+            });
+          },
+          threads);
+      return res;
+    }
+
+  protected:
+    /**
+     * @brief a polyline under construction
+     */
+    struct Chain {
+      std::deque<Point2<value_type>> pts;
+      std::uint64_t headKey;
+      std::uint64_t tailKey;
+    };
+
+    static inline std::uint64_t edgeKey(std::size_t i, std::size_t j) {
+      if (i > j)
+        std::swap(i, j);
+      return (static_cast<std::uint64_t>(i) << 32) ^ static_cast<std::uint64_t>(j);
+    }
+
+    /**
+     * @brief the point where the level cuts the edge from vertex 'lo' (below) to 'hi' (above)
+     */
+    inline Point2<value_type> cut(std::size_t lo, std::size_t hi, value_type level) const {
+      const auto &p = _pts[lo], &q = _pts[hi];
+      double t = (static_cast<double>(level) - p.z) / (static_cast<double>(q.z) - p.z);
+      return Point2<value_type>(static_cast<value_type>(p.x + t * (q.x - p.x)),
+                                static_cast<value_type>(p.y + t * (q.y - p.y)));
+    }
+
+    template <typename Emit>
+    void traceLevel(value_type level, Emit emit) const {
+      std::vector<Chain> chains;
+      std::vector<std::size_t> freeChains;
+      // the chain starting / ending at a TIN edge
+      std::unordered_map<std::uint64_t, std::size_t> heads, tails;
+
+      auto release = [&](std::size_t c) {
+        chains[c].pts.clear();
+        freeChains.push_back(c);
+      };
+      auto finish = [&](std::size_t c) {
+        auto &pts = chains[c].pts;
+        emit(linestring_type(pts.begin(), pts.end()));
+        release(c);
+      };
+
+      for (std::size_t t = 0; t != _tin.size(); ++t) {
+        if (!(_zmin[t] < level && _zmax[t] >= level))
+          continue;
+        auto tri = _tin[t];
+        // make the triangle counter-clockwise
+        const auto &a = _pts[tri[0]], &b = _pts[tri[1]], &c = _pts[tri[2]];
+        if ((static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+                (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x) <
+            0.0)
+          std::swap(tri[1], tri[2]);
+        // walking counter-clockwise, the piece runs from the edge leaving the high ground
+        // to the edge entering it, which keeps the high ground on its left
+        std::size_t inFrom = 0, inTo = 0, outFrom = 0, outTo = 0;
+        for (int k = 0; k != 3; ++k) {
+          std::size_t u = tri[k], v = tri[(k + 1) % 3];
+          bool uAbove = _pts[u].z >= level, vAbove = _pts[v].z >= level;
+          if (!uAbove && vAbove)
+            inFrom = u, inTo = v;
+          else if (uAbove && !vAbove)
+            outFrom = u, outTo = v;
+        }
+        std::uint64_t sKey = edgeKey(outFrom, outTo), eKey = edgeKey(inFrom, inTo);
+        auto sPt = cut(outTo, outFrom, level), ePt = cut(inFrom, inTo, level);
+
+        auto c1Iter = tails.find(sKey);
+        auto c2Iter = heads.find(eKey);
+        bool has1 = c1Iter != tails.end(), has2 = c2Iter != heads.end();
+        if (has1 && has2) {
+          std::size_t c1 = c1Iter->second, c2 = c2Iter->second;
+          tails.erase(c1Iter);
+          heads.erase(c2Iter);
+          if (c1 == c2) {
+            // the ring closes
+            chains[c1].pts.push_back(chains[c1].pts.front());
+            finish(c1);
+            continue;
+          }
+          // join 'c1 -> piece -> c2', moving the shorter chain into the longer one
+          if (chains[c1].pts.size() >= chains[c2].pts.size()) {
+            auto &dst = chains[c1].pts;
+            dst.insert(dst.end(), chains[c2].pts.begin(), chains[c2].pts.end());
+            chains[c1].tailKey = chains[c2].tailKey;
+            tails[chains[c1].tailKey] = c1;
+            release(c2);
+          } else {
+            auto &dst = chains[c2].pts;
+            dst.insert(dst.begin(), chains[c1].pts.begin(), chains[c1].pts.end());
+            chains[c2].headKey = chains[c1].headKey;
+            heads[chains[c2].headKey] = c2;
+            release(c1);
+          }
+        } else if (has1) {
+          std::size_t c1 = c1Iter->second;
+          tails.erase(c1Iter);
+          chains[c1].pts.push_back(ePt);
+          chains[c1].tailKey = eKey;
+          tails[eKey] = c1;
+        } else if (has2) {
+          std::size_t c2 = c2Iter->second;
+          heads.erase(c2Iter);
+          chains[c2].pts.push_front(sPt);
+          chains[c2].headKey = sKey;
+          heads[sKey] = c2;
+        } else {
+          std::size_t c;
+          if (freeChains.empty()) {
+            c = chains.size();
+            chains.emplace_back();
+          } else {
+            c = freeChains.back();
+            freeChains.pop_back();
+          }
+          chains[c].pts.push_back(sPt);
+          chains[c].pts.push_back(ePt);
+          chains[c].headKey = sKey;
+          chains[c].tailKey = eKey;
+          heads[sKey] = c;
+          tails[eKey] = c;
+        }
+      }
+      // the chains left open end on the border of the TIN
+      for (const auto &[key, c] : heads)
+        finish(c);
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
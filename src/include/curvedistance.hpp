@@ -0,0 +1,225 @@
+#ifndef CURVEDISTANCE_HPP
+#define CURVEDISTANCE_HPP
+
+/**
+ * @file curvedistance.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Hausdorff and discrete Frechet distances between line strings
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "linestring.hpp"
+#include "parallel.hpp"
+#include <limits>
+
+namespace ns_geo {
+#pragma region CurveDistance
+
+  enum class CurveMetric {
+    /**
+     * @brief the discrete Hausdorff distance over the vertices
+     */
+    HAUSDORFF,
+    /**
+     * @brief the discrete Frechet distance over the vertices
+     */
+    FRECHET
+  };
+
+  /**
+   * @brief the similarity measures between two line strings, both over their vertices
+   *
+   * @attention the decision forms ('...Within') stop as soon as the answer is known and
+   * reject by the bounding boxes first: if the Hausdorff distance is at most 'eps', so is the
+   * gap between the corresponding sides of the two boxes. the Frechet distance is never less
+   * than the Hausdorff one and needs the end points to match within 'eps' as well.
+   * the Frechet dynamic programming keeps a single row, so it runs in O(nm) time and O(m) memory.
+   */
+  template <typename Ty = float>
+  class CurveDistance {
+  public:
+    using value_type = Ty;
+    using linestring_type = LineString2<value_type>;
+    using self_type = CurveDistance<value_type>;
+
+  public:
+    /**
+     * @brief the symmetric discrete Hausdorff distance
+     */
+    static double hausdorff(const linestring_type &a, const linestring_type &b) {
+      double inf = std::numeric_limits<double>::infinity();
+      if (a.empty() || b.empty())
+        return inf;
+      return std::sqrt(std::max(directed2(a, b, inf), directed2(b, a, inf)));
+    }
+
+    /**
+     * @brief whether the discrete Hausdorff distance is at most 'eps'
+     */
+    static bool hausdorffWithin(const linestring_type &a, const linestring_type &b, double eps) {
+      if (a.empty() || b.empty() || !boxesWithin(a, b, eps))
+        return false;
+      double eps2 = eps * eps;
+      return directed2(a, b, eps2) <= eps2 && directed2(b, a, eps2) <= eps2;
+    }
+
+    /**
+     * @brief the discrete Frechet distance
+     */
+    static double frechet(const linestring_type &a, const linestring_type &b) {
+      if (a.empty() || b.empty())
+        return std::numeric_limits<double>::infinity();
+      std::size_t m = b.size();
+      std::vector<double> row(m);
+      for (std::size_t i = 0; i != a.size(); ++i) {
+        double diag = 0.0;
+        for (std::size_t j = 0; j != m; ++j) {
+          double d = distance2(a[i], b[j]), up = row[j], best;
+          if (i == 0 && j == 0)
+            best = d;
+          else if (i == 0)
+            best = std::max(d, row[j - 1]);
+          else if (j == 0)
+            best = std::max(d, up);
+          else
+            best = std::max(d, std::min(std::min(up, diag), row[j - 1]));
+          // the old 'row[j]' is the diagonal of the next column
+          diag = up, row[j] = best;
+        }
+      }
+      return std::sqrt(row.back());
+    }
+
+    /**
+     * @brief whether the discrete Frechet distance is at most 'eps'
+     */
+    static bool frechetWithin(const linestring_type &a, const linestring_type &b, double eps) {
+      if (a.empty() || b.empty() || !boxesWithin(a, b, eps))
+        return false;
+      double eps2 = eps * eps;
+      if (distance2(a.front(), b.front()) > eps2 || distance2(a.back(), b.back()) > eps2)
+        return false;
+      // the reachable cells of the free space, one row at a time
+      std::size_t m = b.size();
+      std::vector<char> row(m, 0);
+      for (std::size_t i = 0; i != a.size(); ++i) {
+        char diag = 0, any = 0;
+        for (std::size_t j = 0; j != m; ++j) {
+          char up = row[j], reach;
+          if (i == 0 && j == 0)
+            reach = 1;
+          else
+            reach = up || (j != 0 && (diag || row[j - 1]));
+          reach = reach && distance2(a[i], b[j]) <= eps2;
+          diag = up, row[j] = reach, any |= reach;
+        }
+        // no way through any more
+        if (!any)
+          return false;
+      }
+      return row.back() != 0;
+    }
+
+    /**
+     * @brief the distance by the metric
+     */
+    static double distance(const linestring_type &a, const linestring_type &b, CurveMetric metric) {
+      return metric == CurveMetric::HAUSDORFF ? hausdorff(a, b) : frechet(a, b);
+    }
+
+    /**
+     * @brief whether the distance by the metric is at most 'eps'
+     */
+    static bool within(const linestring_type &a, const linestring_type &b, double eps, CurveMetric metric) {
+      return metric == CurveMetric::HAUSDORFF ? hausdorffWithin(a, b, eps) : frechetWithin(a, b, eps);
+    }
+
+    /**
+     * @brief the distances from a query to many candidates
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static std::vector<double> distances(const linestring_type &query, const std::vector<linestring_type> &candidates,
+                                         CurveMetric metric, std::size_t threads = 0) {
+      std::vector<double> res(candidates.size());
+      parallelFor(
+          0, candidates.size(), [&](std::size_t i, std::size_t) { res[i] = distance(query, candidates[i], metric); },
+          threads, 4);
+      return res;
+    }
+
+    /**
+     * @brief the indices of the candidates within 'eps' of the query, in ascending order
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static std::vector<std::size_t> matches(const linestring_type &query, const std::vector<linestring_type> &candidates,
+                                            double eps, CurveMetric metric, std::size_t threads = 0) {
+      std::vector<char> hit(candidates.size(), 0);
+      parallelFor(
+          0, candidates.size(), [&](std::size_t i, std::size_t) { hit[i] = within(query, candidates[i], eps, metric); },
+          threads, 4);
+      std::vector<std::size_t> res;
+      for (std::size_t i = 0; i != hit.size(); ++i)
+        if (hit[i])
+          res.push_back(i);
+      return res;
+    }
+
+  protected:
+    static inline double distance2(const Point2<value_type> &p, const Point2<value_type> &q) {
+      double dx = static_cast<double>(p.x) - q.x, dy = static_cast<double>(p.y) - q.y;
+      return dx * dx + dy * dy;
+    }
+
+    /**
+     * @brief the squared directed Hausdorff distance from 'a' to 'b', abandoned once it exceeds 'limit2'
+     *
+     * @attention the inner scan of a point stops as soon as it finds a vertex nearer than
+     * the running maximum, as that point can't raise it any more
+     */
+    static double directed2(const linestring_type &a, const linestring_type &b, double limit2) {
+      double cmax = 0.0;
+      for (const auto &p : a) {
+        double cmin = std::numeric_limits<double>::infinity();
+        for (const auto &q : b) {
+          double d = distance2(p, q);
+          if (d < cmin) {
+            cmin = d;
+            if (cmin <= cmax)
+              break;
+          }
+        }
+        cmax = std::max(cmax, cmin);
+        if (cmax > limit2)
+          return cmax;
+      }
+      return cmax;
+    }
+
+    static std::array<double, 4> box(const linestring_type &ls) {
+      double inf = std::numeric_limits<double>::max();
+      std::array<double, 4> b{inf, inf, -inf, -inf};
+      for (const auto &p : ls) {
+        b[0] = std::min<double>(b[0], p.x), b[1] = std::min<double>(b[1], p.y);
+        b[2] = std::max<double>(b[2], p.x), b[3] = std::max<double>(b[3], p.y);
+      }
+      return b;
+    }
+
+    static bool boxesWithin(const linestring_type &a, const linestring_type &b, double eps) {
+      auto ba = box(a), bb = box(b);
+      for (int k = 0; k != 4; ++k)
+        if (std::abs(ba[k] - bb[k]) > eps)
+          return false;
+      return true;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef DELAUNAY_HPP
+#define DELAUNAY_HPP
+
+/**
+ * @file delaunay.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Delaunay triangulation of 2-dime point sets
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "triangle.hpp"
+
+namespace ns_geo {
+#pragma region Delaunay2
+
+  template <typename Ty>
+  class Voronoi2;
+
+  /**
+   * @brief the Delaunay triangulation of a point set
+   *
+   * @attention the points are inserted in Hilbert order into a mesh enclosed by a super
+   * triangle and the empty-circle property is restored by edge flips (Lawson). the predicates
+   * take the super vertices at infinity, as polynomials in their distance, so no circle of
+   * the points ever holds one and the triangles cover the convex hull however thin it is.
+   * duplicated points are skipped, they keep no triangle of their own.
+   */
+  template <typename Ty = float>
+  class Delaunay2 {
+  public:
+    using value_type = Ty;
+    using id_type = uint;
+    using pointset_type = PointSet2<value_type>;
+    using refpointset_type = RefPointSet2<value_type>;
+    using triangle_type = std::array<id_type, 3>;
+    using self_type = Delaunay2<value_type>;
+
+  public:
+    friend class Voronoi2<value_type>;
+
+  protected:
+    /**
+     * @brief a mesh facet, 'n[i]' is the neighbor across the edge opposite to 'v[i]'
+     */
+    struct Facet {
+      int v[3];
+      int n[3];
+    };
+
+    /**
+     * @brief a value 'c[0] + c[1] M + ... + c[4] M^4' of the predicates, for the super vertices at
+     * 'M' times their directions and 'M' going to infinity, so its sign is the one of the leading term
+     */
+    struct Symbolic {
+      std::array<double, 5> c{};
+
+      Symbolic operator+(const Symbolic &o) const {
+        Symbolic res;
+        for (int i = 0; i != 5; ++i)
+          res.c[i] = c[i] + o.c[i];
+        return res;
+      }
+
+      Symbolic operator-(const Symbolic &o) const {
+        Symbolic res;
+        for (int i = 0; i != 5; ++i)
+          res.c[i] = c[i] - o.c[i];
+        return res;
+      }
+
+      // the predicates are of the fourth degree at most
+      Symbolic operator*(const Symbolic &o) const {
+        Symbolic res;
+        for (int i = 0; i != 5; ++i)
+          for (int j = 0; i + j < 5; ++j)
+            res.c[i + j] += c[i] * o.c[j];
+        return res;
+      }
+
+      [[nodiscard]] double leading() const {
+        for (int i = 4; i >= 0; --i)
+          if (c[i] != 0.0)
+            return c[i];
+        return 0.0;
+      }
+    };
+
+    // the directions of the super vertices, counter-clockwise
+    static constexpr double SUPER_X[3] = {-1.0, 1.0, 0.0};
+    static constexpr double SUPER_Y[3] = {-1.0, -1.0, 1.0};
+
+    // the coordinates relative to '_origin', the last three are the super triangle
+    std::vector<double> _x;
+    std::vector<double> _y;
+    std::vector<id_type> _ids;
+    std::unordered_map<id_type, int> _vertexOf;
+    // one facet incident to every vertex, -1 for the skipped duplicates
+    std::vector<int> _facetOf;
+    std::vector<Facet> _facets;
+    Point2<double> _origin;
+    std::size_t _siteNum;
+
+  public:
+    /**
+     * @brief triangulate the points, the ids of the triangles are the indices in the point set
+     */
+    explicit Delaunay2(const pointset_type &ps) {
+      std::vector<id_type> ids(ps.size());
+      std::vector<Point2<double>> pts(ps.size());
+      for (std::size_t i = 0; i != ps.size(); ++i)
+        ids[i] = static_cast<id_type>(i), pts[i] = Point2<double>(ps[i].x, ps[i].y);
+      this->build(ids, pts);
+    }
+
+    /**
+     * @brief triangulate the reference points, the triangles refer to the point ids
+     */
+    explicit Delaunay2(const refpointset_type &rps) {
+      std::vector<id_type> ids;
+      std::vector<Point2<double>> pts;
+      ids.reserve(rps.size()), pts.reserve(rps.size());
+      for (const auto &[id, p] : rps)
+        ids.push_back(id), pts.push_back(Point2<double>(p.x, p.y));
+      this->build(ids, pts);
+    }
+
+    /**
+     * @brief the counter-clockwise triangles made of the point ids
+     */
+    [[nodiscard]] std::vector<triangle_type> triangles() const {
+      std::vector<triangle_type> res;
+      res.reserve(_facets.size());
+      int n = static_cast<int>(_siteNum);
+      for (const auto &f : _facets)
+        if (f.v[0] < n && f.v[1] < n && f.v[2] < n)
+          res.push_back({_ids[f.v[0]], _ids[f.v[1]], _ids[f.v[2]]});
+      return res;
+    }
+
+    /**
+     * @brief the triangles as 'RefTriangle2' objects of the triangulated reference point set
+     */
+    [[nodiscard]] std::vector<RefTriangle2<value_type>> refTriangles(const refpointset_type &rps) const {
+      std::vector<RefTriangle2<value_type>> res;
+      for (const auto &t : this->triangles())
+        res.push_back(rps.createRefTriangle2(t[0], t[1], t[2]));
+      return res;
+    }
+
+    /**
+     * @brief the number of points taking part in the triangulation, duplicates excluded
+     */
+    [[nodiscard]] std::size_t vertexNum() const {
+      return std::count_if(_facetOf.cbegin(), _facetOf.cbegin() + _siteNum, [](int f) { return f >= 0; });
+    }
+
+  protected:
+    template <typename Val>
+    static inline Val orient(const Val &ax, const Val &ay, const Val &bx, const Val &by, const Val &cx, const Val &cy) {
+      return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    }
+
+    /**
+     * @brief positive if 'd' lies inside the circumcircle of the counter-clockwise 'a, b, c'
+     */
+    template <typename Val>
+    static inline Val incircle(const Val &ax, const Val &ay, const Val &bx, const Val &by,
+                               const Val &cx, const Val &cy, const Val &dx, const Val &dy) {
+      Val adx = ax - dx, ady = ay - dy;
+      Val bdx = bx - dx, bdy = by - dy;
+      Val cdx = cx - dx, cdy = cy - dy;
+      Val ad = adx * adx + ady * ady;
+      Val bd = bdx * bdx + bdy * bdy;
+      Val cd = cdx * cdx + cdy * cdy;
+      return adx * (bdy * cd - bd * cdy) - ady * (bdx * cd - bd * cdx) + ad * (bdx * cdy - bdy * cdx);
+    }
+
+    inline void symbolic(int v, Symbolic &x, Symbolic &y) const {
+      int n = static_cast<int>(_siteNum);
+      if (v < n)
+        x.c[0] = _x[v], y.c[0] = _y[v];
+      else
+        x.c[1] = SUPER_X[v - n], y.c[1] = SUPER_Y[v - n];
+    }
+
+    /**
+     * @brief the orientation of the vertices 'a, b, c', positive for counter-clockwise
+     */
+    inline double orientOf(int a, int b, int c) const {
+      int n = static_cast<int>(_siteNum);
+      if (a < n && b < n && c < n)
+        return orient(_x[a], _y[a], _x[b], _y[b], _x[c], _y[c]);
+      Symbolic s[6];
+      this->symbolic(a, s[0], s[1]), this->symbolic(b, s[2], s[3]), this->symbolic(c, s[4], s[5]);
+      return orient(s[0], s[1], s[2], s[3], s[4], s[5]).leading();
+    }
+
+    /**
+     * @brief positive if the vertex 'd' lies inside the circumcircle of the vertices 'a, b, c'
+     */
+    inline double incircleOf(int a, int b, int c, int d) const {
+      int n = static_cast<int>(_siteNum);
+      if (a < n && b < n && c < n && d < n)
+        return incircle(_x[a], _y[a], _x[b], _y[b], _x[c], _y[c], _x[d], _y[d]);
+      // expanded about a point of the set, as the terms of the super vertices alone then
+      // come out exact and cancel to the zeros they are
+      while (a >= n && (b < n || c < n))
+        std::swap(a, b), std::swap(b, c);
+      Symbolic s[8];
+      this->symbolic(a, s[0], s[1]), this->symbolic(b, s[2], s[3]);
+      this->symbolic(c, s[4], s[5]), this->symbolic(d, s[6], s[7]);
+      return -incircle(s[2], s[3], s[4], s[5], s[6], s[7], s[0], s[1]).leading();
+    }
+
+    /**
+     * @brief the position of (x, y) on a Hilbert curve of order 16
+     */
+    static std::uint64_t hilbert(std::uint32_t x, std::uint32_t y) {
+      std::uint64_t d = 0;
+      for (std::uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+          if (rx == 1)
+            x = s - 1 - (x & (s - 1)), y = s - 1 - (y & (s - 1));
+          std::swap(x, y);
+        }
+      }
+      return d;
+    }
+
+    inline int edgeIndex(int f, int nb) const {
+      const auto &n = _facets[f].n;
+      return n[0] == nb ? 0 : (n[1] == nb ? 1 : 2);
+    }
+
+    inline void relink(int f, int from, int to) {
+      if (f >= 0)
+        _facets[f].n[this->edgeIndex(f, from)] = to;
+    }
+
+    void build(const std::vector<id_type> &ids, const std::vector<Point2<double>> &pts) {
+      _siteNum = ids.size();
+      double xmin = 0.0, xmax = 0.0, ymin = 0.0, ymax = 0.0;
+      if (!pts.empty()) {
+        xmin = xmax = pts.front().x, ymin = ymax = pts.front().y;
+        for (const auto &p : pts) {
+          xmin = std::min(xmin, p.x), xmax = std::max(xmax, p.x);
+          ymin = std::min(ymin, p.y), ymax = std::max(ymax, p.y);
+        }
+      }
+      _origin = Point2<double>(0.5 * (xmin + xmax), 0.5 * (ymin + ymax));
+      double extent = std::max(std::max(xmax - xmin, ymax - ymin), 1.0);
+
+      // insert the points along a Hilbert curve so the walks stay short
+      std::vector<std::pair<std::uint64_t, std::size_t>> order(_siteNum);
+      for (std::size_t i = 0; i != _siteNum; ++i) {
+        auto hx = static_cast<std::uint32_t>((pts[i].x - xmin) / extent * 65535.0);
+        auto hy = static_cast<std::uint32_t>((pts[i].y - ymin) / extent * 65535.0);
+        order[i] = {hilbert(hx, hy), i};
+      }
+      std::sort(order.begin(), order.end());
+
+      _x.resize(_siteNum + 3), _y.resize(_siteNum + 3), _ids.resize(_siteNum);
+      _facetOf.assign(_siteNum + 3, -1);
+      for (std::size_t i = 0; i != _siteNum; ++i) {
+        auto src = order[i].second;
+        _x[i] = pts[src].x - _origin.x, _y[i] = pts[src].y - _origin.y;
+        _ids[i] = ids[src];
+        _vertexOf[ids[src]] = static_cast<int>(i);
+      }
+      // the super triangle, its coordinates only place the far circumcentres of the Voronoi
+      // cells, which move them further out for a far bound
+      int s = static_cast<int>(_siteNum);
+      double big = 1E3 * extent;
+      for (int k = 0; k != 3; ++k)
+        _x[s + k] = big * SUPER_X[k], _y[s + k] = big * SUPER_Y[k];
+      _facets.reserve(2 * _siteNum + 1);
+      _facets.push_back(Facet{{s, s + 1, s + 2}, {-1, -1, -1}});
+      _facetOf[s] = _facetOf[s + 1] = _facetOf[s + 2] = 0;
+
+      int last = 0;
+      for (int i = 0; i != s; ++i)
+        last = this->insert(i, last);
+    }
+
+    /**
+     * @brief find the facet holding vertex 'p', starting the walk at facet 'f'
+     */
+    int locate(int p, int f) const {
+      std::size_t steps = 0, limit = 4 * _facets.size() + 16;
+      int rot = 0;
+      while (steps++ < limit) {
+        const auto &fa = _facets[f];
+        bool moved = false;
+        // vary the first tested edge to keep the walk from cycling
+        rot = (rot + 1) % 3;
+        for (int k = 0; k != 3; ++k) {
+          int e = (k + rot) % 3;
+          int a = fa.v[(e + 1) % 3], b = fa.v[(e + 2) % 3];
+          if (this->orientOf(a, b, p) < 0.0 && fa.n[e] >= 0) {
+            f = fa.n[e], moved = true;
+            break;
+          }
+        }
+        if (!moved)
+          return f;
+      }
+      // fall back on a scan, only reached for badly degenerated input
+      for (int g = 0; g != static_cast<int>(_facets.size()); ++g) {
+        const auto &fa = _facets[g];
+        bool inside = true;
+        for (int e = 0; e != 3 && inside; ++e) {
+          int a = fa.v[(e + 1) % 3], b = fa.v[(e + 2) % 3];
+          inside = this->orientOf(a, b, p) >= 0.0;
+        }
+        if (inside)
+          return g;
+      }
+      return f;
+    }
+
+    /**
+     * @brief insert vertex 'p', returns a facet incident to it
+     */
+    int insert(int p, int hint) {
+      int t = this->locate(p, hint);
+      double o[3];
+      int zeros = 0, onEdge = -1;
+      for (int e = 0; e != 3; ++e) {
+        int a = _facets[t].v[(e + 1) % 3], b = _facets[t].v[(e + 2) % 3];
+        o[e] = this->orientOf(a, b, p);
+        if (o[e] == 0.0)
+          ++zeros, onEdge = e;
+      }
+      // a duplicated point
+      if (zeros >= 2)
+        return t;
+
+      std::vector<std::pair<int, int>> stack;
+      if (zeros == 1 && _facets[t].n[onEdge] >= 0) {
+        this->splitEdge(t, onEdge, p, stack);
+      } else {
+        this->splitFacet(t, p, stack);
+      }
+      // restore the empty-circle property around 'p'
+      while (!stack.empty()) {
+        auto [f, i] = stack.back();
+        stack.pop_back();
+        int u = _facets[f].n[i];
+        if (u < 0)
+          continue;
+        int j = this->edgeIndex(u, f);
+        int d = _facets[u].v[j];
+        const auto &fv = _facets[f].v;
+        int a = fv[i], b = fv[(i + 1) % 3], c = fv[(i + 2) % 3];
+        if (this->incircleOf(a, b, c, d) > 0.0)
+          this->flip(f, i, stack);
+      }
+      return _facetOf[p];
+    }
+
+    void splitFacet(int t, int p, std::vector<std::pair<int, int>> &stack) {
+      Facet old = _facets[t];
+      int a = old.v[0], b = old.v[1], c = old.v[2];
+      int na = old.n[0], nb = old.n[1], nc = old.n[2];
+      int t0 = t, t1 = static_cast<int>(_facets.size()), t2 = t1 + 1;
+      _facets[t0] = Facet{{a, b, p}, {t1, t2, nc}};
+      _facets.push_back(Facet{{b, c, p}, {t2, t0, na}});
+      _facets.push_back(Facet{{c, a, p}, {t0, t1, nb}});
+      this->relink(na, t, t1);
+      this->relink(nb, t, t2);
+      _facetOf[a] = t0, _facetOf[b] = t0, _facetOf[c] = t1, _facetOf[p] = t0;
+      stack.push_back({t0, 2}), stack.push_back({t1, 2}), stack.push_back({t2, 2});
+    }
+
+    void splitEdge(int t, int e, int p, std::vector<std::pair<int, int>> &stack) {
+      // t = (a, b, c) with 'p' on (b, c), u = (d, c, b) on the other side
+      Facet ft = _facets[t];
+      int a = ft.v[e], b = ft.v[(e + 1) % 3], c = ft.v[(e + 2) % 3];
+      int ntc = ft.n[(e + 2) % 3], ntb = ft.n[(e + 1) % 3];
+      int u = ft.n[e];
+      int j = this->edgeIndex(u, t);
+      Facet fu = _facets[u];
+      int d = fu.v[j];
+      int nuc = fu.n[(j + 1) % 3], nub = fu.n[(j + 2) % 3];
+      int t1 = t, t3 = u, t2 = static_cast<int>(_facets.size()), t4 = t2 + 1;
+      _facets[t1] = Facet{{a, b, p}, {t4, t2, ntc}};
+      _facets.push_back(Facet{{a, p, c}, {t3, ntb, t1}});
+      _facets[t3] = Facet{{d, c, p}, {t2, t4, nub}};
+      _facets.push_back(Facet{{d, p, b}, {t1, nuc, t3}});
+      this->relink(ntb, t, t2);
+      this->relink(nuc, u, t4);
+      _facetOf[a] = t1, _facetOf[b] = t1, _facetOf[c] = t3, _facetOf[d] = t3, _facetOf[p] = t1;
+      stack.push_back({t1, 2}), stack.push_back({t2, 1});
+      stack.push_back({t3, 2}), stack.push_back({t4, 1});
+    }
+
+    /**
+     * @brief flip the edge opposite to vertex 'i' of facet 'f'
+     */
+    void flip(int f, int i, std::vector<std::pair<int, int>> &stack) {
+      Facet ft = _facets[f];
+      int u = ft.n[i];
+      int j = this->edgeIndex(u, f);
+      Facet fu = _facets[u];
+      int p = ft.v[i], b = ft.v[(i + 1) % 3], c = ft.v[(i + 2) % 3], d = fu.v[j];
+      int tnb = ft.n[(i + 1) % 3], tnc = ft.n[(i + 2) % 3];
+      int unc = fu.n[(j + 1) % 3], unb = fu.n[(j + 2) % 3];
+      _facets[f] = Facet{{p, b, d}, {unc, u, tnc}};
+      _facets[u] = Facet{{p, d, c}, {unb, tnb, f}};
+      this->relink(unc, u, f);
+      this->relink(tnb, f, u);
+      _facetOf[p] = f, _facetOf[b] = f, _facetOf[d] = f, _facetOf[c] = u;
+      stack.push_back({f, 0}), stack.push_back({u, 0});
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
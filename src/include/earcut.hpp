@@ -0,0 +1,602 @@
+#ifndef EARCUT_HPP
+#define EARCUT_HPP
+
+/**
+ * @file earcut.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Triangulation of polygons with holes by ear clipping
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "clipping.hpp"
+#include "parallel.hpp"
+#include "triangle.hpp"
+#include <deque>
+
+namespace ns_geo {
+#pragma region EarCut
+
+  /**
+   * @brief the ear clipping triangulation of polygons with holes
+   *
+   * @attention the holes are bridged into the outer ring first, then the ears are clipped.
+   * on large rings the vertices are also linked in z-order, so an ear is checked only against
+   * the vertices inside the z-range of its bounding box, which keeps it near linear
+   * (long thin spikes widen those ranges, so such rings run slower).
+   * when no ear is left, it cures the local self-intersections and finally splits the ring
+   * along a valid diagonal, so degenerate input still gets triangles.
+   * the triangles come out counter-clockwise, made of the vertex indices, counting the outer
+   * ring first and then the holes in order.
+   */
+  template <typename Ty = float>
+  class EarCut {
+  public:
+    using value_type = Ty;
+    using id_type = uint;
+    using triangle_type = std::array<id_type, 3>;
+    using polygon_type = Polygon<value_type>;
+    using refpolygon_type = RefPolygon<value_type>;
+    using polygonwithholes_type = PolygonWithHoles<value_type>;
+    using self_type = EarCut<value_type>;
+
+  protected:
+    struct Node {
+      id_type i;
+      double x, y;
+      Node *prev = nullptr, *next = nullptr;
+      // the z-order curve value and the links in z-order
+      std::uint32_t z = 0;
+      Node *prevZ = nullptr, *nextZ = nullptr;
+      // a one-vertex hole
+      bool steiner = false;
+
+      Node(id_type i, double x, double y) : i(i), x(x), y(y) {}
+    };
+
+    std::deque<Node> _nodes;
+    std::vector<triangle_type> _triangles;
+    bool _hashing = false;
+    double _minX = 0.0, _minY = 0.0, _invSize = 0.0;
+
+  public:
+    /**
+     * @brief triangulate a polygon with holes
+     */
+    static std::vector<triangle_type> triangulate(const polygon_type &outer, const std::vector<polygon_type> &holes = {}) {
+      self_type ec;
+      ec.run(outer, holes);
+      return std::move(ec._triangles);
+    }
+
+    static std::vector<triangle_type> triangulate(const polygonwithholes_type &polygon) {
+      return triangulate(polygon.outer, polygon.holes);
+    }
+
+    /**
+     * @brief triangulate a reference polygon, the triangles are made of the point ids
+     */
+    static std::vector<triangle_type> triangulate(const refpolygon_type &polygon) {
+      polygon_type ring;
+      ring.reserve(polygon.size());
+      for (auto id : polygon)
+        ring.push_back(polygon.refPointSet()->at(id));
+      auto res = triangulate(ring);
+      for (auto &t : res)
+        for (auto &v : t)
+          v = polygon[v];
+      return res;
+    }
+
+    /**
+     * @brief triangulate a polygon with holes into 'Triangle2' objects
+     */
+    static std::vector<Triangle2<value_type>> triangles(const polygon_type &outer,
+                                                        const std::vector<polygon_type> &holes = {}) {
+      auto ids = triangulate(outer, holes);
+      auto vertex = [&](id_type v) -> const Point2<value_type> & {
+        if (v < outer.size())
+          return outer[v];
+        v -= static_cast<id_type>(outer.size());
+        for (const auto &hole : holes) {
+          if (v < hole.size())
+            return hole[v];
+          v -= static_cast<id_type>(hole.size());
+        }
+        return outer.front();
+      };
+      std::vector<Triangle2<value_type>> res;
+      res.reserve(ids.size());
+      for (const auto &t : ids)
+        res.emplace_back(vertex(t[0]), vertex(t[1]), vertex(t[2]));
+      return res;
+    }
+
+    /**
+     * @brief triangulate many polygons
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static std::vector<std::vector<triangle_type>> triangulateBatch(const std::vector<polygon_type> &polygons,
+                                                                    std::size_t threads = 0) {
+      std::vector<std::vector<triangle_type>> res(polygons.size());
+      parallelFor(
+          0, polygons.size(), [&](std::size_t i, std::size_t) { res[i] = triangulate(polygons[i]); }, threads, 16);
+      return res;
+    }
+
+    static std::vector<std::vector<triangle_type>> triangulateBatch(const std::vector<polygonwithholes_type> &polygons,
+                                                                    std::size_t threads = 0) {
+      std::vector<std::vector<triangle_type>> res(polygons.size());
+      parallelFor(
+          0, polygons.size(), [&](std::size_t i, std::size_t) { res[i] = triangulate(polygons[i]); }, threads, 16);
+      return res;
+    }
+
+  protected:
+    EarCut() = default;
+
+    void run(const polygon_type &outer, const std::vector<polygon_type> &holes) {
+      Node *outerNode = this->linkedList(outer, 0, true);
+      if (outerNode == nullptr || outerNode->next == outerNode->prev)
+        return;
+      std::size_t total = outer.size();
+      for (const auto &hole : holes)
+        total += hole.size();
+      _triangles.reserve(total + 2 * holes.size());
+      if (!holes.empty())
+        outerNode = this->eliminateHoles(holes, static_cast<id_type>(outer.size()), outerNode);
+      // z-order hashing only pays off on larger rings
+      if (total > 80) {
+        double maxX = outer.front().x, maxY = outer.front().y;
+        _minX = maxX, _minY = maxY;
+        for (const auto &p : outer) {
+          _minX = std::min<double>(_minX, p.x), _minY = std::min<double>(_minY, p.y);
+          maxX = std::max<double>(maxX, p.x), maxY = std::max<double>(maxY, p.y);
+        }
+        double size = std::max(maxX - _minX, maxY - _minY);
+        _invSize = size != 0.0 ? 32767.0 / size : 0.0;
+        _hashing = _invSize != 0.0;
+      }
+      this->earcutLinked(outerNode, 0);
+    }
+
+    /**
+     * @brief link a ring in the given winding, counter-clockwise for 'ccw'
+     */
+    Node *linkedList(const polygon_type &ring, id_type start, bool ccw) {
+      double sum = 0.0;
+      std::size_t n = ring.size();
+      for (std::size_t i = 0, j = n - 1; i < n; j = i++)
+        sum += (static_cast<double>(ring[j].x) - ring[i].x) * (static_cast<double>(ring[i].y) + ring[j].y);
+      Node *last = nullptr;
+      if (ccw == (sum > 0.0)) {
+        for (std::size_t i = 0; i < n; ++i)
+          last = this->insertNode(start + static_cast<id_type>(i), ring[i].x, ring[i].y, last);
+      } else {
+        for (std::size_t i = n; i-- > 0;)
+          last = this->insertNode(start + static_cast<id_type>(i), ring[i].x, ring[i].y, last);
+      }
+      if (last != nullptr && equals(last, last->next)) {
+        removeNode(last);
+        last = last->next;
+      }
+      return last;
+    }
+
+    /**
+     * @brief drop the duplicated and collinear vertices
+     */
+    Node *filterPoints(Node *start, Node *end = nullptr) {
+      if (start == nullptr)
+        return start;
+      if (end == nullptr)
+        end = start;
+      Node *p = start;
+      bool again;
+      do {
+        again = false;
+        if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0.0)) {
+          removeNode(p);
+          p = end = p->prev;
+          if (p == p->next)
+            break;
+          again = true;
+        } else
+          p = p->next;
+      } while (again || p != end);
+      return end;
+    }
+
+    /**
+     * @brief the main ear slicing loop, 'pass' tells how hard it has tried already
+     */
+    void earcutLinked(Node *ear, int pass) {
+      if (ear == nullptr)
+        return;
+      if (pass == 0 && _hashing)
+        this->indexCurve(ear);
+      Node *stop = ear;
+      while (ear->prev != ear->next) {
+        Node *prev = ear->prev, *next = ear->next;
+        if (_hashing ? this->isEarHashed(ear) : isEar(ear)) {
+          _triangles.push_back({prev->i, ear->i, next->i});
+          removeNode(ear);
+          // skipping the next vertex leads to less sliver triangles
+          ear = next->next;
+          stop = next->next;
+          continue;
+        }
+        ear = next;
+        // a full round without any ear
+        if (ear == stop) {
+          if (pass == 0)
+            this->earcutLinked(this->filterPoints(ear), 1);
+          else if (pass == 1)
+            this->earcutLinked(this->cureLocalIntersections(this->filterPoints(ear)), 2);
+          else
+            this->splitEarcut(ear);
+          break;
+        }
+      }
+    }
+
+    static bool isEar(Node *ear) {
+      const Node *a = ear->prev, *b = ear, *c = ear->next;
+      // a reflex vertex
+      if (area(a, b, c) >= 0.0)
+        return false;
+      double x0 = std::min({a->x, b->x, c->x}), y0 = std::min({a->y, b->y, c->y});
+      double x1 = std::max({a->x, b->x, c->x}), y1 = std::max({a->y, b->y, c->y});
+      // no other vertex may lie inside the ear
+      for (const Node *p = c->next; p != a; p = p->next)
+        if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && blocks(a, b, c, p))
+          return false;
+      return true;
+    }
+
+    bool isEarHashed(Node *ear) const {
+      const Node *a = ear->prev, *b = ear, *c = ear->next;
+      if (area(a, b, c) >= 0.0)
+        return false;
+      double x0 = std::min({a->x, b->x, c->x}), y0 = std::min({a->y, b->y, c->y});
+      double x1 = std::max({a->x, b->x, c->x}), y1 = std::max({a->y, b->y, c->y});
+      // only the vertices within the z-range of the box can lie inside
+      std::uint32_t minZ = this->zOrder(x0, y0), maxZ = this->zOrder(x1, y1);
+      auto inside = [&](const Node *p) {
+        return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c && blocks(a, b, c, p);
+      };
+      const Node *p = ear->prevZ, *n = ear->nextZ;
+      // look both ways at once
+      while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ) {
+        if (inside(p) || inside(n))
+          return false;
+        p = p->prevZ, n = n->nextZ;
+      }
+      for (; p != nullptr && p->z >= minZ; p = p->prevZ)
+        if (inside(p))
+          return false;
+      for (; n != nullptr && n->z <= maxZ; n = n->nextZ)
+        if (inside(n))
+          return false;
+      return true;
+    }
+
+    /**
+     * @brief whether 'p' inside the triangle 'abc' keeps it from being an ear
+     */
+    static inline bool blocks(const Node *a, const Node *b, const Node *c, const Node *p) {
+      return !(a->x == p->x && a->y == p->y) && pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+             area(p->prev, p, p->next) >= 0.0;
+    }
+
+    /**
+     * @brief clip the small self-intersections 'a-p-p.next-b' where 'ab' crosses 'p p.next'
+     */
+    Node *cureLocalIntersections(Node *start) {
+      Node *p = start;
+      do {
+        Node *a = p->prev, *b = p->next->next;
+        if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a)) {
+          _triangles.push_back({a->i, p->i, b->i});
+          removeNode(p);
+          removeNode(p->next);
+          p = start = b;
+        }
+        p = p->next;
+      } while (p != start);
+      return this->filterPoints(p);
+    }
+
+    /**
+     * @brief split the ring in two along a valid diagonal and triangulate both
+     */
+    void splitEarcut(Node *start) {
+      Node *a = start;
+      do {
+        for (Node *b = a->next->next; b != a->prev; b = b->next) {
+          if (a->i != b->i && isValidDiagonal(a, b)) {
+            Node *c = this->splitPolygon(a, b);
+            a = this->filterPoints(a, a->next);
+            c = this->filterPoints(c, c->next);
+            this->earcutLinked(a, 0);
+            this->earcutLinked(c, 0);
+            return;
+          }
+        }
+        a = a->next;
+      } while (a != start);
+    }
+
+    Node *eliminateHoles(const std::vector<polygon_type> &holes, id_type start, Node *outerNode) {
+      std::vector<Node *> queue;
+      for (const auto &hole : holes) {
+        Node *list = this->linkedList(hole, start, false);
+        start += static_cast<id_type>(hole.size());
+        if (list == nullptr)
+          continue;
+        if (list == list->next)
+          list->steiner = true;
+        queue.push_back(leftmost(list));
+      }
+      // bridge the holes from left to right
+      std::sort(queue.begin(), queue.end(), [](const Node *a, const Node *b) {
+        return a->x < b->x || (a->x == b->x && a->y < b->y);
+      });
+      for (Node *hole : queue)
+        outerNode = this->eliminateHole(hole, outerNode);
+      return outerNode;
+    }
+
+    Node *eliminateHole(Node *hole, Node *outerNode) {
+      Node *bridge = findHoleBridge(hole, outerNode);
+      if (bridge == nullptr)
+        return outerNode;
+      Node *bridgeReverse = this->splitPolygon(bridge, hole);
+      this->filterPoints(bridgeReverse, bridgeReverse->next);
+      return this->filterPoints(bridge, bridge->next);
+    }
+
+    /**
+     * @brief the outer vertex to connect the leftmost vertex of a hole to (David Eberly's method)
+     */
+    static Node *findHoleBridge(Node *hole, Node *outerNode) {
+      Node *p = outerNode, *m = nullptr;
+      double hx = hole->x, hy = hole->y, qx = -std::numeric_limits<double>::infinity();
+      if (equals(hole, p))
+        return p;
+      // the nearest segment intersected by a ray to the left of the hole
+      do {
+        if (equals(hole, p->next))
+          return p->next;
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+          double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+          if (x <= hx && x > qx) {
+            qx = x;
+            m = p->x < p->next->x ? p : p->next;
+            if (x == hx)
+              return m;
+          }
+        }
+        p = p->next;
+      } while (p != outerNode);
+      if (m == nullptr)
+        return nullptr;
+      // a vertex inside the triangle (hole, ray hit, m) sees the hole better, take the one of the least angle
+      Node *stop = m;
+      double mx = m->x, my = m->y, tanMin = std::numeric_limits<double>::infinity();
+      p = m;
+      do {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+          double tan = std::abs(hy - p->y) / (hx - p->x);
+          if (locallyInside(p, hole) &&
+              (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sectorContainsSector(m, p)))))) {
+            m = p;
+            tanMin = tan;
+          }
+        }
+        p = p->next;
+      } while (p != stop);
+      return m;
+    }
+
+    static bool sectorContainsSector(const Node *m, const Node *p) {
+      return area(m->prev, m, p->prev) < 0.0 && area(p->next, m, m->next) < 0.0;
+    }
+
+    /**
+     * @brief link the vertices in z-order as well
+     */
+    void indexCurve(Node *start) {
+      Node *p = start;
+      do {
+        if (p->z == 0)
+          p->z = this->zOrder(p->x, p->y);
+        p->prevZ = p->prev;
+        p->nextZ = p->next;
+        p = p->next;
+      } while (p != start);
+      p->prevZ->nextZ = nullptr;
+      p->prevZ = nullptr;
+      sortLinked(p);
+    }
+
+    /**
+     * @brief the bottom-up merge sort of the z-order links (Simon Tatham's)
+     */
+    static Node *sortLinked(Node *list) {
+      std::size_t inSize = 1, numMerges;
+      do {
+        Node *p = list, *tail = nullptr;
+        list = nullptr;
+        numMerges = 0;
+        while (p != nullptr) {
+          ++numMerges;
+          Node *q = p;
+          std::size_t pSize = 0;
+          for (std::size_t i = 0; i < inSize && q != nullptr; ++i)
+            ++pSize, q = q->nextZ;
+          std::size_t qSize = inSize;
+          while (pSize > 0 || (qSize > 0 && q != nullptr)) {
+            Node *e;
+            if (pSize != 0 && (qSize == 0 || q == nullptr || p->z <= q->z))
+              e = p, p = p->nextZ, --pSize;
+            else
+              e = q, q = q->nextZ, --qSize;
+            if (tail != nullptr)
+              tail->nextZ = e;
+            else
+              list = e;
+            e->prevZ = tail;
+            tail = e;
+          }
+          p = q;
+        }
+        tail->nextZ = nullptr;
+        inSize *= 2;
+      } while (numMerges > 1);
+      return list;
+    }
+
+    /**
+     * @brief interleave the bits of the 15-bit coordinates
+     */
+    std::uint32_t zOrder(double px, double py) const {
+      auto x = static_cast<std::uint32_t>((px - _minX) * _invSize);
+      auto y = static_cast<std::uint32_t>((py - _minY) * _invSize);
+      x = (x | (x << 8)) & 0x00FF00FF, x = (x | (x << 4)) & 0x0F0F0F0F;
+      x = (x | (x << 2)) & 0x33333333, x = (x | (x << 1)) & 0x55555555;
+      y = (y | (y << 8)) & 0x00FF00FF, y = (y | (y << 4)) & 0x0F0F0F0F;
+      y = (y | (y << 2)) & 0x33333333, y = (y | (y << 1)) & 0x55555555;
+      return x | (y << 1);
+    }
+
+    static Node *leftmost(Node *start) {
+      Node *p = start, *res = start;
+      do {
+        if (p->x < res->x || (p->x == res->x && p->y < res->y))
+          res = p;
+        p = p->next;
+      } while (p != start);
+      return res;
+    }
+
+    static inline bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px,
+                                       double py) {
+      return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+             (bx - px) * (cy - py) >= (cx - px) * (by - py);
+    }
+
+    /**
+     * @brief whether the diagonal 'ab' can split the ring
+     */
+    static bool isValidDiagonal(const Node *a, const Node *b) {
+      return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b) &&
+             ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+               (area(a->prev, a, b->prev) != 0.0 || area(a, b->prev, b) != 0.0)) ||
+              (equals(a, b) && area(a->prev, a, a->next) > 0.0 && area(b->prev, b, b->next) > 0.0));
+    }
+
+    /**
+     * @brief the signed area of a triangle, negative for a counter-clockwise one
+     */
+    static inline double area(const Node *p, const Node *q, const Node *r) {
+      return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+    }
+
+    static inline bool equals(const Node *p1, const Node *p2) {
+      return p1->x == p2->x && p1->y == p2->y;
+    }
+
+    static inline int sign(double v) {
+      return (v > 0.0) - (v < 0.0);
+    }
+
+    static inline bool onSegment(const Node *p, const Node *q, const Node *r) {
+      return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) &&
+             q->y >= std::min(p->y, r->y);
+    }
+
+    static bool intersects(const Node *p1, const Node *q1, const Node *p2, const Node *q2) {
+      int o1 = sign(area(p1, q1, p2)), o2 = sign(area(p1, q1, q2));
+      int o3 = sign(area(p2, q2, p1)), o4 = sign(area(p2, q2, q1));
+      if (o1 != o2 && o3 != o4)
+        return true;
+      return (o1 == 0 && onSegment(p1, p2, q1)) || (o2 == 0 && onSegment(p1, q2, q1)) ||
+             (o3 == 0 && onSegment(p2, p1, q2)) || (o4 == 0 && onSegment(p2, q1, q2));
+    }
+
+    static bool intersectsPolygon(const Node *a, const Node *b) {
+      const Node *p = a;
+      do {
+        if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects(p, p->next, a, b))
+          return true;
+        p = p->next;
+      } while (p != a);
+      return false;
+    }
+
+    static bool locallyInside(const Node *a, const Node *b) {
+      return area(a->prev, a, a->next) < 0.0 ? area(a, b, a->next) >= 0.0 && area(a, a->prev, b) >= 0.0
+                                             : area(a, b, a->prev) < 0.0 || area(a, a->next, b) < 0.0;
+    }
+
+    static bool middleInside(const Node *a, const Node *b) {
+      const Node *p = a;
+      bool inside = false;
+      double px = 0.5 * (a->x + b->x), py = 0.5 * (a->y + b->y);
+      do {
+        if ((p->y > py) != (p->next->y > py) && p->next->y != p->y &&
+            px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)
+          inside = !inside;
+        p = p->next;
+      } while (p != a);
+      return inside;
+    }
+
+    /**
+     * @brief link 'a' and 'b' by two opposite half diagonals, splitting the ring in two
+     *
+     * @return Node* the copy of 'b' on the other ring
+     */
+    Node *splitPolygon(Node *a, Node *b) {
+      Node *a2 = &_nodes.emplace_back(a->i, a->x, a->y);
+      Node *b2 = &_nodes.emplace_back(b->i, b->x, b->y);
+      Node *an = a->next, *bp = b->prev;
+      a->next = b, b->prev = a;
+      a2->next = an, an->prev = a2;
+      b2->next = a2, a2->prev = b2;
+      bp->next = b2, b2->prev = bp;
+      return b2;
+    }
+
+    Node *insertNode(id_type i, double x, double y, Node *last) {
+      Node *p = &_nodes.emplace_back(i, x, y);
+      if (last == nullptr) {
+        p->prev = p->next = p;
+      } else {
+        p->next = last->next;
+        p->prev = last;
+        last->next->prev = p;
+        last->next = p;
+      }
+      return p;
+    }
+
+    static void removeNode(Node *p) {
+      p->next->prev = p->prev;
+      p->prev->next = p->next;
+      if (p->prevZ != nullptr)
+        p->prevZ->nextZ = p->nextZ;
+      if (p->nextZ != nullptr)
+        p->nextZ->prevZ = p->prevZ;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef ELLIPSE_HPP
+#define ELLIPSE_HPP
+
+/**
+ * @file ellipse.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Ellipses with the direct least squares fit and its geometric refinement
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "eigen3/Eigen/Dense"
+#include "point.hpp"
+
+namespace ns_geo {
+  class Ellipse : protected Geometry {
+  public:
+    using value_type = double;
+    using point_type = Point2<value_type>;
+    using self_type = Ellipse;
+    using pointset_type = PointSet2<value_type>;
+
+  public:
+    /**
+     * @brief the members, the semi-axis 'a' runs along the direction 'angle' and 'b' across it
+     */
+    point_type cen;
+    value_type a;
+    value_type b;
+    value_type angle;
+
+    /**
+     * @brief the iterations of the foot point search, enough for the double precision
+     */
+    static constexpr int FOOT_ITERATIONS = 8;
+
+  public:
+    /**
+     * @brief construct a new Ellipse object
+     */
+    Ellipse(const point_type &cen, const value_type &a, const value_type &b, const value_type &angle)
+        : cen(cen), a(a), b(b), angle(angle) {}
+
+    // the distance from the point to the nearest point on the ellipse
+    value_type distance(const point_type &p) const {
+      value_type c = std::cos(angle), s = std::sin(angle), x, y, fx, fy;
+      this->local(p, c, s, x, y);
+      foot(x, y, a, b, fx, fy);
+      return std::sqrt((x - fx) * (x - fx) + (y - fy) * (y - fy));
+    }
+
+    // the nearest point on the ellipse
+    point_type nearest(const point_type &p) const {
+      value_type c = std::cos(angle), s = std::sin(angle), x, y, fx, fy;
+      this->local(p, c, s, x, y);
+      foot(x, y, a, b, fx, fy);
+      return point_type(cen.x + c * fx - s * fy, cen.y + s * fx + c * fy);
+    }
+
+    // whether the point lies inside the ellipse or on it
+    bool contains(const point_type &p) const {
+      value_type x, y;
+      this->local(p, std::cos(angle), std::sin(angle), x, y);
+      return (x / a) * (x / a) + (y / b) * (y / b) <= 1.0;
+    }
+
+    /**
+     * @brief the distances from many points to the ellipse
+     *
+     * @attention the foot points come from a fixed number of branch-free iterations instead of
+     * solving a quartic per point, so the loop can be vectorized (with '-fno-math-errno' for
+     * the square roots) and costs the same for every point
+     */
+    std::vector<value_type> distances(const pointset_type &points) const {
+      std::size_t n = points.size();
+      std::vector<value_type> res(n);
+      const value_type c = std::cos(angle), s = std::sin(angle), ea = a, eb = b;
+      for (std::size_t i = 0; i != n; ++i) {
+        value_type x, y, fx, fy;
+        this->local(points[i], c, s, x, y);
+        foot(x, y, ea, eb, fx, fy);
+        res[i] = std::sqrt((x - fx) * (x - fx) + (y - fy) * (y - fy));
+      }
+      return res;
+    }
+
+    /**
+     * @brief the direct least squares fit (Fitzgibbon, in the stable form of Halir and Flusser)
+     *
+     * @attention the algebraic distance is minimized under the constraint '4AC - B^2 = 1', so
+     * the conic is always an ellipse. the scatter sums are taken in one pass relative to the
+     * first point and scaled afterwards, and the fit takes no iterations. at least five points
+     * off a line are needed, a degenerate set gives an ellipse of NaNs
+     */
+    static self_type direct(const pointset_type &points) {
+      return direct(points.size(), [&points](std::size_t i) -> const point_type & { return points[i]; });
+    }
+
+    /**
+     * @brief the direct fit to the points at the indices 'idx[0, num)'
+     */
+    static self_type direct(const std::vector<point_type> &points, const std::size_t *idx, std::size_t num) {
+      return direct(num, [&points, idx](std::size_t i) -> const point_type & { return points[idx[i]]; });
+    }
+
+    /**
+     * @brief the geometric fit minimizing the squared distances to the ellipse
+     *
+     * @param iter the max number of Levenberg-Marquardt iterations, starting from the direct fit
+     * @attention a residual is the signed distance to the foot point, and its derivatives follow
+     * from the foot point alone, as the distance is stationary along the ellipse there
+     */
+    static self_type fit(const pointset_type &points, const ushort iter = 10) {
+      auto ell = direct(points);
+      if (!std::isfinite(ell.a) || !std::isfinite(ell.b))
+        return ell;
+      using Vector5d = Eigen::Matrix<value_type, 5, 1>;
+      using Matrix5d = Eigen::Matrix<value_type, 5, 5>;
+      value_type cost = sumSquares(points, ell), lambda = 1E-3;
+      for (int i = 0; i != iter; ++i) {
+        Matrix5d H = Matrix5d::Zero();
+        Vector5d g = Vector5d::Zero();
+        value_type c = std::cos(ell.angle), s = std::sin(ell.angle);
+        for (const auto &p : points) {
+          value_type x, y, fx, fy;
+          ell.local(p, c, s, x, y);
+          foot(x, y, ell.a, ell.b, fx, fy);
+          // the outward normal at the foot point, in the frame of the ellipse
+          value_type nx = fx / (ell.a * ell.a), ny = fy / (ell.b * ell.b), len = std::sqrt(nx * nx + ny * ny);
+          nx /= len, ny /= len;
+          value_type error = nx * (x - fx) + ny * (y - fy);
+          // the derivatives by the center, the semi-axes and the angle
+          Vector5d J;
+          J << -(c * nx - s * ny), -(s * nx + c * ny), -nx * fx / ell.a, -ny * fy / ell.b, nx * fy - ny * fx;
+          H.noalias() += J * J.transpose();
+          g -= J * error;
+        }
+        bool accepted = false;
+        while (!accepted && lambda < 1E10) {
+          Matrix5d A = H;
+          A.diagonal() *= 1.0 + lambda;
+          Vector5d delta = A.ldlt().solve(g);
+          Ellipse next(point_type(ell.cen.x + delta(0), ell.cen.y + delta(1)), ell.a + delta(2), ell.b + delta(3), ell.angle + delta(4));
+          value_type nextCost = next.a > 0.0 && next.b > 0.0 ? sumSquares(points, next) : std::numeric_limits<value_type>::infinity();
+          if (nextCost <= cost) {
+            bool small = delta.norm() <= 1E-12 * (1.0 + std::abs(ell.cen.x) + std::abs(ell.cen.y) + ell.a);
+            ell = next, cost = nextCost, lambda *= 0.1, accepted = true;
+            if (small)
+              return ell.normalized();
+          } else
+            lambda *= 10.0;
+        }
+        if (!accepted)
+          break;
+      }
+      return ell.normalized();
+    }
+
+    [[nodiscard]] inline ns_geo::GeoType type() const override {
+      return GeoType::ELLIPSE;
+    }
+
+  protected:
+    inline void local(const point_type &p, value_type c, value_type s, value_type &x, value_type &y) const {
+      value_type deltaX = p.x - cen.x, deltaY = p.y - cen.y;
+      x = c * deltaX + s * deltaY, y = -s * deltaX + c * deltaY;
+    }
+
+    /**
+     * @brief the foot point of '(x, y)' on the axis-aligned ellipse with the semi-axes 'ea' and 'eb'
+     *
+     * @attention the search runs in the first quadrant, where it walks a point along the
+     * ellipse by the curvature center (the evolute) for a fixed number of steps
+     */
+    static inline void foot(value_type x, value_type y, value_type ea, value_type eb, value_type &fx, value_type &fy) {
+      value_type px = std::abs(x), py = std::abs(y);
+      value_type tx = 0.70710678118654752, ty = tx;
+      for (int i = 0; i != FOOT_ITERATIONS; ++i) {
+        value_type ex = (ea * ea - eb * eb) * tx * tx * tx / ea, ey = (eb * eb - ea * ea) * ty * ty * ty / eb;
+        value_type rx = ea * tx - ex, ry = eb * ty - ey, qx = px - ex, qy = py - ey;
+        value_type r = std::sqrt(rx * rx + ry * ry), q = std::max(std::sqrt(qx * qx + qy * qy), 1E-300);
+        tx = std::min(1.0, std::max(0.0, (qx * r / q + ex) / ea));
+        ty = std::min(1.0, std::max(0.0, (qy * r / q + ey) / eb));
+        value_type t = std::sqrt(tx * tx + ty * ty);
+        tx /= t, ty /= t;
+      }
+      fx = std::copysign(ea * tx, x), fy = std::copysign(eb * ty, y);
+    }
+
+    static value_type sumSquares(const pointset_type &points, const Ellipse &ell) {
+      value_type cost = 0.0;
+      for (value_type d : ell.distances(points))
+        cost += d * d;
+      return cost;
+    }
+
+    // the same ellipse with 'a >= b' and the angle in [-pi/2, pi/2)
+    self_type normalized() const {
+      self_type res = *this;
+      if (res.b > res.a)
+        std::swap(res.a, res.b), res.angle += 0.5 * M_PI;
+      res.angle -= M_PI * std::floor(res.angle / M_PI + 0.5);
+      return res;
+    }
+
+    template <typename Getter>
+    static self_type direct(std::size_t num, Getter get) {
+      const value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+      if (num < 5)
+        return Ellipse(point_type(nan, nan), nan, nan, nan);
+      // the power sums 'su[i][j]' of 'x^i y^j' up to the fourth order, relative to the first point
+      const auto &o = get(0);
+      value_type su[5][5] = {};
+      for (std::size_t k = 0; k != num; ++k) {
+        value_type x = get(k).x - o.x, y = get(k).y - o.y;
+        value_type xx = x * x, xy = x * y, yy = y * y;
+        su[0][0] += 1.0, su[1][0] += x, su[0][1] += y;
+        su[2][0] += xx, su[1][1] += xy, su[0][2] += yy;
+        su[3][0] += xx * x, su[2][1] += xx * y, su[1][2] += x * yy, su[0][3] += yy * y;
+        su[4][0] += xx * xx, su[3][1] += xx * xy, su[2][2] += xx * yy, su[1][3] += xy * yy, su[0][4] += yy * yy;
+      }
+      // scale to unit spread against the ill-conditioning, each sum by its order
+      value_type scale = std::sqrt((su[2][0] + su[0][2]) / num);
+      if (!(scale > 0.0))
+        return Ellipse(point_type(nan, nan), nan, nan, nan);
+      for (int i = 0; i != 5; ++i)
+        for (int j = 0; i + j <= 4; ++j)
+          su[i][j] /= std::pow(scale, i + j);
+      // collinear points leave the scatter singular
+      value_type mx = su[1][0] / num, my = su[0][1] / num;
+      value_type cxx = su[2][0] / num - mx * mx, cxy = su[1][1] / num - mx * my, cyy = su[0][2] / num - my * my;
+      if (cxx * cyy - cxy * cxy <= 1E-12 * (cxx + cyy) * (cxx + cyy))
+        return Ellipse(point_type(nan, nan), nan, nan, nan);
+      // the scatter matrices of the quadratic '(x^2, xy, y^2)' and the linear '(x, y, 1)' terms
+      Eigen::Matrix3d S1, S2, S3;
+      S1 << su[4][0], su[3][1], su[2][2], su[3][1], su[2][2], su[1][3], su[2][2], su[1][3], su[0][4];
+      S2 << su[3][0], su[2][1], su[2][0], su[2][1], su[1][2], su[1][1], su[1][2], su[0][3], su[0][2];
+      S3 << su[2][0], su[1][1], su[1][0], su[1][1], su[0][2], su[0][1], su[1][0], su[0][1], su[0][0];
+      Eigen::Matrix3d T = -S3.ldlt().solve(S2.transpose());
+      Eigen::Matrix3d M = S1 + S2 * T, C;
+      // the inverse of the constraint matrix applied to 'M'
+      C.row(0) = M.row(2) / 2.0, C.row(1) = -M.row(1), C.row(2) = M.row(0) / 2.0;
+      Eigen::EigenSolver<Eigen::Matrix3d> solver(C);
+      Eigen::Vector3d a1;
+      bool found = false;
+      for (int k = 0; k != 3 && !found; ++k) {
+        Eigen::Vector3d v = solver.eigenvectors().col(k).real();
+        if (4.0 * v(0) * v(2) - v(1) * v(1) > 0.0)
+          a1 = v, found = true;
+      }
+      if (!found)
+        return Ellipse(point_type(nan, nan), nan, nan, nan);
+      Eigen::Vector3d a2 = T * a1;
+      self_type res = fromConic(a1(0), a1(1), a1(2), a2(0), a2(1), a2(2));
+      res.cen = point_type(o.x + scale * res.cen.x, o.y + scale * res.cen.y);
+      res.a *= scale, res.b *= scale;
+      return res;
+    }
+
+    /**
+     * @brief the ellipse 'Ax^2 + Bxy + Cy^2 + Dx + Ey + F = 0'
+     */
+    static self_type fromConic(value_type A, value_type B, value_type C, value_type D, value_type E, value_type F) {
+      value_type den = B * B - 4.0 * A * C;
+      value_type x0 = (2.0 * C * D - B * E) / den, y0 = (2.0 * A * E - B * D) / den;
+      value_type num = 2.0 * (A * E * E + C * D * D - B * D * E + den * F);
+      value_type root = std::sqrt((A - C) * (A - C) + B * B);
+      value_type ea = -std::sqrt(num * (A + C + root)) / den, eb = -std::sqrt(num * (A + C - root)) / den;
+      return self_type(point_type(x0, y0), ea, eb, 0.5 * std::atan2(-B, C - A)).normalized();
+    }
+  };
+  /**
+   * @brief override operator '<<' for type 'Ellipse'
+   */
+  std::ostream &operator<<(std::ostream &os, const Ellipse &ell) {
+    os << "[[" << ell.cen.x << ", " << ell.cen.y << "], " << ell.a << ", " << ell.b << ", " << ell.angle << ']';
+    return os;
+  }
+
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef HOUGH_HPP
+#define HOUGH_HPP
+
+/**
+ * @file hough.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Parallel Hough transforms for lines and circles over 2-dime point sets
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "circle.hpp"
+#include "parallel.hpp"
+#include "sline.hpp"
+
+namespace ns_geo {
+#pragma region HoughTransform
+
+  struct HoughLineOptions {
+    /**
+     * @brief the size of a distance bin
+     */
+    double rhoStep = 1.0;
+    /**
+     * @brief the number of direction bins over [0, pi)
+     */
+    std::size_t thetaBins = 180;
+    /**
+     * @brief the fewest votes of a line
+     */
+    std::size_t minVotes = 20;
+    std::size_t maxLines = 16;
+    /**
+     * @brief the half size in bins of the window a peak must top
+     */
+    std::size_t suppression = 2;
+    /**
+     * @brief the number of threads, zero means all hardware threads
+     */
+    std::size_t threads = 0;
+  };
+
+  struct HoughCircleOptions {
+    /**
+     * @brief the size of a centre bin
+     */
+    double centreStep = 1.0;
+    double minRadius = 1.0;
+    double maxRadius = 10.0;
+    double radiusStep = 1.0;
+    /**
+     * @brief the fewest votes of a circle
+     */
+    std::size_t minVotes = 20;
+    std::size_t maxCircles = 16;
+    /**
+     * @brief the half size in bins of the window a peak must top
+     */
+    std::size_t suppression = 2;
+    /**
+     * @brief the number of threads, zero means all hardware threads
+     */
+    std::size_t threads = 0;
+  };
+
+  template <typename Model>
+  struct HoughPeak {
+    Model model;
+    std::size_t votes = 0;
+  };
+
+  /**
+   * @brief vote for lines and circles through the points and pick the peaks of the votes
+   *
+   * @attention the sines and cosines are tabulated once per transform. the points are split
+   * over the threads, each voting into an accumulator of its own, and the accumulators are
+   * summed up in parallel at the end. a peak is a bin with the most votes in the window around
+   * it, the earlier bin winning ties, and the peaks come in descending order of votes. a line
+   * is 'x cos(theta) + y sin(theta) = rho' about the centre of the bounding box, so the
+   * distances stay small, and the direction wraps around with the distance mirrored. a point
+   * votes for the centres on a circle of each radius around it, with as many angles as cover
+   * the circle in centre bins, and the centres range over the bounding box grown by the max
+   * radius. the accumulators take 'threads * bins' counters, which bounds the resolution.
+   */
+  template <typename Ty = float>
+  class HoughTransform {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using pointset_type = PointSet2<value_type>;
+    using self_type = HoughTransform<value_type>;
+    using count_type = std::uint32_t;
+
+  public:
+    static std::vector<HoughPeak<SLine2>> lines(const pointset_type &points, const HoughLineOptions &options = HoughLineOptions()) {
+      std::vector<HoughPeak<SLine2>> res;
+      if (points.empty() || options.thetaBins == 0)
+        return res;
+      double x0, y0, x1, y1;
+      bounds(points, x0, y0, x1, y1);
+      const double cx = 0.5 * (x0 + x1), cy = 0.5 * (y0 + y1);
+      // an odd number of distance bins centred at zero, so the mirror of a bin is a bin
+      const std::size_t half = static_cast<std::size_t>(std::ceil(0.5 * std::hypot(x1 - x0, y1 - y0) / options.rhoStep));
+      const std::size_t rhoBins = 2 * half + 1, thetaBins = options.thetaBins;
+      std::vector<double> cosTable(thetaBins), sinTable(thetaBins);
+      for (std::size_t t = 0; t != thetaBins; ++t) {
+        double theta = M_PI * t / thetaBins;
+        cosTable[t] = std::cos(theta) / options.rhoStep, sinTable[t] = std::sin(theta) / options.rhoStep;
+      }
+
+      auto acc = vote(points.size(), thetaBins * rhoBins, options.threads, [&](std::size_t i, count_type *bins) {
+        double x = points[i].x - cx, y = points[i].y - cy;
+        for (std::size_t t = 0; t != thetaBins; ++t) {
+          auto r = static_cast<std::size_t>(std::lround(x * cosTable[t] + y * sinTable[t]) + static_cast<long>(half));
+          ++bins[t * rhoBins + r];
+        }
+      });
+
+      const long s = static_cast<long>(options.suppression);
+      auto at = [&](long t, long r) -> std::pair<std::size_t, bool> {
+        // past either end of the directions the line comes back with the distance mirrored
+        long T = static_cast<long>(thetaBins), R = static_cast<long>(rhoBins);
+        if (t < 0 || t >= T)
+          t = (t + T) % T, r = R - 1 - r;
+        if (r < 0 || r >= R)
+          return {0, false};
+        return {static_cast<std::size_t>(t) * rhoBins + static_cast<std::size_t>(r), true};
+      };
+      std::vector<std::size_t> peaks;
+      for (std::size_t t = 0; t != thetaBins; ++t)
+        for (std::size_t r = 0; r != rhoBins; ++r) {
+          std::size_t idx = t * rhoBins + r;
+          if (acc[idx] < options.minVotes)
+            continue;
+          bool peak = true;
+          for (long dt = -s; dt <= s && peak; ++dt)
+            for (long dr = -s; dr <= s && peak; ++dr) {
+              auto [other, valid] = at(static_cast<long>(t) + dt, static_cast<long>(r) + dr);
+              if (valid && other != idx)
+                peak = acc[other] < acc[idx] || (acc[other] == acc[idx] && other > idx);
+            }
+          if (peak)
+            peaks.push_back(idx);
+        }
+      select(peaks, acc, options.maxLines);
+      for (std::size_t idx : peaks) {
+        std::size_t t = idx / rhoBins, r = idx % rhoBins;
+        double theta = M_PI * t / thetaBins, rho = (static_cast<double>(r) - static_cast<double>(half)) * options.rhoStep;
+        double a = std::cos(theta), b = std::sin(theta);
+        res.push_back({SLine2(a, b, -(rho + a * cx + b * cy)), acc[idx]});
+      }
+      return res;
+    }
+
+    static std::vector<HoughPeak<Circle>> circles(const pointset_type &points, const HoughCircleOptions &options = HoughCircleOptions()) {
+      std::vector<HoughPeak<Circle>> res;
+      if (points.empty() || options.maxRadius < options.minRadius)
+        return res;
+      double x0, y0, x1, y1;
+      bounds(points, x0, y0, x1, y1);
+      const double step = options.centreStep;
+      x0 -= options.maxRadius, y0 -= options.maxRadius, x1 += options.maxRadius, y1 += options.maxRadius;
+      const std::size_t cols = static_cast<std::size_t>((x1 - x0) / step) + 1, rows = static_cast<std::size_t>((y1 - y0) / step) + 1;
+      const std::size_t radii = static_cast<std::size_t>((options.maxRadius - options.minRadius) / options.radiusStep) + 1;
+      const std::size_t plane = cols * rows;
+      // the offsets of the centres around a point for each radius, in centre bins
+      std::vector<std::vector<std::pair<double, double>>> tables(radii);
+      for (std::size_t k = 0; k != radii; ++k) {
+        double rad = options.minRadius + k * options.radiusStep;
+        std::size_t num = std::max<std::size_t>(8, static_cast<std::size_t>(std::ceil(2.0 * M_PI * rad / step)));
+        for (std::size_t a = 0; a != num; ++a) {
+          double angle = 2.0 * M_PI * a / num;
+          tables[k].emplace_back(rad * std::cos(angle) / step, rad * std::sin(angle) / step);
+        }
+      }
+
+      auto acc = vote(points.size(), radii * plane, options.threads, [&](std::size_t i, count_type *bins) {
+        double x = (points[i].x - x0) / step, y = (points[i].y - y0) / step;
+        for (std::size_t k = 0; k != radii; ++k) {
+          count_type *layer = bins + k * plane;
+          std::size_t first = plane, last = plane;
+          for (const auto &[dx, dy] : tables[k]) {
+            long c = std::lround(x - dx), r = std::lround(y - dy);
+            std::size_t idx = static_cast<std::size_t>(r) * cols + static_cast<std::size_t>(c);
+            // a point votes for a centre once, the angles close together may round to one bin,
+            // and so may the last angles and the first ones, as the circle closes
+            if (c >= 0 && r >= 0 && static_cast<std::size_t>(c) < cols && static_cast<std::size_t>(r) < rows && idx != last &&
+                idx != first) {
+              ++layer[idx], last = idx;
+              if (first == plane)
+                first = idx;
+            }
+          }
+        }
+      });
+
+      const long s = static_cast<long>(options.suppression);
+      const long C = static_cast<long>(cols), R = static_cast<long>(rows), K = static_cast<long>(radii);
+      std::vector<std::size_t> peaks;
+      for (long k = 0; k != K; ++k)
+        for (long r = 0; r != R; ++r)
+          for (long c = 0; c != C; ++c) {
+            std::size_t idx = (k * R + r) * C + c;
+            if (acc[idx] < options.minVotes)
+              continue;
+            bool peak = true;
+            for (long dk = std::max(-s, -k); dk <= std::min(s, K - 1 - k) && peak; ++dk)
+              for (long dr = std::max(-s, -r); dr <= std::min(s, R - 1 - r) && peak; ++dr)
+                for (long dc = std::max(-s, -c); dc <= std::min(s, C - 1 - c) && peak; ++dc) {
+                  std::size_t other = ((k + dk) * R + r + dr) * C + c + dc;
+                  if (other != idx)
+                    peak = acc[other] < acc[idx] || (acc[other] == acc[idx] && other > idx);
+                }
+            if (peak)
+              peaks.push_back(idx);
+          }
+      select(peaks, acc, options.maxCircles);
+      for (std::size_t idx : peaks) {
+        std::size_t k = idx / plane, r = idx % plane / cols, c = idx % cols;
+        Circle cir(Circle::point_type(x0 + c * step, y0 + r * step), options.minRadius + k * options.radiusStep);
+        res.push_back({cir, acc[idx]});
+      }
+      return res;
+    }
+
+  protected:
+    static void bounds(const pointset_type &points, double &x0, double &y0, double &x1, double &y1) {
+      x0 = y0 = std::numeric_limits<double>::infinity(), x1 = y1 = -x0;
+      for (const auto &p : points)
+        x0 = std::min<double>(x0, p.x), y0 = std::min<double>(y0, p.y), x1 = std::max<double>(x1, p.x), y1 = std::max<double>(y1, p.y);
+    }
+
+    /**
+     * @brief let every point vote into an accumulator of its thread, then sum the accumulators
+     *
+     * @param cast the voting of a point, 'cast(idx, bins)'
+     */
+    template <typename Cast>
+    static std::vector<count_type> vote(std::size_t num, std::size_t size, std::size_t threads, Cast cast) {
+      const std::size_t grain = 64;
+      std::size_t workers = parallelWorkers(num, threads, grain);
+      std::vector<std::vector<count_type>> accs(workers);
+      parallelFor(
+          0, num, [&](std::size_t i, std::size_t worker) {
+            auto &acc = accs[worker];
+            if (acc.empty())
+              acc.assign(size, 0);
+            cast(i, acc.data());
+          },
+          threads, grain);
+      // the first one that got any votes takes the sum, in blocks of bins
+      std::size_t first = 0;
+      while (first != workers && accs[first].empty())
+        ++first;
+      std::vector<count_type> res = std::move(accs[first]);
+      const std::size_t block = 1 << 14;
+      parallelFor(
+          0, (size + block - 1) / block, [&](std::size_t b, std::size_t) {
+            std::size_t from = b * block, to = std::min(size, from + block);
+            for (std::size_t w = first + 1; w < workers; ++w) {
+              if (accs[w].empty())
+                continue;
+              const count_type *src = accs[w].data();
+              count_type *dst = res.data();
+              for (std::size_t i = from; i != to; ++i)
+                dst[i] += src[i];
+            }
+          },
+          threads);
+      return res;
+    }
+
+    /**
+     * @brief keep the 'num' peaks with the most votes, in descending order, the earlier bin first on ties
+     */
+    static void select(std::vector<std::size_t> &peaks, const std::vector<count_type> &acc, std::size_t num) {
+      auto more = [&acc](std::size_t i, std::size_t j) { return acc[i] > acc[j] || (acc[i] == acc[j] && i < j); };
+      if (peaks.size() > num) {
+        std::nth_element(peaks.begin(), peaks.begin() + num, peaks.end(), more);
+        peaks.resize(num);
+      }
+      std::sort(peaks.begin(), peaks.end(), more);
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
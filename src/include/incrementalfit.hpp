@@ -0,0 +1,248 @@
+#ifndef INCREMENTALFIT_HPP
+#define INCREMENTALFIT_HPP
+
+/**
+ * @file incrementalfit.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Streaming line and circle fits with constant time updates, downdates and merges
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "circle.hpp"
+#include "sline.hpp"
+
+namespace ns_geo {
+#pragma region IncrementalFit
+
+  /**
+   * @brief the count, mean and co-moments (the sums of the products of the deviations) of
+   * 'Dim'-dime vectors
+   *
+   * @attention the updates are Welford's, the downdates run them backwards and the merges are
+   * Chan's pairwise formula, all O(1), and none sums raw powers, which would cancel
+   */
+  template <std::size_t Dim>
+  struct CoMoments {
+    using vector_type = std::array<double, Dim>;
+
+    std::size_t num = 0;
+    vector_type mean{};
+    /**
+     * @brief the co-moments, 'comoment[i][j]' for 'i <= j'
+     */
+    std::array<vector_type, Dim> comoment{};
+
+    void add(const vector_type &v) {
+      ++num;
+      vector_type before, after;
+      for (std::size_t i = 0; i != Dim; ++i) {
+        before[i] = v[i] - mean[i];
+        mean[i] += before[i] / num;
+        after[i] = v[i] - mean[i];
+      }
+      this->update(before, after, 1.0);
+    }
+
+    /**
+     * @brief take a vector added before out again
+     */
+    void remove(const vector_type &v) {
+      if (num <= 1) {
+        *this = CoMoments();
+        return;
+      }
+      --num;
+      vector_type before, after;
+      for (std::size_t i = 0; i != Dim; ++i) {
+        after[i] = v[i] - mean[i];
+        mean[i] -= after[i] / num;
+        before[i] = v[i] - mean[i];
+      }
+      this->update(before, after, -1.0);
+    }
+
+    void merge(const CoMoments &other) {
+      if (other.num == 0)
+        return;
+      if (num == 0) {
+        *this = other;
+        return;
+      }
+      std::size_t total = num + other.num;
+      double scale = static_cast<double>(num) * other.num / total;
+      vector_type delta;
+      for (std::size_t i = 0; i != Dim; ++i) {
+        delta[i] = other.mean[i] - mean[i];
+        mean[i] += delta[i] * other.num / total;
+      }
+      for (std::size_t i = 0; i != Dim; ++i)
+        for (std::size_t j = i; j != Dim; ++j)
+          comoment[i][j] += other.comoment[i][j] + delta[i] * delta[j] * scale;
+      num = total;
+    }
+
+    /**
+     * @brief the covariance, the co-moment over the count
+     */
+    [[nodiscard]] inline double covariance(std::size_t i, std::size_t j) const {
+      return num == 0 ? 0.0 : (i <= j ? comoment[i][j] : comoment[j][i]) / num;
+    }
+
+  protected:
+    void update(const vector_type &before, const vector_type &after, double sign) {
+      // 'before' and 'after' are parallel, so the product is symmetric
+      for (std::size_t i = 0; i != Dim; ++i)
+        for (std::size_t j = i; j != Dim; ++j)
+          comoment[i][j] += sign * before[i] * after[j];
+    }
+  };
+
+  /**
+   * @brief the total least squares line of a changing point set
+   *
+   * @attention the points aren't kept, 'remove' must be given a point added before
+   */
+  class IncrementalLineFit {
+  public:
+    using value_type = double;
+    using point_type = Point2<value_type>;
+    using self_type = IncrementalLineFit;
+
+  protected:
+    CoMoments<2> _moments;
+
+  public:
+    inline void add(const point_type &p) { _moments.add({p.x, p.y}); }
+
+    inline void remove(const point_type &p) { _moments.remove({p.x, p.y}); }
+
+    /**
+     * @brief take in the points of another fit
+     */
+    inline void merge(const self_type &other) { _moments.merge(other._moments); }
+
+    inline void clear() { _moments = CoMoments<2>(); }
+
+    [[nodiscard]] inline std::size_t size() const { return _moments.num; }
+
+    [[nodiscard]] inline point_type centroid() const { return point_type(_moments.mean[0], _moments.mean[1]); }
+
+    /**
+     * @brief the current line, at least two distinct points are needed
+     */
+    [[nodiscard]] SLine2 model() const {
+      return SLine2::principal(_moments.mean[0], _moments.mean[1], _moments.covariance(0, 0),
+                               _moments.covariance(0, 1), _moments.covariance(1, 1));
+    }
+  };
+
+  /**
+   * @brief the algebraic circle fits of a changing point set
+   *
+   * @attention the fits need the moments up to the fourth order. they are kept as the
+   * co-moments of '(u, v, u^2 + v^2)' with '(u, v)' the point relative to a reference, which
+   * are second order and so updated the Welford way. the reference is the first point, and
+   * moves to the centroid once the points drift away by more than four standard deviations,
+   * an exact linear map of the co-moments. 'remove' must be given a point added before.
+   */
+  class IncrementalCircleFit {
+  public:
+    using value_type = double;
+    using point_type = Point2<value_type>;
+    using self_type = IncrementalCircleFit;
+
+  protected:
+    CoMoments<3> _moments;
+    point_type _ref;
+
+  public:
+    void add(const point_type &p) {
+      if (_moments.num == 0)
+        _ref = p;
+      _moments.add(this->lift(p));
+      const auto &m = _moments.mean;
+      if (m[0] * m[0] + m[1] * m[1] > 16.0 * (_moments.covariance(0, 0) + _moments.covariance(1, 1)))
+        this->rebase(point_type(_ref.x + m[0], _ref.y + m[1]));
+    }
+
+    inline void remove(const point_type &p) { _moments.remove(this->lift(p)); }
+
+    /**
+     * @brief take in the points of another fit
+     */
+    void merge(const self_type &other) {
+      if (other._moments.num == 0)
+        return;
+      if (_moments.num == 0) {
+        *this = other;
+        return;
+      }
+      self_type moved = other;
+      moved.rebase(_ref);
+      _moments.merge(moved._moments);
+    }
+
+    inline void clear() { _moments = CoMoments<3>(); }
+
+    [[nodiscard]] inline std::size_t size() const { return _moments.num; }
+
+    /**
+     * @brief the moments about the centroid, as 'Circle::moments' gives them for the points
+     */
+    [[nodiscard]] Circle::Moments moments() const {
+      Circle::Moments res;
+      res.num = _moments.num;
+      if (res.num == 0)
+        return res;
+      const auto &m = _moments.mean;
+      const double uu = _moments.covariance(0, 0), uv = _moments.covariance(0, 1), vv = _moments.covariance(1, 1);
+      const double uw = _moments.covariance(0, 2), vw = _moments.covariance(1, 2), ww = _moments.covariance(2, 2);
+      res.mean = point_type(_ref.x + m[0], _ref.y + m[1]);
+      // 'z = x^2 + y^2' about the centroid is 'w - 2 mu x - 2 mv y - mu^2 - mv^2'
+      res.xx = uu, res.yy = vv, res.xy = uv;
+      res.xz = uw - 2.0 * m[0] * uu - 2.0 * m[1] * uv;
+      res.yz = vw - 2.0 * m[0] * uv - 2.0 * m[1] * vv;
+      double varZ = ww - 4.0 * m[0] * uw - 4.0 * m[1] * vw + 4.0 * m[0] * m[0] * uu + 8.0 * m[0] * m[1] * uv + 4.0 * m[1] * m[1] * vv;
+      res.zz = varZ + (uu + vv) * (uu + vv);
+      return res;
+    }
+
+    /**
+     * @brief the current circle by the Taubin fit, at least three points off a line are needed
+     */
+    [[nodiscard]] inline Circle model() const { return Circle::taubin(this->moments()); }
+
+    [[nodiscard]] inline Circle kasa() const { return Circle::kasa(this->moments()); }
+
+    [[nodiscard]] inline Circle pratt() const { return Circle::pratt(this->moments()); }
+
+  protected:
+    inline CoMoments<3>::vector_type lift(const point_type &p) const {
+      double u = p.x - _ref.x, v = p.y - _ref.y;
+      return {u, v, u * u + v * v};
+    }
+
+    /**
+     * @brief move the reference, the map '(u, v, w) -> (u + d, v + e, w + 2du + 2ev + d^2 + e^2)'
+     * for '(d, e)' from the new reference to the old one
+     */
+    void rebase(const point_type &ref) {
+      double d = _ref.x - ref.x, e = _ref.y - ref.y;
+      auto &m = _moments.mean;
+      auto &c = _moments.comoment;
+      m[2] += 2.0 * d * m[0] + 2.0 * e * m[1] + d * d + e * e;
+      m[0] += d, m[1] += e;
+      c[2][2] += 4.0 * d * c[0][2] + 4.0 * e * c[1][2] + 4.0 * d * d * c[0][0] + 8.0 * d * e * c[0][1] + 4.0 * e * e * c[1][1];
+      c[0][2] += 2.0 * d * c[0][0] + 2.0 * e * c[0][1];
+      c[1][2] += 2.0 * d * c[0][1] + 2.0 * e * c[1][1];
+      _ref = ref;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,332 @@
+#ifndef MULTIMODEL_HPP
+#define MULTIMODEL_HPP
+
+/**
+ * @file multimodel.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Extract many models from one point cloud by sequential, locality-guided RANSAC
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "ransac.hpp"
+#include <numeric>
+
+namespace ns_geo {
+#pragma region MultiModelExtractor
+
+  struct MultiModelOptions {
+    /**
+     * @brief the settings of the search for each model, the threshold, confidence, iterations,
+     * preemptive test, local optimization, threads and seed
+     */
+    RansacOptions ransac;
+    /**
+     * @brief the neighbourhood the samples are drawn from and the largest gap inside a model,
+     * zero means twenty times the threshold
+     */
+    double radius = 0.0;
+    /**
+     * @brief the fewest inliers a model must keep, the extraction stops at a smaller one
+     */
+    std::size_t minInliers = 10;
+    std::size_t maxModels = 64;
+    /**
+     * @brief keep only the largest group of inliers connected within 'radius', so collinear
+     * walls apart from each other come out as separate models
+     */
+    bool connected = true;
+  };
+
+  template <typename Model>
+  struct ExtractedModel {
+    Model model;
+    /**
+     * @brief the indices of the inliers in the data, ascending
+     */
+    std::vector<std::size_t> inliers;
+    /**
+     * @brief the truncated quadratic (MSAC) cost of the model over its inliers
+     */
+    double cost = 0.0;
+  };
+
+  /**
+   * @brief find the models in the data one after another, removing the inliers of each
+   *
+   * @attention the data are bucketed into a uniform grid with cells of 'radius' once. a sample
+   * is a random remaining datum and the rest drawn from the remaining data within 'radius' of
+   * it (NAPSAC), which keeps the samples on one structure while there are many of them. the
+   * hypotheses are scored over the remaining data in the rounds of 'Ransac::rounds', the best
+   * one is refined by local optimization, its inliers are split into groups connected in the
+   * grid, and the largest group is refitted and taken out by flags, without rebuilding the grid.
+   * the estimator must work on data with 'x' and 'y', such as 'LineEstimator' and 'CircleEstimator'.
+   */
+  template <typename Estimator>
+  class MultiModelExtractor {
+  public:
+    using estimator_type = Estimator;
+    using data_type = typename Estimator::data_type;
+    using model_type = typename Estimator::model_type;
+    using result_type = ExtractedModel<model_type>;
+    using self_type = MultiModelExtractor<estimator_type>;
+
+  protected:
+    estimator_type _estimator;
+    MultiModelOptions _options;
+
+    /**
+     * @brief the data in cells, the items of a cell are 'items[start[c], start[c + 1])'
+     */
+    struct Grid {
+      double x0 = 0.0, y0 = 0.0, size = 1.0;
+      std::size_t cols = 1, rows = 1;
+      std::vector<std::size_t> start;
+      std::vector<std::size_t> items;
+
+      inline std::size_t col(double x) const {
+        return std::min(cols - 1, static_cast<std::size_t>(std::max(0.0, (x - x0) / size)));
+      }
+
+      inline std::size_t row(double y) const {
+        return std::min(rows - 1, static_cast<std::size_t>(std::max(0.0, (y - y0) / size)));
+      }
+
+      /**
+       * @brief visit the items in the cells around a datum
+       */
+      template <typename Visit>
+      void around(const data_type &d, Visit visit) const {
+        std::size_t c = col(d.x), r = row(d.y);
+        for (std::size_t j = r == 0 ? 0 : r - 1; j <= std::min(r + 1, rows - 1); ++j)
+          for (std::size_t i = c == 0 ? 0 : c - 1; i <= std::min(c + 1, cols - 1); ++i) {
+            std::size_t cell = j * cols + i;
+            for (std::size_t k = start[cell]; k != start[cell + 1]; ++k)
+              visit(items[k]);
+          }
+      }
+    };
+
+  public:
+    explicit MultiModelExtractor(const MultiModelOptions &options = MultiModelOptions(),
+                                 const estimator_type &estimator = estimator_type())
+        : _estimator(estimator), _options(options) {}
+
+    [[nodiscard]] inline const MultiModelOptions &options() const { return _options; }
+
+    /**
+     * @brief extract the models, the ones with more inliers usually come first
+     */
+    std::vector<result_type> run(const std::vector<data_type> &data) const {
+      constexpr std::size_t m = Estimator::SAMPLE_SIZE;
+      const RansacOptions &ro = _options.ransac;
+      const double t2 = ro.threshold * ro.threshold;
+      const double radius = _options.radius > 0.0 ? _options.radius : 20.0 * ro.threshold;
+      const std::size_t minInliers = std::max(_options.minInliers, m);
+      std::vector<result_type> res;
+      std::size_t n = data.size();
+      if (n < minInliers)
+        return res;
+      Grid grid = buildGrid(data, radius);
+      Ransac<Estimator> ransac(ro, _estimator);
+
+      std::vector<char> alive(n, 1);
+      std::vector<std::size_t> remaining(n);
+      std::iota(remaining.begin(), remaining.end(), 0);
+      // a scratch list of neighbours per thread of a round
+      std::vector<std::vector<std::size_t>> local(parallelWorkers(ro.round, ro.threads, Ransac<Estimator>::GRAIN));
+      using Hypothesis = typename Ransac<Estimator>::Hypothesis;
+      std::vector<std::size_t> idx, group;
+      std::vector<char> flags(n, 0);
+      std::uint64_t drawn = 0;
+
+      while (res.size() < _options.maxModels && remaining.size() >= minInliers) {
+        std::optional<model_type> best;
+        double bestCost = std::numeric_limits<double>::infinity();
+        auto score = [&](std::minstd_rand &engine, double bound, std::size_t worker) {
+          std::array<std::size_t, m> sample;
+          if (!this->draw(engine, data, grid, alive, remaining, radius, local[worker], sample))
+            return Hypothesis{};
+          auto fitted = _estimator.fit(data, sample.data(), m);
+          if (!fitted)
+            return Hypothesis{};
+          std::uniform_int_distribution<std::size_t> pick(0, remaining.size() - 1);
+          for (std::size_t k = 0; k != ro.preemptive; ++k)
+            if (_estimator.residual(*fitted, data[remaining[pick(engine)]]) > ro.threshold)
+              return Hypothesis{};
+          double cost = this->cost(*fitted, data, remaining, t2, bound);
+          return cost < bound ? Hypothesis{fitted, cost} : Hypothesis{};
+        };
+        auto improve = [&]() {
+          this->optimize(data, remaining, t2, idx, best, bestCost);
+          this->inliers(*best, data, remaining, idx);
+          return ransac.iterationsFor(static_cast<double>(idx.size()) / remaining.size(), m + ro.preemptive);
+        };
+        // the hypotheses are numbered across the models, so each model draws fresh samples
+        drawn += ransac.rounds(drawn, best, bestCost, score, improve);
+        if (!best)
+          break;
+
+        this->inliers(*best, data, remaining, idx);
+        if (_options.connected)
+          this->largestGroup(data, grid, radius, idx, flags, group), idx.swap(group);
+        if (idx.size() < minInliers)
+          break;
+        // refit to the group and take its inliers out
+        if (auto refit = _estimator.fit(data, idx.data(), idx.size()))
+          best = refit;
+        result_type model{*best, {}, 0.0};
+        for (std::size_t i : idx) {
+          double r = _estimator.residual(model.model, data[i]);
+          if (r <= ro.threshold)
+            model.inliers.push_back(i), model.cost += r * r, alive[i] = 0;
+        }
+        if (model.inliers.size() < minInliers)
+          break;
+        std::sort(model.inliers.begin(), model.inliers.end());
+        res.push_back(std::move(model));
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&alive](std::size_t i) { return !alive[i]; }),
+                        remaining.end());
+      }
+      return res;
+    }
+
+  protected:
+    static Grid buildGrid(const std::vector<data_type> &data, double radius) {
+      Grid grid;
+      double x1 = -std::numeric_limits<double>::infinity(), y1 = x1;
+      grid.x0 = grid.y0 = std::numeric_limits<double>::infinity();
+      for (const auto &d : data) {
+        grid.x0 = std::min<double>(grid.x0, d.x), x1 = std::max<double>(x1, d.x);
+        grid.y0 = std::min<double>(grid.y0, d.y), y1 = std::max<double>(y1, d.y);
+      }
+      // cells no smaller than the radius, and not many more cells than data, along either
+      // axis too, as the area of collinear data is zero
+      grid.size = radius;
+      double cells = std::max(1.0, 4.0 * data.size());
+      if ((x1 - grid.x0) / grid.size * (y1 - grid.y0) / grid.size > cells)
+        grid.size = std::sqrt((x1 - grid.x0) * (y1 - grid.y0) / cells);
+      grid.size = std::max({grid.size, (x1 - grid.x0) / cells, (y1 - grid.y0) / cells});
+      grid.cols = static_cast<std::size_t>((x1 - grid.x0) / grid.size) + 1;
+      grid.rows = static_cast<std::size_t>((y1 - grid.y0) / grid.size) + 1;
+      // counting sort of the data by cell
+      grid.start.assign(grid.cols * grid.rows + 1, 0);
+      std::vector<std::size_t> cell(data.size());
+      for (std::size_t i = 0; i != data.size(); ++i) {
+        cell[i] = grid.row(data[i].y) * grid.cols + grid.col(data[i].x);
+        ++grid.start[cell[i] + 1];
+      }
+      std::partial_sum(grid.start.begin(), grid.start.end(), grid.start.begin());
+      grid.items.resize(data.size());
+      std::vector<std::size_t> fill(grid.start.begin(), grid.start.end() - 1);
+      for (std::size_t i = 0; i != data.size(); ++i)
+        grid.items[fill[cell[i]]++] = i;
+      return grid;
+    }
+
+    static inline bool near(const data_type &a, const data_type &b, double radius) {
+      double dx = a.x - b.x, dy = a.y - b.y;
+      return dx * dx + dy * dy <= radius * radius;
+    }
+
+    /**
+     * @brief a random remaining datum and 'M - 1' distinct remaining data within 'radius' of it
+     */
+    template <std::size_t M>
+    static bool draw(std::minstd_rand &engine, const std::vector<data_type> &data, const Grid &grid,
+                     const std::vector<char> &alive, const std::vector<std::size_t> &remaining, double radius,
+                     std::vector<std::size_t> &local, std::array<std::size_t, M> &sample) {
+      std::size_t seed = remaining[std::uniform_int_distribution<std::size_t>(0, remaining.size() - 1)(engine)];
+      local.clear();
+      grid.around(data[seed], [&](std::size_t i) {
+        if (i != seed && alive[i] && near(data[i], data[seed], radius))
+          local.push_back(i);
+      });
+      if (local.size() < M - 1)
+        return false;
+      sample[0] = seed;
+      // a partial Fisher-Yates shuffle
+      for (std::size_t k = 0; k != M - 1; ++k) {
+        std::size_t j = std::uniform_int_distribution<std::size_t>(k, local.size() - 1)(engine);
+        std::swap(local[k], local[j]);
+        sample[k + 1] = local[k];
+      }
+      return true;
+    }
+
+    double cost(const model_type &model, const std::vector<data_type> &data, const std::vector<std::size_t> &remaining,
+                double t2, double bound) const {
+      double cost = 0.0;
+      for (std::size_t i : remaining) {
+        double r = _estimator.residual(model, data[i]);
+        cost += std::min(r * r, t2);
+        if (cost >= bound)
+          break;
+      }
+      return cost;
+    }
+
+    void inliers(const model_type &model, const std::vector<data_type> &data, const std::vector<std::size_t> &remaining,
+                 std::vector<std::size_t> &idx) const {
+      idx.clear();
+      for (std::size_t i : remaining)
+        if (_estimator.residual(model, data[i]) <= _options.ransac.threshold)
+          idx.push_back(i);
+    }
+
+    /**
+     * @brief refit the model to its remaining inliers while that lowers the cost
+     */
+    void optimize(const std::vector<data_type> &data, const std::vector<std::size_t> &remaining, double t2,
+                  std::vector<std::size_t> &idx, std::optional<model_type> &best, double &bestCost) const {
+      for (std::size_t it = 0; it != _options.ransac.localIterations; ++it) {
+        this->inliers(*best, data, remaining, idx);
+        auto model = _estimator.fit(data, idx.data(), idx.size());
+        if (!model)
+          return;
+        double cost = this->cost(*model, data, remaining, t2, bestCost);
+        if (!(cost < bestCost))
+          return;
+        best = model, bestCost = cost;
+      }
+    }
+
+    /**
+     * @brief the largest group of the inliers linked by gaps within 'radius', a flood fill over the grid
+     *
+     * @param flags all zero, and left all zero
+     */
+    static void largestGroup(const std::vector<data_type> &data, const Grid &grid, double radius,
+                             const std::vector<std::size_t> &idx, std::vector<char> &flags,
+                             std::vector<std::size_t> &group) {
+      // 1 for an inlier not reached yet, 2 for a reached one
+      for (std::size_t i : idx)
+        flags[i] = 1;
+      group.clear();
+      std::vector<std::size_t> current;
+      for (std::size_t s : idx) {
+        if (flags[s] != 1)
+          continue;
+        current.clear();
+        current.push_back(s), flags[s] = 2;
+        for (std::size_t k = 0; k != current.size(); ++k) {
+          std::size_t from = current[k];
+          grid.around(data[from], [&](std::size_t i) {
+            if (flags[i] == 1 && near(data[i], data[from], radius))
+              current.push_back(i), flags[i] = 2;
+          });
+        }
+        if (current.size() > group.size())
+          group.swap(current);
+      }
+      for (std::size_t i : idx)
+        flags[i] = 0;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
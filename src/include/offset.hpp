@@ -0,0 +1,354 @@
+#ifndef OFFSET_HPP
+#define OFFSET_HPP
+
+/**
+ * @file offset.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Offsetting polygons and buffering line strings
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "clipping.hpp"
+#include "linestring.hpp"
+#include "parallel.hpp"
+
+namespace ns_geo {
+#pragma region Offsetter
+
+  enum class JoinType {
+    /**
+     * @brief sharp corners, squared off beyond the miter limit; butt caps for line strings
+     */
+    MITER,
+    /**
+     * @brief circular arcs at the corners and the line ends
+     */
+    ROUND,
+    /**
+     * @brief corners squared off at the offset distance; square caps for line strings
+     */
+    SQUARE
+  };
+
+  /**
+   * @brief offset polygons by a distance and buffer line strings into polygons
+   *
+   * @attention the band along the border is built from small simple pieces, one per edge
+   * together with the join at its end. the pieces are merged by a cascaded union with the
+   * sweep-line clipper, pairing them level by level on several threads, so no quadratic
+   * self-intersection cleanup of a raw offset ring is needed. growing adds the band to the
+   * region and shrinking subtracts the inner band from it.
+   */
+  template <typename Ty = float>
+  class Offsetter {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using linestring_type = LineString2<value_type>;
+    using polygonwithholes_type = PolygonWithHoles<value_type>;
+    using multipolygon_type = MultiPolygon<value_type>;
+    using clipper_type = PolygonClipper<value_type>;
+    using self_type = Offsetter<value_type>;
+
+  protected:
+    using coord_type = std::array<double, 2>;
+
+    struct Options {
+      double delta;
+      JoinType join;
+      double miterLimit;
+      // the angle step of the arcs
+      double step;
+    };
+
+  public:
+    /**
+     * @brief offset a polygon, growing it for a positive 'delta' and shrinking it for a negative one
+     *
+     * @param polygon the polygon
+     * @param delta the offset distance
+     * @param join the join type at the corners
+     * @param miterLimit the max distance of a miter corner from its vertex, in multiples of 'delta'
+     * @param arcTolerance the max deviation of the round arcs, zero means '|delta| / 1000'
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static multipolygon_type offset(const polygon_type &polygon, double delta, JoinType join = JoinType::MITER,
+                                    double miterLimit = 2.0, double arcTolerance = 0.0, std::size_t threads = 0) {
+      return offset(multipolygon_type{polygonwithholes_type(polygon)}, delta, join, miterLimit, arcTolerance, threads);
+    }
+
+    static multipolygon_type offset(const polygonwithholes_type &polygon, double delta, JoinType join = JoinType::MITER,
+                                    double miterLimit = 2.0, double arcTolerance = 0.0, std::size_t threads = 0) {
+      return offset(multipolygon_type{polygon}, delta, join, miterLimit, arcTolerance, threads);
+    }
+
+    static multipolygon_type offset(const multipolygon_type &region, double delta, JoinType join = JoinType::MITER,
+                                    double miterLimit = 2.0, double arcTolerance = 0.0, std::size_t threads = 0) {
+      // normalize the region, which fixes the winding as well
+      auto base = clipper_type::compute(clipper_type::rings(region), {}, BoolOp::UNION);
+      if (delta == 0.0 || base.empty())
+        return base;
+      Options opt = options(delta, join, miterLimit, arcTolerance);
+      std::vector<polygon_type> pieces;
+      for (const auto &poly : base) {
+        // the region lies on the left of its rings, the band goes to their right side
+        ringPieces(poly.outer, delta > 0.0, opt, pieces);
+        for (const auto &hole : poly.holes)
+          ringPieces(hole, delta > 0.0, opt, pieces);
+      }
+      auto band = cascade(pieces, threads);
+      return clipper_type::compute(base, band, delta > 0.0 ? BoolOp::UNION : BoolOp::DIFFERENCE);
+    }
+
+    /**
+     * @brief buffer a line string into the polygons within 'distance' of it
+     *
+     * @attention the caps follow the join type: butt for 'MITER', round for 'ROUND' and square for 'SQUARE'
+     */
+    static multipolygon_type buffer(const linestring_type &ls, double distance, JoinType join = JoinType::ROUND,
+                                    double miterLimit = 2.0, double arcTolerance = 0.0, std::size_t threads = 0) {
+      return buffer(std::vector<linestring_type>{ls}, distance, join, miterLimit, arcTolerance, threads);
+    }
+
+    /**
+     * @brief buffer several line strings into the union of their buffers
+     */
+    static multipolygon_type buffer(const std::vector<linestring_type> &lines, double distance,
+                                    JoinType join = JoinType::ROUND, double miterLimit = 2.0,
+                                    double arcTolerance = 0.0, std::size_t threads = 0) {
+      if (!(distance > 0.0))
+        return multipolygon_type();
+      Options opt = options(distance, join, miterLimit, arcTolerance);
+      std::vector<polygon_type> pieces;
+      for (const auto &ls : lines)
+        linePieces(ls, opt, pieces);
+      return cascade(pieces, threads);
+    }
+
+    /**
+     * @brief the union of many polygons, merged pairwise level by level
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static multipolygon_type cascade(const std::vector<polygon_type> &polygons, std::size_t threads = 0) {
+      std::vector<multipolygon_type> level;
+      // the first level unites the pairs of single rings directly
+      level.resize((polygons.size() + 1) / 2);
+      parallelFor(
+          0, level.size(), [&](std::size_t i, std::size_t) {
+            std::vector<polygon_type> b;
+            if (2 * i + 1 < polygons.size())
+              b.push_back(polygons[2 * i + 1]);
+            level[i] = clipper_type::compute({polygons[2 * i]}, b, BoolOp::UNION);
+          },
+          threads, 64);
+      while (level.size() > 1) {
+        std::vector<multipolygon_type> next((level.size() + 1) / 2);
+        parallelFor(
+            0, next.size(), [&](std::size_t i, std::size_t) {
+              if (2 * i + 1 < level.size())
+                next[i] = clipper_type::compute(level[2 * i], level[2 * i + 1], BoolOp::UNION);
+              else
+                next[i] = std::move(level[2 * i]);
+            },
+            threads, 1);
+        level.swap(next);
+      }
+      return level.empty() ? multipolygon_type() : std::move(level.front());
+    }
+
+  protected:
+    static Options options(double delta, JoinType join, double miterLimit, double arcTolerance) {
+      double d = std::abs(delta);
+      double tol = arcTolerance > 0.0 ? std::min(arcTolerance, d) : d * 1E-3;
+      // the chord of an arc step deviates by 'd * (1 - cos(step / 2))'
+      double step = 2.0 * std::acos(1.0 - tol / d);
+      return Options{d, join, std::max(miterLimit, 1.0), std::max(step, 1E-3)};
+    }
+
+    static inline coord_type coord(const point_type &p) {
+      return {static_cast<double>(p.x), static_cast<double>(p.y)};
+    }
+
+    static inline point_type toPoint(double x, double y) {
+      return point_type(static_cast<value_type>(x), static_cast<value_type>(y));
+    }
+
+    /**
+     * @brief the unit direction of 'ab' and its right normal
+     */
+    static inline bool direction(const coord_type &a, const coord_type &b, coord_type &t, coord_type &n) {
+      double dx = b[0] - a[0], dy = b[1] - a[1], len = std::sqrt(dx * dx + dy * dy);
+      if (len == 0.0)
+        return false;
+      t = {dx / len, dy / len}, n = {t[1], -t[0]};
+      return true;
+    }
+
+    /**
+     * @brief the points of the join on the right side of a left turn at 'v', from the incoming
+     * edge side to the outgoing one
+     */
+    static void joinPoints(const coord_type &v, const coord_type &t1, const coord_type &t2, const Options &opt,
+                           std::vector<coord_type> &out) {
+      double d = opt.delta;
+      coord_type n1{t1[1], -t1[0]}, n2{t2[1], -t2[0]};
+      double turn = std::atan2(t1[0] * t2[1] - t1[1] * t2[0], t1[0] * t2[0] + t1[1] * t2[1]);
+      out.push_back({v[0] + d * n1[0], v[1] + d * n1[1]});
+      if (opt.join == JoinType::ROUND) {
+        auto steps = static_cast<int>(std::ceil(turn / opt.step));
+        double a0 = std::atan2(n1[1], n1[0]);
+        for (int k = 1; k < steps; ++k) {
+          double a = a0 + turn * k / steps;
+          out.push_back({v[0] + d * std::cos(a), v[1] + d * std::sin(a)});
+        }
+      } else if (turn > 1E-12) {
+        // the bisector, and how far the corner reaches along it
+        double bx = n1[0] + n2[0], by = n1[1] + n2[1], bl = std::sqrt(bx * bx + by * by);
+        if (bl < 1E-12)
+          bx = t1[0], by = t1[1];
+        else
+          bx /= bl, by /= bl;
+        double cosHalf = n1[0] * bx + n1[1] * by, sinHalf = t1[0] * bx + t1[1] * by;
+        double reach = opt.join == JoinType::SQUARE ? d : std::min(opt.miterLimit * d, cosHalf > 0.0 ? d / cosHalf : std::numeric_limits<double>::infinity());
+        if (opt.join == JoinType::MITER && cosHalf > 0.0 && d / cosHalf <= opt.miterLimit * d) {
+          out.push_back({v[0] + reach * bx, v[1] + reach * by});
+        } else {
+          // cut the corner square to the bisector at the reach
+          double s = (reach - d * cosHalf) / sinHalf;
+          out.push_back({v[0] + d * n1[0] + s * t1[0], v[1] + d * n1[1] + s * t1[1]});
+          out.push_back({v[0] + d * n2[0] - s * t2[0], v[1] + d * n2[1] - s * t2[1]});
+        }
+      }
+      out.push_back({v[0] + d * n2[0], v[1] + d * n2[1]});
+    }
+
+    static std::vector<coord_type> cleanRing(const polygon_type &ring) {
+      std::vector<coord_type> pts;
+      for (const auto &p : ring)
+        if (pts.empty() || coord(p) != pts.back())
+          pts.push_back(coord(p));
+      while (pts.size() > 1 && pts.front() == pts.back())
+        pts.pop_back();
+      return pts;
+    }
+
+    /**
+     * @brief the pieces of the band on the right side of a ring, or on its left side if '!outside'
+     */
+    static void ringPieces(const polygon_type &ring, bool outside, const Options &opt, std::vector<polygon_type> &pieces) {
+      auto pts = cleanRing(ring);
+      if (!outside)
+        std::reverse(pts.begin(), pts.end());
+      std::size_t n = pts.size();
+      if (n < 3)
+        return;
+      std::vector<coord_type> join;
+      for (std::size_t i = 0; i != n; ++i) {
+        const auto &a = pts[i], &b = pts[(i + 1) % n], &c = pts[(i + 2) % n];
+        coord_type t1{}, n1{}, t2{}, n2{};
+        direction(a, b, t1, n1), direction(b, c, t2, n2);
+        double d = opt.delta;
+        // the strip along the edge, then the join at its end on a left turn
+        polygon_type piece{toPoint(a[0], a[1]), toPoint(b[0], b[1])};
+        if (t1[0] * t2[1] - t1[1] * t2[0] > 0.0) {
+          join.clear();
+          joinPoints(b, t1, t2, opt, join);
+          for (auto iter = join.crbegin(); iter != join.crend(); ++iter)
+            piece.push_back(toPoint((*iter)[0], (*iter)[1]));
+        } else
+          piece.push_back(toPoint(b[0] + d * n1[0], b[1] + d * n1[1]));
+        piece.push_back(toPoint(a[0] + d * n1[0], a[1] + d * n1[1]));
+        pieces.push_back(std::move(piece));
+      }
+    }
+
+    /**
+     * @brief the pieces of the buffer of a line string
+     */
+    static void linePieces(const linestring_type &ls, const Options &opt, std::vector<polygon_type> &pieces) {
+      std::vector<coord_type> pts;
+      for (const auto &p : ls)
+        if (pts.empty() || coord(p) != pts.back())
+          pts.push_back(coord(p));
+      double d = opt.delta;
+      if (pts.size() == 1) {
+        // a single point becomes a disc or a square
+        if (opt.join != JoinType::MITER)
+          pieces.push_back(cap(pts[0], {1.0, 0.0}, opt, true));
+        return;
+      }
+      std::vector<coord_type> join;
+      for (std::size_t i = 0; i + 1 < pts.size(); ++i) {
+        const auto &a = pts[i], &b = pts[i + 1];
+        coord_type t1{}, n1{};
+        direction(a, b, t1, n1);
+        polygon_type piece{toPoint(a[0] - d * n1[0], a[1] - d * n1[1]), toPoint(b[0] - d * n1[0], b[1] - d * n1[1])};
+        if (i + 2 < pts.size()) {
+          coord_type t2{}, n2{};
+          direction(b, pts[i + 2], t2, n2);
+          double cross = t1[0] * t2[1] - t1[1] * t2[0];
+          join.clear();
+          if (cross < 0.0) {
+            // a right turn opens on the left, mirror it into a left turn
+            joinPoints(b, {-t2[0], -t2[1]}, {-t1[0], -t1[1]}, opt, join);
+            for (auto iter = join.crbegin(); iter != join.crend(); ++iter)
+              piece.push_back(toPoint((*iter)[0], (*iter)[1]));
+            piece.push_back(toPoint(b[0], b[1]));
+            piece.push_back(toPoint(b[0] + d * n1[0], b[1] + d * n1[1]));
+          } else if (cross > 0.0) {
+            piece.push_back(toPoint(b[0], b[1]));
+            joinPoints(b, t1, t2, opt, join);
+            for (auto iter = join.crbegin(); iter != join.crend(); ++iter)
+              piece.push_back(toPoint((*iter)[0], (*iter)[1]));
+          } else
+            piece.push_back(toPoint(b[0] + d * n1[0], b[1] + d * n1[1]));
+        } else
+          piece.push_back(toPoint(b[0] + d * n1[0], b[1] + d * n1[1]));
+        piece.push_back(toPoint(a[0] + d * n1[0], a[1] + d * n1[1]));
+        pieces.push_back(std::move(piece));
+      }
+      if (opt.join != JoinType::MITER) {
+        coord_type t{}, n{};
+        direction(pts[0], pts[1], t, n);
+        pieces.push_back(cap(pts.front(), {-t[0], -t[1]}, opt, false));
+        direction(pts[pts.size() - 2], pts.back(), t, n);
+        pieces.push_back(cap(pts.back(), t, opt, false));
+      }
+    }
+
+    /**
+     * @brief the cap at a line end facing 't', a whole disc or square if 'full'
+     */
+    static polygon_type cap(const coord_type &v, const coord_type &t, const Options &opt, bool full) {
+      double d = opt.delta;
+      polygon_type res;
+      // from the left of 't' around its front to its right
+      coord_type l{-t[1], t[0]};
+      if (opt.join == JoinType::ROUND) {
+        double sweep = full ? 2.0 * M_PI : M_PI;
+        auto steps = static_cast<int>(std::ceil(sweep / opt.step));
+        double a0 = std::atan2(l[1], l[0]);
+        for (int k = 0; k <= steps - (full ? 1 : 0); ++k) {
+          double a = a0 - sweep * k / steps;
+          res.push_back(toPoint(v[0] + d * std::cos(a), v[1] + d * std::sin(a)));
+        }
+      } else {
+        double back = full ? d : 0.0;
+        res.push_back(toPoint(v[0] + d * l[0] - back * t[0], v[1] + d * l[1] - back * t[1]));
+        res.push_back(toPoint(v[0] + d * l[0] + d * t[0], v[1] + d * l[1] + d * t[1]));
+        res.push_back(toPoint(v[0] - d * l[0] + d * t[0], v[1] - d * l[1] + d * t[1]));
+        res.push_back(toPoint(v[0] - d * l[0] - back * t[0], v[1] - d * l[1] - back * t[1]));
+      }
+      return res;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
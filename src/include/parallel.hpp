@@ -0,0 +1,109 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+/**
+ * @file parallel.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Provide the thread helpers used by the batch algorithms
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns_geo {
+#pragma region parallel
+  /**
+   * @brief the number of worker threads to use by default
+   *
+   * @return std::size_t at least one
+   */
+  static std::size_t hardwareThreads() {
+    auto num = std::thread::hardware_concurrency();
+    return num == 0 ? 1 : num;
+  }
+
+  /**
+   * @brief run 'task(idx, worker)' for every idx in [begin, end) on several threads
+   *
+   * @tparam Task the callable type, invoked as task(std::size_t idx, std::size_t worker)
+   * @param begin the first index
+   * @param end the index after the last one
+   * @param task the task to run
+   * @param workers the number of threads, zero means 'hardwareThreads()'
+   * @param grain the number of indices a worker claims at a time
+   * @attention indices are handed out from a shared counter, so uneven tasks balance themselves.
+   * the 'worker' argument lies in [0, workers) and can be used to pick a per-thread buffer.
+   * the first exception thrown by a task is rethrown in the calling thread.
+   */
+  template <typename Task>
+  void parallelFor(std::size_t begin, std::size_t end, Task task,
+                   std::size_t workers = 0, std::size_t grain = 1) {
+    if (begin >= end)
+      return;
+    if (workers == 0)
+      workers = hardwareThreads();
+    grain = std::max<std::size_t>(grain, 1);
+    workers = std::min(workers, (end - begin + grain - 1) / grain);
+    if (workers <= 1) {
+      for (std::size_t i = begin; i != end; ++i)
+        task(i, 0);
+      return;
+    }
+    std::atomic<std::size_t> next(begin);
+    std::exception_ptr error = nullptr;
+    std::mutex errorMutex;
+    auto work = [&](std::size_t worker) {
+      try {
+        for (;;) {
+          std::size_t from = next.fetch_add(grain);
+          if (from >= end)
+            break;
+          std::size_t to = std::min(from + grain, end);
+          for (std::size_t i = from; i != to; ++i)
+            task(i, worker);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (error == nullptr)
+          error = std::current_exception();
+        // stop the other workers as soon as possible
+        next.store(end);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t w = 1; w != workers; ++w)
+      threads.emplace_back(work, w);
+    work(0);
+    for (auto &t : threads)
+      t.join();
+    if (error != nullptr)
+      std::rethrow_exception(error);
+  }
+
+  /**
+   * @brief the number of workers 'parallelFor' will start for the range and settings
+   *
+   * @attention use it to size per-thread buffers before calling 'parallelFor'
+   */
+  static std::size_t parallelWorkers(std::size_t count, std::size_t workers = 0,
+                                     std::size_t grain = 1) {
+    if (count == 0)
+      return 1;
+    if (workers == 0)
+      workers = hardwareThreads();
+    grain = std::max<std::size_t>(grain, 1);
+    return std::max<std::size_t>(1, std::min(workers, (count + grain - 1) / grain));
+  }
+#pragma endregion
+} // namespace ns_geo
+
+#endif
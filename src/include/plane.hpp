@@ -0,0 +1,140 @@
+#ifndef PLANE_HPP
+#define PLANE_HPP
+
+/**
+ * @file plane.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Planes in 3-dime space
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "eigen3/Eigen/Dense"
+#include "point.hpp"
+
+namespace ns_geo {
+  class Plane : protected Geometry {
+  public:
+    using value_type = double;
+    using point_type = Point3<value_type>;
+    using self_type = Plane;
+    using pointset_type = PointSet3<value_type>;
+
+  public:
+    /**
+     * @brief the members, 'ax + by + cz + d = 0' with a unit normal '(a, b, c)'
+     */
+    value_type a;
+    value_type b;
+    value_type c;
+    value_type d;
+
+  public:
+    /**
+     * @brief construct a new self_type object
+     */
+    Plane(const value_type &a, const value_type &b, const value_type &c, const value_type &d) {
+      // normalize
+      value_type norm = std::sqrt(a * a + b * b + c * c);
+      this->a = a / norm;
+      this->b = b / norm;
+      this->c = c / norm;
+      this->d = d / norm;
+    }
+
+    // the plane through a point with the normal
+    Plane(const point_type &p, const value_type &nx, const value_type &ny, const value_type &nz)
+        : Plane(nx, ny, nz, -(nx * p.x + ny * p.y + nz * p.z)) {}
+
+    // the plane through three points, the normal is the cross product of two edges
+    Plane(const point_type &p1, const point_type &p2, const point_type &p3)
+        : Plane(p1,
+                (p2.y - p1.y) * (p3.z - p1.z) - (p2.z - p1.z) * (p3.y - p1.y),
+                (p2.z - p1.z) * (p3.x - p1.x) - (p2.x - p1.x) * (p3.z - p1.z),
+                (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x)) {}
+
+    /**
+     * @brief the orthogonal (total least squares) plane fit
+     *
+     * @attention the plane runs through the centroid, its normal is the eigenvector of the
+     * smallest eigenvalue of the scatter matrix, summed in one pass and solved in closed form
+     */
+    static self_type fit(const pointset_type &pts) {
+      return fit(pts, std::vector<value_type>(pts.size(), 1.0));
+    }
+
+    /**
+     * @brief the weighted orthogonal plane fit
+     *
+     * @param weights the non-negative weight of each point
+     * @attention an empty set gives a plane of NaNs
+     */
+    static self_type fit(const pointset_type &pts, const std::vector<value_type> &weights) {
+      if (pts.empty()) {
+        const value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+        return self_type(nan, nan, nan, nan);
+      }
+      // the sums are taken relative to the first point against the cancellation
+      const auto &o = pts.front();
+      value_type sw = 0.0, sx = 0.0, sy = 0.0, sz = 0.0;
+      value_type sxx = 0.0, sxy = 0.0, sxz = 0.0, syy = 0.0, syz = 0.0, szz = 0.0;
+      for (std::size_t i = 0; i != pts.size(); ++i) {
+        value_type w = weights[i], x = pts[i].x - o.x, y = pts[i].y - o.y, z = pts[i].z - o.z;
+        sw += w, sx += w * x, sy += w * y, sz += w * z;
+        sxx += w * x * x, sxy += w * x * y, sxz += w * x * z, syy += w * y * y, syz += w * y * z, szz += w * z * z;
+      }
+      value_type mx = sx / sw, my = sy / sw, mz = sz / sw;
+      return principal(point_type(mx + o.x, my + o.y, mz + o.z),
+                       sxx / sw - mx * mx, sxy / sw - mx * my, sxz / sw - mx * mz,
+                       syy / sw - my * my, syz / sw - my * mz, szz / sw - mz * mz);
+    }
+
+    /**
+     * @brief the plane through a centroid across the minor axis of a scatter matrix
+     *
+     * @attention the normal is the eigenvector of the smallest eigenvalue, solved in closed form
+     */
+    static self_type principal(const point_type &centroid, value_type sxx, value_type sxy, value_type sxz,
+                               value_type syy, value_type syz, value_type szz) {
+      Eigen::Matrix3d cov;
+      cov << sxx, sxy, sxz, sxy, syy, syz, sxz, syz, szz;
+      Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+      solver.computeDirect(cov);
+      // the eigenvalues come in increasing order
+      Eigen::Vector3d n = solver.eigenvectors().col(0);
+      return self_type(centroid, n(0), n(1), n(2));
+    }
+
+    // the signed distance, positive on the side the normal points to
+    value_type signedDistance(const point_type &p) const {
+      return a * p.x + b * p.y + c * p.z + d;
+    }
+
+    // the distance from the point to the plane
+    value_type distance(const point_type &p) const {
+      return std::abs(this->signedDistance(p));
+    }
+
+    // the foot of the perpendicular from the point
+    point_type nearest(const point_type &p) const {
+      value_type s = this->signedDistance(p);
+      return point_type(p.x - s * a, p.y - s * b, p.z - s * c);
+    }
+
+    [[nodiscard]] inline ns_geo::GeoType type() const override {
+      return GeoType::PLANE;
+    }
+  };
+  /**
+   * @brief override operator '<<' for type 'Plane'
+   */
+  std::ostream &operator<<(std::ostream &os, const Plane &pl) {
+    os << '[' << pl.a << ", " << pl.b << ", " << pl.c << ", " << pl.d << ']';
+    return os;
+  }
+
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,389 @@
+#ifndef PLANESEGMENT_HPP
+#define PLANESEGMENT_HPP
+
+/**
+ * @file planesegment.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Segment planes out of 3-dime scans, by RANSAC or by growing regions of similar normals
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "ransac.hpp"
+#include <numeric>
+
+namespace ns_geo {
+#pragma region PlaneSegmenter
+
+  struct RegionGrowingOptions {
+    /**
+     * @brief the radius of the neighbourhood of a voxel, for its normal and its growth, the
+     * voxels being half as wide
+     */
+    double radius = 0.1;
+    /**
+     * @brief the largest angle between the normals of neighbouring voxels in one region, in radians
+     */
+    double angle = 5.0 * M_PI / 180.0;
+    /**
+     * @brief the voxels flatter than this seed and keep growing a region, the others only join
+     * it, with all their points
+     */
+    double curvature = 0.02;
+    /**
+     * @brief the regions of fewer points are dropped, their points left unlabelled
+     */
+    std::size_t minSize = 50;
+    /**
+     * @brief the number of threads for the normals, zero means all hardware threads
+     */
+    std::size_t threads = 0;
+  };
+
+  /**
+   * @brief the unit normal of a point and the curvature of its neighbourhood, 'λ0 / (λ0 + λ1 + λ2)'
+   * for the eigenvalues of its scatter matrix, zero for a flat one and 1/3 for an isotropic one.
+   * the points of a voxel share the normal of the voxel's neighbourhood
+   */
+  struct PointNormal {
+    double nx = 0.0, ny = 0.0, nz = 0.0;
+    double curvature = 1.0;
+  };
+
+  struct PlaneSegments {
+    /**
+     * @brief the region of each point, -1 for none
+     */
+    std::vector<int> labels;
+    /**
+     * @brief the point indices of each region, ascending
+     */
+    std::vector<std::vector<std::size_t>> regions;
+    /**
+     * @brief the total least squares plane of each region
+     */
+    std::vector<Plane> planes;
+  };
+
+  /**
+   * @brief segment the planes of a scan
+   *
+   * @attention 'ransac' finds the dominant plane, such as the ground, with the adaptive
+   * termination of 'Ransac'. 'segment' grows regions instead: the points are hashed into
+   * voxels of half the radius in one pass, which sums the moments of each voxel. the
+   * neighbourhood of a voxel is the voxels with their centres within the radius of its own,
+   * 33 of them, and all the points of a voxel share the normal of that neighbourhood, its minor
+   * axis solved in closed form, so a scan costs O(n) for the hashing and the rest depends on
+   * the voxels alone. the normals are estimated in parallel. the regions then grow from the
+   * flattest voxels over neighbours whose normals differ by less than the angle, and only the
+   * voxels flatter than the curvature threshold seed them or keep growing them. a voxel is
+   * labelled as a whole, so the points of a voxel across a corner or an edge all take the label
+   * of the first region to reach it, whichever plane they lie on.
+   */
+  template <typename Ty = float>
+  class PlaneSegmenter {
+  public:
+    using value_type = Ty;
+    using point_type = Point3<value_type>;
+    using pointset_type = PointSet3<value_type>;
+    using self_type = PlaneSegmenter<value_type>;
+
+  protected:
+    RegionGrowingOptions _options;
+
+    /**
+     * @brief the number and the sums of the coordinates and their products of some points,
+     * relative to a voxel centre and in units of the voxel size
+     */
+    struct Moments {
+      double num = 0.0;
+      double sx = 0.0, sy = 0.0, sz = 0.0;
+      double sxx = 0.0, sxy = 0.0, sxz = 0.0, syy = 0.0, syz = 0.0, szz = 0.0;
+
+      inline void add(double x, double y, double z) {
+        num += 1.0, sx += x, sy += y, sz += z;
+        sxx += x * x, sxy += x * y, sxz += x * z, syy += y * y, syz += y * z, szz += z * z;
+      }
+
+      /**
+       * @brief take in the moments about a centre 'ox, oy, oz' voxels away from this one
+       */
+      inline void merge(const Moments &o, double ox, double oy, double oz) {
+        sxx += o.sxx + 2.0 * ox * o.sx + o.num * ox * ox;
+        sxy += o.sxy + ox * o.sy + oy * o.sx + o.num * ox * oy;
+        sxz += o.sxz + ox * o.sz + oz * o.sx + o.num * ox * oz;
+        syy += o.syy + 2.0 * oy * o.sy + o.num * oy * oy;
+        syz += o.syz + oy * o.sz + oz * o.sy + o.num * oy * oz;
+        szz += o.szz + 2.0 * oz * o.sz + o.num * oz * oz;
+        sx += o.sx + o.num * ox, sy += o.sy + o.num * oy, sz += o.sz + o.num * oz;
+        num += o.num;
+      }
+    };
+
+    /**
+     * @brief the voxels of the points, 'keys[v]' and 'moments[v]' for the voxel 'v' and
+     * 'voxelOf[i]' for the point 'i', with an open addressing table from the keys to the voxels,
+     * each slot a key and its voxel side by side, hashed by the top bits of a product
+     */
+    struct VoxelGrid {
+      static constexpr std::uint64_t EMPTY = ~std::uint64_t(0);
+      static constexpr std::int64_t CELLS = std::int64_t(1) << 21;
+
+      double x0 = 0.0, y0 = 0.0, z0 = 0.0, size = 1.0;
+      std::vector<std::uint64_t> keys;
+      std::vector<Moments> moments;
+      std::vector<std::size_t> voxelOf;
+      std::vector<std::pair<std::uint64_t, std::size_t>> slots;
+      int shift = 64;
+
+      inline std::uint64_t key(std::int64_t ix, std::int64_t iy, std::int64_t iz) const {
+        return (static_cast<std::uint64_t>(ix) << 42) | (static_cast<std::uint64_t>(iy) << 21) | static_cast<std::uint64_t>(iz);
+      }
+
+      inline std::size_t slot(std::uint64_t k) const {
+        return static_cast<std::size_t>((k * 0x9E3779B97F4A7C15ULL) >> shift);
+      }
+
+      /**
+       * @brief the voxel of a key, 'keys.size()' for none
+       */
+      std::size_t find(std::uint64_t k) const {
+        for (std::size_t s = this->slot(k);; s = (s + 1) & (slots.size() - 1)) {
+          if (slots[s].first == k)
+            return slots[s].second;
+          if (slots[s].first == EMPTY)
+            return keys.size();
+        }
+      }
+
+      /**
+       * @brief the voxel of a key, added if new, the table kept at most half full
+       */
+      inline std::size_t insert(std::uint64_t k) {
+        std::size_t s = this->slot(k);
+        for (; slots[s].first != EMPTY; s = (s + 1) & (slots.size() - 1))
+          if (slots[s].first == k)
+            return slots[s].second;
+        slots[s] = {k, keys.size()};
+        keys.push_back(k), moments.emplace_back();
+        if (2 * keys.size() > slots.size())
+          this->rehash(2 * slots.size());
+        return keys.size() - 1;
+      }
+
+      void rehash(std::size_t capacity) {
+        slots.assign(capacity, {EMPTY, 0});
+        shift = 64;
+        while ((std::size_t(1) << (64 - shift)) < capacity)
+          --shift;
+        for (std::size_t v = 0; v != keys.size(); ++v) {
+          std::size_t s = this->slot(keys[v]);
+          while (slots[s].first != EMPTY)
+            s = (s + 1) & (slots.size() - 1);
+          slots[s] = {keys[v], v};
+        }
+      }
+
+      /**
+       * @brief visit the voxels 'u' with their centres within two cells of the one of 'v', as
+       * 'visit(u, i, j, l)' with the offset of 'u' from 'v' in voxels
+       */
+      template <typename Visit>
+      void around(std::size_t v, Visit visit) const {
+        // the offsets of the 33 voxels, built once
+        static const std::vector<std::array<std::int64_t, 3>> offsets = [] {
+          std::vector<std::array<std::int64_t, 3>> res;
+          for (std::int64_t i = -2; i <= 2; ++i)
+            for (std::int64_t j = -2; j <= 2; ++j)
+              for (std::int64_t l = -2; l <= 2; ++l)
+                if (i * i + j * j + l * l <= 4)
+                  res.push_back({i, j, l});
+          return res;
+        }();
+        const std::uint64_t k = keys[v], mask = CELLS - 1;
+        const auto ix = static_cast<std::int64_t>(k >> 42), iy = static_cast<std::int64_t>((k >> 21) & mask),
+                   iz = static_cast<std::int64_t>(k & mask);
+        for (const auto &[i, j, l] : offsets) {
+          if (ix + i < 0 || iy + j < 0 || iz + l < 0 || ix + i >= CELLS || iy + j >= CELLS || iz + l >= CELLS)
+            continue;
+          std::size_t u = this->find(this->key(ix + i, iy + j, iz + l));
+          if (u != keys.size())
+            visit(u, static_cast<double>(i), static_cast<double>(j), static_cast<double>(l));
+        }
+      }
+    };
+
+  public:
+    explicit PlaneSegmenter(const RegionGrowingOptions &options = RegionGrowingOptions()) : _options(options) {}
+
+    [[nodiscard]] inline const RegionGrowingOptions &options() const { return _options; }
+
+    /**
+     * @brief the plane with the most support in the scan
+     */
+    static RansacResult<Plane> ransac(const pointset_type &points, const RansacOptions &options = RansacOptions()) {
+      std::vector<Point3<double>> data(points.size());
+      for (std::size_t i = 0; i != points.size(); ++i)
+        data[i] = Point3<double>(points[i].x, points[i].y, points[i].z);
+      return Ransac<PlaneEstimator>(options).run(data);
+    }
+
+    /**
+     * @brief the normal of every point, the one of its voxel
+     */
+    std::vector<PointNormal> normals(const pointset_type &points) const {
+      VoxelGrid grid = buildGrid(points, 0.5 * _options.radius);
+      std::vector<PointNormal> voxels = this->voxelNormals(grid), res(points.size());
+      parallelFor(
+          0, points.size(), [&](std::size_t i, std::size_t) { res[i] = voxels[grid.voxelOf[i]]; }, _options.threads, 4096);
+      return res;
+    }
+
+    /**
+     * @brief grow the planar regions
+     */
+    PlaneSegments segment(const pointset_type &points) const {
+      PlaneSegments res;
+      std::size_t n = points.size();
+      res.labels.assign(n, -1);
+      if (n == 0)
+        return res;
+      VoxelGrid grid = buildGrid(points, 0.5 * _options.radius);
+      std::vector<PointNormal> normals = this->voxelNormals(grid);
+      const std::size_t voxels = grid.keys.size();
+      std::vector<int> labels(voxels, -1);
+      const double cosAngle = std::cos(_options.angle);
+
+      std::vector<std::size_t> order(voxels);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&normals](std::size_t i, std::size_t j) {
+        return normals[i].curvature < normals[j].curvature || (normals[i].curvature == normals[j].curvature && i < j);
+      });
+      // the voxels of a dropped region are marked -2 so they don't seed again
+      std::vector<std::size_t> region, seeds, sizes;
+      for (std::size_t s : order) {
+        // the rest are too curved to seed, such as the voxels across a corner
+        if (normals[s].curvature >= _options.curvature)
+          break;
+        if (labels[s] != -1)
+          continue;
+        int label = static_cast<int>(res.planes.size());
+        region.assign(1, s), seeds.assign(1, s);
+        labels[s] = label;
+        while (!seeds.empty()) {
+          std::size_t cur = seeds.back();
+          seeds.pop_back();
+          const auto &nc = normals[cur];
+          grid.around(cur, [&](std::size_t u, double, double, double) {
+            const auto &nu = normals[u];
+            if (labels[u] != -1 || std::abs(nc.nx * nu.nx + nc.ny * nu.ny + nc.nz * nu.nz) < cosAngle)
+              return;
+            labels[u] = label;
+            region.push_back(u);
+            if (nu.curvature < _options.curvature)
+              seeds.push_back(u);
+          });
+        }
+        // the plane from the moments of the voxels about the centre of the first one
+        Moments m;
+        auto index = [&grid](std::size_t v, int axis) {
+          return static_cast<double>((grid.keys[v] >> (42 - 21 * axis)) & (VoxelGrid::CELLS - 1));
+        };
+        for (std::size_t v : region)
+          m.merge(grid.moments[v], index(v, 0) - index(s, 0), index(v, 1) - index(s, 1), index(v, 2) - index(s, 2));
+        if (m.num < static_cast<double>(std::max<std::size_t>(_options.minSize, 3))) {
+          for (std::size_t v : region)
+            labels[v] = -2;
+          continue;
+        }
+        const double size = grid.size, sq = size * size;
+        double mx = m.sx / m.num, my = m.sy / m.num, mz = m.sz / m.num;
+        Point3<double> centroid(grid.x0 + (index(s, 0) + 0.5 + mx) * size, grid.y0 + (index(s, 1) + 0.5 + my) * size,
+                                grid.z0 + (index(s, 2) + 0.5 + mz) * size);
+        res.planes.push_back(Plane::principal(centroid, (m.sxx / m.num - mx * mx) * sq, (m.sxy / m.num - mx * my) * sq,
+                                              (m.sxz / m.num - mx * mz) * sq, (m.syy / m.num - my * my) * sq,
+                                              (m.syz / m.num - my * mz) * sq, (m.szz / m.num - mz * mz) * sq));
+        sizes.push_back(static_cast<std::size_t>(m.num));
+      }
+      // the points take the labels of their voxels, in ascending order
+      res.regions.resize(res.planes.size());
+      for (std::size_t r = 0; r != sizes.size(); ++r)
+        res.regions[r].reserve(sizes[r]);
+      for (std::size_t i = 0; i != n; ++i) {
+        int label = labels[grid.voxelOf[i]];
+        if (label >= 0)
+          res.labels[i] = label, res.regions[label].push_back(i);
+      }
+      return res;
+    }
+
+  protected:
+    static VoxelGrid buildGrid(const pointset_type &points, double size) {
+      VoxelGrid grid;
+      grid.size = size;
+      grid.x0 = grid.y0 = grid.z0 = std::numeric_limits<double>::infinity();
+      double x1 = -grid.x0, y1 = x1, z1 = x1;
+      for (const auto &p : points) {
+        grid.x0 = std::min<double>(grid.x0, p.x), grid.y0 = std::min<double>(grid.y0, p.y), grid.z0 = std::min<double>(grid.z0, p.z);
+        x1 = std::max<double>(x1, p.x), y1 = std::max<double>(y1, p.y), z1 = std::max<double>(z1, p.z);
+      }
+      // the keys hold 21 bits a coordinate, coarsen the cells for a scan too large for them
+      double extent = std::max({x1 - grid.x0, y1 - grid.y0, z1 - grid.z0, 0.0});
+      grid.size = std::max(grid.size, extent / (VoxelGrid::CELLS - 2));
+      grid.rehash(1024);
+      grid.voxelOf.resize(points.size());
+      const double inv = 1.0 / grid.size;
+      // the points of a scan come in runs through one voxel, so the last one is tried first
+      std::uint64_t last = VoxelGrid::EMPTY;
+      std::size_t v = 0;
+      for (std::size_t i = 0; i != points.size(); ++i) {
+        const auto &p = points[i];
+        std::uint64_t k = grid.key(static_cast<std::int64_t>((p.x - grid.x0) * inv), static_cast<std::int64_t>((p.y - grid.y0) * inv),
+                                   static_cast<std::int64_t>((p.z - grid.z0) * inv));
+        if (k != last)
+          v = grid.insert(k), last = k;
+        grid.voxelOf[i] = v;
+      }
+      // the moments in a second pass, which no longer waits on the probing of the table
+      for (std::size_t i = 0; i != points.size(); ++i) {
+        const auto &p = points[i];
+        double x = (p.x - grid.x0) * inv, y = (p.y - grid.y0) * inv, z = (p.z - grid.z0) * inv;
+        auto ix = static_cast<std::int64_t>(x), iy = static_cast<std::int64_t>(y), iz = static_cast<std::int64_t>(z);
+        grid.moments[grid.voxelOf[i]].add(x - ix - 0.5, y - iy - 0.5, z - iz - 0.5);
+      }
+      return grid;
+    }
+
+    /**
+     * @brief the normal of every voxel from the moments of its neighbourhood
+     */
+    std::vector<PointNormal> voxelNormals(const VoxelGrid &grid) const {
+      std::vector<PointNormal> res(grid.keys.size());
+      parallelFor(
+          0, grid.keys.size(), [&](std::size_t v, std::size_t) {
+            Moments m;
+            grid.around(v, [&](std::size_t u, double dx, double dy, double dz) { m.merge(grid.moments[u], dx, dy, dz); });
+            if (m.num < 3.0)
+              return;
+            double mx = m.sx / m.num, my = m.sy / m.num, mz = m.sz / m.num;
+            Eigen::Matrix3d cov;
+            cov << m.sxx / m.num - mx * mx, m.sxy / m.num - mx * my, m.sxz / m.num - mx * mz,
+                m.sxy / m.num - mx * my, m.syy / m.num - my * my, m.syz / m.num - my * mz,
+                m.sxz / m.num - mx * mz, m.syz / m.num - my * mz, m.szz / m.num - mz * mz;
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+            solver.computeDirect(cov);
+            Eigen::Vector3d n = solver.eigenvectors().col(0), ev = solver.eigenvalues();
+            double sum = ev.sum();
+            res[v] = PointNormal{n(0), n(1), n(2), sum > 0.0 ? std::max(0.0, ev(0)) / sum : 1.0};
+          },
+          _options.threads, 256);
+      return res;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
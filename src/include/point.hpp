@@ -33,6 +33,8 @@ namespace ns_geo {
     TRIANGLE2,
     TRIANGLE3,
     CIRCLE,
+    PLANE,
+    ELLIPSE,
     // for geometry with reference
     REF_POINT2,
     REF_POINT3,
@@ -91,6 +93,12 @@ namespace ns_geo {
     case GeoType::CIRCLE:
       os << "CIRCLE";
       break;
+    case GeoType::PLANE:
+      os << "PLANE";
+      break;
+    case GeoType::ELLIPSE:
+      os << "ELLIPSE";
+      break;
     case GeoType::REF_POINT2:
       os << "REF-POINT2";
       break;
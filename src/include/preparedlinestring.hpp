@@ -0,0 +1,278 @@
+#ifndef PREPAREDLINESTRING_HPP
+#define PREPAREDLINESTRING_HPP
+
+/**
+ * @file preparedlinestring.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Line strings prepared for arc-length queries and linear referencing
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "linestring.hpp"
+#include "parallel.hpp"
+#include "rtree.hpp"
+#include <type_traits>
+
+namespace ns_geo {
+#pragma region PreparedLineString
+
+  /**
+   * @brief the projection of a point onto a line string
+   */
+  template <typename PointType>
+  struct LineProjection {
+    // the closest point on the line string
+    PointType point;
+    // the arc length of the closest point from the start
+    double along;
+    // the distance from the query point to the line string
+    double offset;
+    // the index of the segment holding the closest point
+    std::size_t segment;
+  };
+
+  /**
+   * @brief the common part of 'PreparedLineString2' and 'PreparedLineString3'
+   *
+   * @attention the cumulative segment lengths are cached, so an arc length is located by
+   * a binary search. the projection searches an R-tree over the planar boxes of the segments,
+   * whose distance is a lower bound of the 3-dime one as well.
+   */
+  template <typename Ty, std::size_t Dim>
+  class PreparedLineStringBase {
+  public:
+    using value_type = Ty;
+    using point_type = std::conditional_t<Dim == 2, Point2<value_type>, Point3<value_type>>;
+    using pointset_type = std::conditional_t<Dim == 2, PointSet2<value_type>, PointSet3<value_type>>;
+    using projection_type = LineProjection<point_type>;
+    using self_type = PreparedLineStringBase<value_type, Dim>;
+
+  protected:
+    using coord_type = std::array<double, 3>;
+
+    std::vector<coord_type> _pts;
+    // '_cum[i]' is the arc length of vertex 'i'
+    std::vector<double> _cum;
+    RTree _tree;
+
+  protected:
+    template <typename LineStringType>
+    explicit PreparedLineStringBase(const LineStringType &ls)
+        : _pts(coords(ls)), _cum(cumulate(_pts)), _tree(boxes(_pts)) {}
+
+  public:
+    /**
+     * @brief the length of the line string
+     */
+    [[nodiscard]] inline double length() const { return _cum.empty() ? 0.0 : _cum.back(); }
+
+    /**
+     * @brief the number of vertices
+     */
+    [[nodiscard]] inline std::size_t size() const { return _pts.size(); }
+
+    /**
+     * @brief the arc length of every vertex
+     */
+    [[nodiscard]] inline const std::vector<double> &cumulative() const { return _cum; }
+
+    /**
+     * @brief the point at the arc length 's', which is clamped to [0, length()]
+     */
+    [[nodiscard]] point_type interpolate(double s) const {
+      if (_pts.size() < 2)
+        return _pts.empty() ? point_type() : toPoint(_pts.front());
+      // the segment [i, i + 1] holding 's'
+      auto iter = std::upper_bound(_cum.cbegin(), _cum.cend(), s);
+      std::size_t i = iter == _cum.cbegin() ? 0 : std::min<std::size_t>(iter - _cum.cbegin() - 1, _pts.size() - 2);
+      double len = _cum[i + 1] - _cum[i];
+      double t = len > 0.0 ? std::min(1.0, std::max(0.0, (s - _cum[i]) / len)) : 0.0;
+      return lerp(_pts[i], _pts[i + 1], t);
+    }
+
+    /**
+     * @brief the points at several arc lengths
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    [[nodiscard]] pointset_type interpolate(const std::vector<double> &ss, std::size_t threads = 0) const {
+      pointset_type res(ss.size());
+      parallelFor(
+          0, ss.size(), [&](std::size_t i, std::size_t) { res[i] = this->interpolate(ss[i]); }, threads, 1024);
+      return res;
+    }
+
+    /**
+     * @brief resample the line string every 'step' from the start, the end point included
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    [[nodiscard]] pointset_type resample(double step, std::size_t threads = 0) const {
+      if (!(step > 0.0) || _pts.empty())
+        return pointset_type();
+      auto num = static_cast<std::size_t>(std::floor(this->length() / step)) + 1;
+      bool tail = (num - 1) * step < this->length();
+      pointset_type res(num + (tail ? 1 : 0));
+      parallelFor(
+          0, num, [&](std::size_t i, std::size_t) { res[i] = this->interpolate(i * step); }, threads, 1024);
+      if (tail)
+        res.back() = toPoint(_pts.back());
+      return res;
+    }
+
+    /**
+     * @brief project a point onto the line string
+     */
+    [[nodiscard]] projection_type project(const point_type &p) const {
+      coord_type q = toCoord(p);
+      projection_type res{point_type(), 0.0, std::numeric_limits<double>::infinity(), 0};
+      if (_pts.size() < 2) {
+        if (!_pts.empty())
+          res.point = toPoint(_pts.front()), res.offset = std::sqrt(distance2(q, _pts.front()));
+        return res;
+      }
+      double best = std::numeric_limits<double>::infinity();
+      double t = 0.0;
+      std::size_t seg = _tree.nearest(
+          q[0], q[1], [&](std::size_t i) { double u; return std::sqrt(segmentDistance2(q, i, u)); }, best);
+      segmentDistance2(q, seg, t);
+      res.point = lerp(_pts[seg], _pts[seg + 1], t);
+      res.along = _cum[seg] + t * (_cum[seg + 1] - _cum[seg]);
+      res.offset = best;
+      res.segment = seg;
+      return res;
+    }
+
+    /**
+     * @brief project many points onto the line string
+     *
+     * @param ps the query points
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    [[nodiscard]] std::vector<projection_type> project(const pointset_type &ps, std::size_t threads = 0) const {
+      std::vector<projection_type> res(ps.size());
+      parallelFor(
+          0, ps.size(), [&](std::size_t i, std::size_t) { res[i] = this->project(ps[i]); }, threads, 256);
+      return res;
+    }
+
+  protected:
+    static coord_type toCoord(const point_type &p) {
+      if constexpr (Dim == 2)
+        return {static_cast<double>(p.x), static_cast<double>(p.y), 0.0};
+      else
+        return {static_cast<double>(p.x), static_cast<double>(p.y), static_cast<double>(p.z)};
+    }
+
+    static point_type toPoint(const coord_type &c) {
+      if constexpr (Dim == 2)
+        return point_type(static_cast<value_type>(c[0]), static_cast<value_type>(c[1]));
+      else
+        return point_type(static_cast<value_type>(c[0]), static_cast<value_type>(c[1]), static_cast<value_type>(c[2]));
+    }
+
+    static point_type lerp(const coord_type &a, const coord_type &b, double t) {
+      return toPoint({a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), a[2] + t * (b[2] - a[2])});
+    }
+
+    static double distance2(const coord_type &a, const coord_type &b) {
+      return (a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]);
+    }
+
+    /**
+     * @brief the squared distance from 'q' to the segment 'i', 't' gets the parameter of the closest point
+     */
+    double segmentDistance2(const coord_type &q, std::size_t i, double &t) const {
+      const auto &a = _pts[i], &b = _pts[i + 1];
+      double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      double len2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+      double dot = ab[0] * (q[0] - a[0]) + ab[1] * (q[1] - a[1]) + ab[2] * (q[2] - a[2]);
+      t = len2 > 0.0 ? std::min(1.0, std::max(0.0, dot / len2)) : 0.0;
+      return distance2(q, {a[0] + t * ab[0], a[1] + t * ab[1], a[2] + t * ab[2]});
+    }
+
+    template <typename LineStringType>
+    static std::vector<coord_type> coords(const LineStringType &ls) {
+      std::vector<coord_type> res(ls.size());
+      for (std::size_t i = 0; i != ls.size(); ++i)
+        res[i] = toCoord(ls[i]);
+      return res;
+    }
+
+    static std::vector<double> cumulate(const std::vector<coord_type> &pts) {
+      std::vector<double> cum(pts.size(), 0.0);
+      for (std::size_t i = 1; i < pts.size(); ++i)
+        cum[i] = cum[i - 1] + std::sqrt(distance2(pts[i - 1], pts[i]));
+      return cum;
+    }
+
+    static std::vector<RTree::box_type> boxes(const std::vector<coord_type> &pts) {
+      std::vector<RTree::box_type> res;
+      for (std::size_t i = 1; i < pts.size(); ++i)
+        res.push_back({std::min(pts[i - 1][0], pts[i][0]), std::min(pts[i - 1][1], pts[i][1]),
+                       std::max(pts[i - 1][0], pts[i][0]), std::max(pts[i - 1][1], pts[i][1])});
+      return res;
+    }
+  };
+
+  /**
+   * @brief a 2-dime line string prepared for arc-length queries and projections
+   */
+  template <typename Ty = float>
+  class PreparedLineString2 : public PreparedLineStringBase<Ty, 2> {
+  public:
+    using value_type = Ty;
+    using linestring_type = LineString2<value_type>;
+    using reflinestring_type = RefLineString2<value_type>;
+    using self_type = PreparedLineString2<value_type>;
+
+  public:
+    explicit PreparedLineString2(const linestring_type &ls)
+        : PreparedLineStringBase<Ty, 2>(ls) {}
+
+    explicit PreparedLineString2(const reflinestring_type &ls)
+        : PreparedLineStringBase<Ty, 2>(points(ls)) {}
+
+  protected:
+    static PointSet2<value_type> points(const reflinestring_type &ls) {
+      PointSet2<value_type> ps;
+      for (auto id : ls)
+        ps.push_back(ls.refPointSet()->at(id));
+      return ps;
+    }
+  };
+
+  /**
+   * @brief a 3-dime line string prepared for arc-length queries and projections
+   */
+  template <typename Ty = float>
+  class PreparedLineString3 : public PreparedLineStringBase<Ty, 3> {
+  public:
+    using value_type = Ty;
+    using linestring_type = LineString3<value_type>;
+    using reflinestring_type = RefLineString3<value_type>;
+    using self_type = PreparedLineString3<value_type>;
+
+  public:
+    explicit PreparedLineString3(const linestring_type &ls)
+        : PreparedLineStringBase<Ty, 3>(ls) {}
+
+    explicit PreparedLineString3(const reflinestring_type &ls)
+        : PreparedLineStringBase<Ty, 3>(points(ls)) {}
+
+  protected:
+    static PointSet3<value_type> points(const reflinestring_type &ls) {
+      PointSet3<value_type> ps;
+      for (auto id : ls)
+        ps.push_back(ls.refPointSet()->at(id));
+      return ps;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
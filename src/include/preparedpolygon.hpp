@@ -0,0 +1,223 @@
+#ifndef PREPAREDPOLYGON_HPP
+#define PREPAREDPOLYGON_HPP
+
+/**
+ * @file preparedpolygon.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Polygon with a precomputed index for fast point containment tests
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "parallel.hpp"
+#include "polygon.hpp"
+#include <limits>
+
+namespace ns_geo {
+#pragma region PreparedPolygon
+
+  /**
+   * @brief a polygon prepared once for many containment tests
+   *
+   * @attention the edges are bucketed into horizontal slabs, so a query only runs the
+   * crossing-number test against the few edges of its slab, which is O(1) expected.
+   * the edges of a slab are kept in flat arrays to let the compiler vectorize the test.
+   * several rings can be added, they combine by the even-odd rule (holes).
+   * points exactly on the border may fall on either side.
+   */
+  template <typename Ty = float>
+  class PreparedPolygon {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using pointset_type = PointSet2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using refpolygon_type = RefPolygon<value_type>;
+    using mask_type = std::vector<std::uint64_t>;
+    using self_type = PreparedPolygon<value_type>;
+
+  private:
+    // the edges of all the rings: lower y, upper y, the point at the lower end, dx / dy
+    std::vector<std::array<double, 2>> _raw0;
+    std::vector<std::array<double, 2>> _raw1;
+    // the slab index
+    std::vector<std::size_t> _offset;
+    std::vector<double> _ylo, _yhi, _x0, _y0, _k;
+    double _xmin, _xmax, _ymin, _ymax;
+    double _invSlab;
+    std::size_t _slabNum;
+
+  public:
+    /**
+     * @brief prepare a polygon
+     */
+    explicit PreparedPolygon(const polygon_type &polygon) {
+      this->appendRing(polygon.cbegin(), polygon.cend(), [](const point_type &p) { return p; });
+      this->index();
+    }
+
+    /**
+     * @brief prepare a reference polygon
+     */
+    explicit PreparedPolygon(const refpolygon_type &polygon) {
+      auto rps = polygon.refPointSet();
+      this->appendRing(polygon.cbegin(), polygon.cend(), [rps](uint id) -> const point_type & { return rps->at(id); });
+      this->index();
+    }
+
+    /**
+     * @brief add another ring (a hole, or a further part), it's combined by the even-odd rule
+     */
+    self_type &addRing(const polygon_type &ring) {
+      this->appendRing(ring.cbegin(), ring.cend(), [](const point_type &p) { return p; });
+      this->index();
+      return *this;
+    }
+
+    /**
+     * @brief the bounding box as {xmin, ymin, xmax, ymax}
+     */
+    [[nodiscard]] inline std::array<double, 4> bound() const {
+      return {_xmin, _ymin, _xmax, _ymax};
+    }
+
+    /**
+     * @brief whether the point lies inside the polygon
+     */
+    [[nodiscard]] inline bool contains(const point_type &p) const {
+      return this->contains(static_cast<double>(p.x), static_cast<double>(p.y));
+    }
+
+    [[nodiscard]] inline bool contains(double x, double y) const {
+      if (!(x >= _xmin && x <= _xmax && y >= _ymin && y <= _ymax))
+        return false;
+      auto s = std::min(static_cast<std::size_t>((y - _ymin) * _invSlab), _slabNum - 1);
+      int cross = 0;
+      const double *ylo = _ylo.data(), *yhi = _yhi.data(), *x0 = _x0.data(), *y0 = _y0.data(), *k = _k.data();
+      // branch free, so the compiler can vectorize it
+      for (std::size_t i = _offset[s], end = _offset[s + 1]; i != end; ++i)
+        cross ^= static_cast<int>((y >= ylo[i]) & (y < yhi[i]) & (x < x0[i] + (y - y0[i]) * k[i]));
+      return cross != 0;
+    }
+
+    /**
+     * @brief test a whole point set, bit 'i % 64' of word 'i / 64' tells whether 'ps[i]' is inside
+     *
+     * @param ps the points
+     * @param threads the number of threads, zero means all hardware threads
+     * @return mask_type the bit mask
+     */
+    [[nodiscard]] mask_type contains(const pointset_type &ps, std::size_t threads = 0) const {
+      mask_type mask;
+      this->contains(ps, mask, threads);
+      return mask;
+    }
+
+    /**
+     * @brief test a whole point set into an existing mask buffer
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    void contains(const pointset_type &ps, mask_type &mask, std::size_t threads = 0) const {
+      std::size_t words = (ps.size() + 63) / 64;
+      mask.assign(words, 0);
+      parallelFor(
+          0, words, [&](std::size_t w, std::size_t) {
+            std::uint64_t bits = 0;
+            std::size_t begin = w * 64, end = std::min(begin + 64, ps.size());
+            for (std::size_t i = begin; i != end; ++i)
+              bits |= static_cast<std::uint64_t>(this->contains(ps[i])) << (i - begin);
+            mask[w] = bits;
+          },
+          threads, 64);
+    }
+
+    /**
+     * @brief read bit 'i' of a mask
+     */
+    static inline bool test(const mask_type &mask, std::size_t i) {
+      return (mask[i >> 6] >> (i & 63)) & 1u;
+    }
+
+  protected:
+    template <typename Iter, typename Get>
+    void appendRing(Iter begin, Iter end, Get get) {
+      std::size_t n = std::distance(begin, end);
+      if (n < 3)
+        return;
+      for (auto iter = begin; iter != end; ++iter) {
+        auto nxt = std::next(iter) == end ? begin : std::next(iter);
+        const auto &a = get(*iter), &b = get(*nxt);
+        _raw0.push_back({static_cast<double>(a.x), static_cast<double>(a.y)});
+        _raw1.push_back({static_cast<double>(b.x), static_cast<double>(b.y)});
+      }
+    }
+
+    /**
+     * @brief (re)build the slabs, shrinking their count while long edges bloat them
+     */
+    void index() {
+      _xmin = _ymin = std::numeric_limits<double>::max();
+      _xmax = _ymax = std::numeric_limits<double>::lowest();
+      for (std::size_t i = 0; i != _raw0.size(); ++i) {
+        _xmin = std::min(_xmin, std::min(_raw0[i][0], _raw1[i][0]));
+        _xmax = std::max(_xmax, std::max(_raw0[i][0], _raw1[i][0]));
+        _ymin = std::min(_ymin, std::min(_raw0[i][1], _raw1[i][1]));
+        _ymax = std::max(_ymax, std::max(_raw0[i][1], _raw1[i][1]));
+      }
+      std::size_t n = _raw0.size();
+      _slabNum = std::max<std::size_t>(1, n);
+      double height = _ymax - _ymin;
+      auto slabRange = [&](std::size_t i, std::size_t &from, std::size_t &to) {
+        double lo = std::min(_raw0[i][1], _raw1[i][1]), hi = std::max(_raw0[i][1], _raw1[i][1]);
+        from = std::min(static_cast<std::size_t>((lo - _ymin) * _invSlab), _slabNum - 1);
+        to = std::min(static_cast<std::size_t>((hi - _ymin) * _invSlab), _slabNum - 1);
+      };
+      for (;;) {
+        _invSlab = height > 0.0 ? _slabNum / height : 0.0;
+        std::size_t total = 0, from, to;
+        for (std::size_t i = 0; i != n; ++i)
+          if (_raw0[i][1] != _raw1[i][1])
+            slabRange(i, from, to), total += to - from + 1;
+        if (total <= 8 * n || _slabNum == 1)
+          break;
+        _slabNum = std::max<std::size_t>(1, _slabNum / 2);
+      }
+      // count, then fill the slabs
+      _offset.assign(_slabNum + 1, 0);
+      std::size_t from, to;
+      for (std::size_t i = 0; i != n; ++i) {
+        if (_raw0[i][1] == _raw1[i][1])
+          continue;
+        slabRange(i, from, to);
+        for (std::size_t s = from; s <= to; ++s)
+          ++_offset[s + 1];
+      }
+      for (std::size_t s = 0; s != _slabNum; ++s)
+        _offset[s + 1] += _offset[s];
+      std::size_t total = _offset[_slabNum];
+      _ylo.resize(total), _yhi.resize(total), _x0.resize(total), _y0.resize(total), _k.resize(total);
+      std::vector<std::size_t> cursor(_offset.cbegin(), _offset.cend() - 1);
+      for (std::size_t i = 0; i != n; ++i) {
+        // horizontal edges never cross a horizontal ray
+        if (_raw0[i][1] == _raw1[i][1])
+          continue;
+        const auto &lo = _raw0[i][1] < _raw1[i][1] ? _raw0[i] : _raw1[i];
+        const auto &hi = _raw0[i][1] < _raw1[i][1] ? _raw1[i] : _raw0[i];
+        slabRange(i, from, to);
+        for (std::size_t s = from; s <= to; ++s) {
+          std::size_t j = cursor[s]++;
+          _ylo[j] = lo[1], _yhi[j] = hi[1];
+          _x0[j] = lo[0], _y0[j] = lo[1];
+          _k[j] = (hi[0] - lo[0]) / (hi[1] - lo[1]);
+        }
+      }
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef RANSAC_HPP
+#define RANSAC_HPP
+
+/**
+ * @file ransac.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief A generic, adaptive and parallel RANSAC engine with local optimization
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "circle.hpp"
+#include "ellipse.hpp"
+#include "parallel.hpp"
+#include "plane.hpp"
+#include "sline.hpp"
+#include <limits>
+#include <optional>
+
+namespace ns_geo {
+#pragma region RansacEstimators
+
+  /**
+   * @brief fit 'SLine2' to 2-dime points, the residual is the distance to the line
+   *
+   * @attention an estimator tells the engine its minimal sample size 'SAMPLE_SIZE', fits a model
+   * to some of the data by 'fit' (the minimal samples as well as the inliers of local optimization,
+   * nothing for a degenerate set) and measures a datum against a model by 'residual'
+   */
+  struct LineEstimator {
+    using data_type = Point2<double>;
+    using model_type = SLine2;
+
+    static constexpr std::size_t SAMPLE_SIZE = 2;
+
+    /**
+     * @brief the total least squares line through the points
+     */
+    std::optional<model_type> fit(const std::vector<data_type> &data, const std::size_t *idx, std::size_t num) const {
+      if (num < SAMPLE_SIZE)
+        return std::nullopt;
+      double mx = 0.0, my = 0.0;
+      for (std::size_t i = 0; i != num; ++i)
+        mx += data[idx[i]].x, my += data[idx[i]].y;
+      mx /= num, my /= num;
+      double sxx = 0.0, sxy = 0.0, syy = 0.0;
+      for (std::size_t i = 0; i != num; ++i) {
+        double dx = data[idx[i]].x - mx, dy = data[idx[i]].y - my;
+        sxx += dx * dx, sxy += dx * dy, syy += dy * dy;
+      }
+      if (sxx + syy == 0.0)
+        return std::nullopt;
+      return SLine2::principal(mx, my, sxx, sxy, syy);
+    }
+
+    double residual(const model_type &model, const data_type &p) const { return model.distance(p); }
+  };
+
+  /**
+   * @brief fit 'Circle' to 2-dime points, the residual is the distance to the circle
+   */
+  struct CircleEstimator {
+    using data_type = Point2<double>;
+    using model_type = Circle;
+
+    static constexpr std::size_t SAMPLE_SIZE = 3;
+
+    /**
+     * @brief the circle through three points, or the Taubin fit to more of them
+     */
+    std::optional<model_type> fit(const std::vector<data_type> &data, const std::size_t *idx, std::size_t num) const {
+      if (num < SAMPLE_SIZE)
+        return std::nullopt;
+      auto cir = Circle::taubin(Circle::moments(data, idx, num));
+      if (!std::isfinite(cir.rad) || !std::isfinite(cir.cen.x) || !std::isfinite(cir.cen.y))
+        return std::nullopt;
+      return cir;
+    }
+
+    double residual(const model_type &model, const data_type &p) const { return model.distance(p); }
+  };
+
+  /**
+   * @brief fit 'Ellipse' to 2-dime points, the residual is the distance to the ellipse
+   */
+  struct EllipseEstimator {
+    using data_type = Point2<double>;
+    using model_type = Ellipse;
+
+    static constexpr std::size_t SAMPLE_SIZE = 5;
+
+    /**
+     * @brief the direct least squares ellipse through the points
+     */
+    std::optional<model_type> fit(const std::vector<data_type> &data, const std::size_t *idx, std::size_t num) const {
+      if (num < SAMPLE_SIZE)
+        return std::nullopt;
+      auto ell = Ellipse::direct(data, idx, num);
+      if (!std::isfinite(ell.a) || !std::isfinite(ell.b) || !std::isfinite(ell.cen.x) || !std::isfinite(ell.cen.y))
+        return std::nullopt;
+      return ell;
+    }
+
+    double residual(const model_type &model, const data_type &p) const { return model.distance(p); }
+  };
+
+  /**
+   * @brief fit 'Plane' to 3-dime points, the residual is the distance to the plane
+   */
+  struct PlaneEstimator {
+    using data_type = Point3<double>;
+    using model_type = Plane;
+
+    static constexpr std::size_t SAMPLE_SIZE = 3;
+
+    /**
+     * @brief the plane through three points, or the total least squares plane through more of them
+     */
+    std::optional<model_type> fit(const std::vector<data_type> &data, const std::size_t *idx, std::size_t num) const {
+      if (num < SAMPLE_SIZE)
+        return std::nullopt;
+      if (num == SAMPLE_SIZE) {
+        Plane pl(data[idx[0]], data[idx[1]], data[idx[2]]);
+        if (!std::isfinite(pl.a) || !std::isfinite(pl.b) || !std::isfinite(pl.c))
+          return std::nullopt;
+        return pl;
+      }
+      double mx = 0.0, my = 0.0, mz = 0.0;
+      for (std::size_t i = 0; i != num; ++i)
+        mx += data[idx[i]].x, my += data[idx[i]].y, mz += data[idx[i]].z;
+      mx /= num, my /= num, mz /= num;
+      double sxx = 0.0, sxy = 0.0, sxz = 0.0, syy = 0.0, syz = 0.0, szz = 0.0;
+      for (std::size_t i = 0; i != num; ++i) {
+        double dx = data[idx[i]].x - mx, dy = data[idx[i]].y - my, dz = data[idx[i]].z - mz;
+        sxx += dx * dx, sxy += dx * dy, sxz += dx * dz, syy += dy * dy, syz += dy * dz, szz += dz * dz;
+      }
+      if (sxx + syy + szz == 0.0)
+        return std::nullopt;
+      return Plane::principal(data_type(mx, my, mz), sxx, sxy, sxz, syy, syz, szz);
+    }
+
+    double residual(const model_type &model, const data_type &p) const { return model.distance(p); }
+  };
+
+#pragma endregion
+
+#pragma region Ransac
+
+  struct RansacOptions {
+    /**
+     * @brief the max residual of an inlier
+     */
+    double threshold = 1.0;
+    /**
+     * @brief the wanted probability of drawing at least one all-inlier sample
+     */
+    double confidence = 0.99;
+    std::size_t maxIterations = 10000;
+    /**
+     * @brief the number of random points a hypothesis must fit before its full scoring,
+     * the T(d,d) test, zero turns it off
+     */
+    std::size_t preemptive = 1;
+    /**
+     * @brief the max rounds of local optimization for a new best model, zero turns it off
+     */
+    std::size_t localIterations = 5;
+    /**
+     * @brief the number of hypotheses drawn between two checks of the adaptive termination,
+     * split over the threads, so the schedule doesn't change with them
+     */
+    std::size_t round = 32;
+    /**
+     * @brief the number of threads, zero means all hardware threads
+     */
+    std::size_t threads = 0;
+    std::uint64_t seed = 0;
+  };
+
+  template <typename Model>
+  struct RansacResult {
+    /**
+     * @brief the best model, empty if no sample gave one
+     */
+    std::optional<Model> model;
+    /**
+     * @brief one flag per datum
+     */
+    std::vector<char> inliers;
+    std::size_t inlierNum = 0;
+    /**
+     * @brief the number of hypotheses drawn
+     */
+    std::size_t iterations = 0;
+    /**
+     * @brief the truncated quadratic (MSAC) cost of the model
+     */
+    double cost = std::numeric_limits<double>::infinity();
+
+    [[nodiscard]] inline bool success() const { return model.has_value(); }
+  };
+
+  /**
+   * @brief the RANSAC engine over an estimator, such as 'LineEstimator', 'CircleEstimator' or 'PlaneEstimator'
+   *
+   * @attention the hypotheses are drawn and scored in rounds of 'round' spread over the threads.
+   * each hypothesis seeds its own generator from the seed and its number, and the rounds are
+   * as long for any number of threads, so the result doesn't depend on the thread count. a hypothesis first has to fit 'preemptive' random data (the
+   * T(d,d) test), then its MSAC cost is summed up and abandoned once it exceeds the best cost
+   * known at the start of the round. after each round the number of iterations adapts to the
+   * inlier ratio 'w' of the best model, 'log(1 - confidence) / log(1 - w^(m + d))' for samples
+   * of 'm' data. a new best model is refined by local optimization (LO-RANSAC), refitting to
+   * its inliers for as long as that lowers the cost.
+   */
+  template <typename Estimator>
+  class Ransac {
+  public:
+    using estimator_type = Estimator;
+    using data_type = typename Estimator::data_type;
+    using model_type = typename Estimator::model_type;
+    using result_type = RansacResult<model_type>;
+    using self_type = Ransac<estimator_type>;
+
+    /**
+     * @brief a scored hypothesis, no model for a rejected one
+     */
+    struct Hypothesis {
+      std::optional<model_type> model;
+      double cost = std::numeric_limits<double>::infinity();
+    };
+
+    /**
+     * @brief the number of hypotheses a thread claims at a time
+     */
+    static constexpr std::size_t GRAIN = 4;
+
+  protected:
+    estimator_type _estimator;
+    RansacOptions _options;
+
+  public:
+    explicit Ransac(const RansacOptions &options = RansacOptions(), const estimator_type &estimator = estimator_type())
+        : _estimator(estimator), _options(options) {}
+
+    [[nodiscard]] inline const RansacOptions &options() const { return _options; }
+
+    /**
+     * @brief find the model with the most support in the data
+     */
+    result_type run(const std::vector<data_type> &data) const {
+      constexpr std::size_t m = Estimator::SAMPLE_SIZE;
+      result_type res;
+      std::size_t n = data.size();
+      if (n < m)
+        return res;
+      const double t2 = _options.threshold * _options.threshold;
+      auto score = [&](std::minstd_rand &engine, double bound, std::size_t) {
+        std::array<std::size_t, m> sample;
+        draw(engine, n, sample);
+        auto fitted = _estimator.fit(data, sample.data(), m);
+        if (!fitted)
+          return Hypothesis{};
+        std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+        for (std::size_t k = 0; k != _options.preemptive; ++k)
+          if (_estimator.residual(*fitted, data[pick(engine)]) > _options.threshold)
+            return Hypothesis{};
+        double cost = this->cost(*fitted, data, t2, bound);
+        return cost < bound ? Hypothesis{fitted, cost} : Hypothesis{};
+      };
+      auto improve = [&]() {
+        this->optimize(data, t2, res);
+        return iterationsFor(static_cast<double>(this->count(*res.model, data)) / n, m + _options.preemptive);
+      };
+      res.iterations = this->rounds(0, res.model, res.cost, score, improve);
+      if (res.model) {
+        res.inliers.resize(n);
+        for (std::size_t i = 0; i != n; ++i)
+          res.inliers[i] = _estimator.residual(*res.model, data[i]) <= _options.threshold;
+        res.inlierNum = std::count(res.inliers.cbegin(), res.inliers.cend(), 1);
+      }
+      return res;
+    }
+
+    /**
+     * @brief draw and score hypotheses in rounds until the adaptive number of iterations or the max one
+     *
+     * @param first the number of the first hypothesis, which seeds the generators of the rest
+     * @param score 'score(engine, bound, worker)' draws a sample with the engine and returns its
+     * hypothesis, whose cost only counts below 'bound', the best cost at the start of the round
+     * @param improve 'improve()' refines the new best model in 'best' and 'bestCost' and
+     * returns the number of iterations its inlier ratio needs
+     * @return the number of hypotheses drawn
+     * @attention the loop of 'run' and of 'MultiModelExtractor'. the best of a round takes the
+     * first one on ties, and the rounds are 'round' long whatever the thread count
+     */
+    template <typename Score, typename Improve>
+    std::size_t rounds(std::uint64_t first, std::optional<model_type> &best, double &bestCost, Score score,
+                       Improve improve) const {
+      const std::size_t round = std::max<std::size_t>(1, _options.round);
+      std::vector<Hypothesis> hyps(round);
+      std::size_t iterations = 0, needed = _options.maxIterations;
+      while (iterations < std::min(needed, _options.maxIterations)) {
+        std::size_t count = std::min(round, _options.maxIterations - iterations);
+        const double bound = bestCost;
+        const std::uint64_t from = first + iterations;
+        parallelFor(
+            0, count, [&](std::size_t i, std::size_t worker) {
+              std::minstd_rand engine(mix(_options.seed, from + i));
+              hyps[i] = score(engine, bound, worker);
+            },
+            _options.threads, GRAIN);
+        iterations += count;
+
+        std::size_t top = count;
+        for (std::size_t i = 0; i != count; ++i)
+          if (hyps[i].model && (top == count || hyps[i].cost < hyps[top].cost))
+            top = i;
+        if (top != count && hyps[top].cost < bestCost) {
+          best = hyps[top].model, bestCost = hyps[top].cost;
+          needed = improve();
+        }
+      }
+      return iterations;
+    }
+
+    /**
+     * @brief the number of iterations to draw an all-inlier sample of 'size' data with the
+     * confidence, for the inlier ratio 'ratio'
+     */
+    std::size_t iterationsFor(double ratio, std::size_t size) const {
+      double good = std::pow(ratio, static_cast<double>(size));
+      if (good >= 1.0)
+        return 1;
+      if (good <= 0.0)
+        return _options.maxIterations;
+      double k = std::log(1.0 - _options.confidence) / std::log(1.0 - good);
+      return static_cast<std::size_t>(std::min<double>(std::ceil(k), _options.maxIterations));
+    }
+
+    /**
+     * @brief a seed for a hypothesis from the run seed and its number (splitmix64)
+     */
+    static std::uint32_t mix(std::uint64_t seed, std::uint64_t index) {
+      std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (index + 1);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      z ^= z >> 31;
+      // 'minstd_rand' wants a nonzero seed below its modulus
+      return static_cast<std::uint32_t>(z % 2147483646ULL) + 1;
+    }
+
+  protected:
+    /**
+     * @brief draw 'M' distinct indices below 'n' by Floyd's algorithm
+     */
+    template <std::size_t M>
+    static void draw(std::minstd_rand &engine, std::size_t n, std::array<std::size_t, M> &sample) {
+      for (std::size_t k = 0; k != M; ++k) {
+        std::size_t top = n - M + k;
+        std::size_t v = std::uniform_int_distribution<std::size_t>(0, top)(engine);
+        if (std::find(sample.begin(), sample.begin() + k, v) != sample.begin() + k)
+          v = top;
+        sample[k] = v;
+      }
+    }
+
+    double cost(const model_type &model, const std::vector<data_type> &data, double t2, double bound) const {
+      double cost = 0.0;
+      for (const auto &d : data) {
+        double r = _estimator.residual(model, d);
+        cost += std::min(r * r, t2);
+        if (cost >= bound)
+          break;
+      }
+      return cost;
+    }
+
+    std::size_t count(const model_type &model, const std::vector<data_type> &data) const {
+      std::size_t num = 0;
+      for (const auto &d : data)
+        num += _estimator.residual(model, d) <= _options.threshold;
+      return num;
+    }
+
+    /**
+     * @brief refit the model to its inliers while that lowers the cost
+     */
+    void optimize(const std::vector<data_type> &data, double t2, result_type &res) const {
+      std::vector<std::size_t> idx;
+      for (std::size_t it = 0; it != _options.localIterations; ++it) {
+        idx.clear();
+        for (std::size_t i = 0; i != data.size(); ++i)
+          if (_estimator.residual(*res.model, data[i]) <= _options.threshold)
+            idx.push_back(i);
+        auto model = _estimator.fit(data, idx.data(), idx.size());
+        if (!model)
+          return;
+        double cost = this->cost(*model, data, t2, res.cost);
+        if (!(cost < res.cost))
+          return;
+        res.model = model, res.cost = cost;
+      }
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
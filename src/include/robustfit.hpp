@@ -0,0 +1,257 @@
+#ifndef ROBUSTFIT_HPP
+#define ROBUSTFIT_HPP
+
+/**
+ * @file robustfit.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Robust M-estimator fitting of lines, circles and planes by reweighted least squares
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "circle.hpp"
+#include "plane.hpp"
+#include "sline.hpp"
+
+namespace ns_geo {
+#pragma region RobustFitter
+
+  enum class Loss {
+    /**
+     * @brief quadratic near zero and linear beyond 'k', the weights never drop to zero
+     */
+    HUBER,
+    /**
+     * @brief the biweight, the data beyond 'k' get no weight at all
+     */
+    TUKEY,
+    /**
+     * @brief logarithmic, the weights fall off smoothly with the residual
+     */
+    CAUCHY
+  };
+
+  struct RobustOptions {
+    Loss loss = Loss::HUBER;
+    /**
+     * @brief the tuning constant in units of the noise scale, zero picks the usual one for the
+     * loss (95% efficiency under gaussian noise)
+     */
+    double tuning = 0.0;
+    /**
+     * @brief the noise scale, zero estimates it from the residuals by their median absolute deviation
+     */
+    double scale = 0.0;
+    std::size_t maxIterations = 30;
+    /**
+     * @brief stop once the parameters change by less than this
+     */
+    double tolerance = 1E-10;
+  };
+
+  /**
+   * @brief iteratively reweighted least squares for 'SLine2', 'Circle' and 'Plane'
+   *
+   * @attention each iteration computes all the residuals, then all the weights from the loss,
+   * in separate branch-free passes, and refits the model with the weights: the weighted
+   * orthogonal fit for lines and planes, a weighted Gauss-Newton step for circles. the start is
+   * the closed-form fit unless one is given. the buffers are kept in the fitter and reused,
+   * so repeated fits of similar sizes don't allocate, and a fitter must not be shared
+   * between threads. an empty set gives a model of NaNs after no iterations.
+   */
+  class RobustFitter {
+  public:
+    using value_type = double;
+    using self_type = RobustFitter;
+
+  protected:
+    RobustOptions _options;
+    std::vector<value_type> _residuals;
+    std::vector<value_type> _weights;
+    std::vector<value_type> _scratch;
+    std::size_t _iterations = 0;
+
+  public:
+    explicit RobustFitter(const RobustOptions &options = RobustOptions()) : _options(options) {}
+
+    [[nodiscard]] inline const RobustOptions &options() const { return _options; }
+
+    /**
+     * @brief the weights of the data in the last fit
+     */
+    [[nodiscard]] inline const std::vector<value_type> &weights() const { return _weights; }
+
+    /**
+     * @brief the number of iterations of the last fit
+     */
+    [[nodiscard]] inline std::size_t iterations() const { return _iterations; }
+
+    /**
+     * @brief the robust line fit starting from the orthogonal fit
+     */
+    SLine2 fitLine(const PointSet2<value_type> &pts) {
+      this->prepare(pts.size());
+      std::fill(_weights.begin(), _weights.end(), 1.0);
+      return fitLine(pts, SLine2::fit(pts, _weights));
+    }
+
+    SLine2 fitLine(const PointSet2<value_type> &pts, const SLine2 &init) {
+      SLine2 line = init;
+      this->prepare(pts.size());
+      for (_iterations = 0; _iterations != _options.maxIterations; ++_iterations) {
+        value_type norm = std::sqrt(line.a * line.a + line.b * line.b);
+        value_type a = line.a / norm, b = line.b / norm, c = line.c / norm;
+        for (std::size_t i = 0; i != pts.size(); ++i)
+          _residuals[i] = a * pts[i].x + b * pts[i].y + c;
+        if (!this->reweight())
+          break;
+        SLine2 next = SLine2::fit(pts, _weights);
+        // the sign of the parameters is arbitrary
+        value_type s = next.a * line.a + next.b * line.b + next.c * line.c < 0.0 ? -1.0 : 1.0;
+        value_type change = std::abs(s * next.a - line.a) + std::abs(s * next.b - line.b) + std::abs(s * next.c - line.c);
+        line = next;
+        if (change < _options.tolerance)
+          break;
+      }
+      return line;
+    }
+
+    /**
+     * @brief the robust plane fit starting from the orthogonal fit
+     */
+    Plane fitPlane(const PointSet3<value_type> &pts) {
+      this->prepare(pts.size());
+      std::fill(_weights.begin(), _weights.end(), 1.0);
+      return fitPlane(pts, Plane::fit(pts, _weights));
+    }
+
+    Plane fitPlane(const PointSet3<value_type> &pts, const Plane &init) {
+      Plane plane = init;
+      this->prepare(pts.size());
+      for (_iterations = 0; _iterations != _options.maxIterations; ++_iterations) {
+        for (std::size_t i = 0; i != pts.size(); ++i)
+          _residuals[i] = plane.a * pts[i].x + plane.b * pts[i].y + plane.c * pts[i].z + plane.d;
+        if (!this->reweight())
+          break;
+        Plane next = Plane::fit(pts, _weights);
+        value_type s = next.a * plane.a + next.b * plane.b + next.c * plane.c < 0.0 ? -1.0 : 1.0;
+        value_type change = std::abs(s * next.a - plane.a) + std::abs(s * next.b - plane.b) +
+                            std::abs(s * next.c - plane.c) + std::abs(s * next.d - plane.d);
+        plane = next;
+        if (change < _options.tolerance)
+          break;
+      }
+      return plane;
+    }
+
+    /**
+     * @brief the robust circle fit starting from the Taubin fit
+     */
+    Circle fitCircle(const PointSet2<value_type> &pts) { return fitCircle(pts, Circle::taubin(pts)); }
+
+    Circle fitCircle(const PointSet2<value_type> &pts, const Circle &init) {
+      Circle cir = init;
+      this->prepare(pts.size());
+      for (_iterations = 0; _iterations != _options.maxIterations; ++_iterations) {
+        for (std::size_t i = 0; i != pts.size(); ++i) {
+          value_type deltaX = pts[i].x - cir.cen.x, deltaY = pts[i].y - cir.cen.y;
+          _residuals[i] = std::sqrt(deltaX * deltaX + deltaY * deltaY) - cir.rad;
+        }
+        if (!this->reweight())
+          break;
+        // one weighted Gauss-Newton step on the distances
+        value_type h00 = 0.0, h01 = 0.0, h02 = 0.0, h11 = 0.0, h12 = 0.0, h22 = 0.0, g0 = 0.0, g1 = 0.0, g2 = 0.0;
+        for (std::size_t i = 0; i != pts.size(); ++i) {
+          value_type deltaX = pts[i].x - cir.cen.x, deltaY = pts[i].y - cir.cen.y;
+          value_type dis = _residuals[i] + cir.rad, w = dis > 0.0 ? _weights[i] : 0.0;
+          value_type jx = dis > 0.0 ? -deltaX / dis : 0.0, jy = dis > 0.0 ? -deltaY / dis : 0.0;
+          h00 += w * jx * jx, h01 += w * jx * jy, h02 -= w * jx, h11 += w * jy * jy, h12 -= w * jy, h22 += w;
+          g0 -= w * jx * _residuals[i], g1 -= w * jy * _residuals[i], g2 += w * _residuals[i];
+        }
+        Eigen::Matrix3d H;
+        H << h00, h01, h02, h01, h11, h12, h02, h12, h22;
+        Eigen::Vector3d delta = H.ldlt().solve(Eigen::Vector3d(g0, g1, g2));
+        if (!delta.allFinite())
+          break;
+        cir.cen.x += delta(0), cir.cen.y += delta(1), cir.rad += delta(2);
+        if (delta.cwiseAbs().sum() < _options.tolerance)
+          break;
+      }
+      return cir;
+    }
+
+    /**
+     * @brief the default tuning constant of a loss
+     */
+    static value_type defaultTuning(Loss loss) {
+      switch (loss) {
+      case Loss::HUBER:
+        return 1.345;
+      case Loss::TUKEY:
+        return 4.685;
+      case Loss::CAUCHY:
+        return 2.385;
+      }
+      return 1.0;
+    }
+
+  protected:
+    void prepare(std::size_t num) {
+      _residuals.resize(num);
+      _weights.resize(num);
+    }
+
+    /**
+     * @brief the weights from the residuals
+     *
+     * @return bool false if there are no data, the residuals vanish or no datum keeps a weight
+     */
+    bool reweight() {
+      std::size_t n = _residuals.size();
+      if (n == 0)
+        return false;
+      value_type scale = _options.scale;
+      if (scale <= 0.0) {
+        // the median absolute deviation, scaled to the standard deviation of gaussian noise
+        _scratch.resize(n);
+        for (std::size_t i = 0; i != n; ++i)
+          _scratch[i] = std::abs(_residuals[i]);
+        std::nth_element(_scratch.begin(), _scratch.begin() + n / 2, _scratch.end());
+        scale = 1.4826 * _scratch[n / 2];
+      }
+      if (!(scale > 0.0))
+        return false;
+      value_type k = (_options.tuning > 0.0 ? _options.tuning : defaultTuning(_options.loss)) * scale;
+      value_type inv = 1.0 / k, sum = 0.0;
+      const value_type *r = _residuals.data();
+      value_type *w = _weights.data();
+      switch (_options.loss) {
+      case Loss::HUBER:
+        for (std::size_t i = 0; i != n; ++i)
+          w[i] = std::min(1.0, k / std::max(std::abs(r[i]), 1E-300));
+        break;
+      case Loss::TUKEY:
+        for (std::size_t i = 0; i != n; ++i) {
+          value_type u = r[i] * inv, t = std::max(0.0, 1.0 - u * u);
+          w[i] = t * t;
+        }
+        break;
+      case Loss::CAUCHY:
+        for (std::size_t i = 0; i != n; ++i) {
+          value_type u = r[i] * inv;
+          w[i] = 1.0 / (1.0 + u * u);
+        }
+        break;
+      }
+      for (std::size_t i = 0; i != n; ++i)
+        sum += w[i];
+      return sum > 0.0;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,238 @@
+#ifndef RTREE_HPP
+#define RTREE_HPP
+
+/**
+ * @file rtree.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief A static R-tree over axis-aligned boxes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "utility.hpp"
+#include <limits>
+#include <queue>
+#include <tuple>
+
+namespace ns_geo {
+#pragma region RTree
+
+  /**
+   * @brief a read-only R-tree, bulk loaded with the Sort-Tile-Recursive method
+   *
+   * @attention the items are the indices of the boxes it's built from.
+   * the nodes live in one flat array and the queries walk them with an explicit stack.
+   */
+  class RTree {
+  public:
+    /**
+     * @brief a box as {xmin, ymin, xmax, ymax}
+     */
+    using box_type = std::array<double, 4>;
+    using self_type = RTree;
+
+  protected:
+    struct Node {
+      box_type box;
+      // the children are nodes [begin, end), or the items [begin, end) of '_items' for a leaf
+      std::size_t begin;
+      std::size_t end;
+      bool leaf;
+    };
+
+    std::vector<Node> _nodes;
+    std::vector<std::size_t> _items;
+    std::vector<box_type> _boxes;
+    std::size_t _root = 0;
+
+  public:
+    /**
+     * @brief build the tree
+     *
+     * @param boxes the boxes, the item ids are their indices
+     * @param fanout the max number of children of a node, within [2, 64]
+     */
+    explicit RTree(const std::vector<box_type> &boxes, std::size_t fanout = 16)
+        : _boxes(boxes) {
+      fanout = std::min<std::size_t>(std::max<std::size_t>(fanout, 2), 64);
+      if (boxes.empty())
+        return;
+      // the leaves
+      std::vector<std::size_t> order(boxes.size());
+      for (std::size_t i = 0; i != order.size(); ++i)
+        order[i] = i;
+      auto centre = [](const box_type &b, int axis) { return b[axis] + b[axis + 2]; };
+      strSort(order, fanout, [&](std::size_t i, int axis) { return centre(_boxes[i], axis); });
+      _items = order;
+      std::vector<std::size_t> level;
+      for (std::size_t i = 0; i < _items.size(); i += fanout) {
+        Node node{emptyBox(), i, std::min(i + fanout, _items.size()), true};
+        for (std::size_t j = node.begin; j != node.end; ++j)
+          expand(node.box, _boxes[_items[j]]);
+        level.push_back(_nodes.size());
+        _nodes.push_back(node);
+      }
+      // pack the levels upwards until a single root is left
+      while (level.size() > 1) {
+        strSort(level, fanout, [&](std::size_t i, int axis) { return centre(_nodes[i].box, axis); });
+        // the children of a node must be contiguous, so copy them in packed order
+        std::vector<Node> packed;
+        packed.reserve(level.size());
+        for (auto idx : level)
+          packed.push_back(_nodes[idx]);
+        std::size_t base = _nodes.size();
+        _nodes.insert(_nodes.end(), packed.begin(), packed.end());
+        std::vector<std::size_t> parents;
+        for (std::size_t i = 0; i < packed.size(); i += fanout) {
+          Node node{emptyBox(), base + i, base + std::min(i + fanout, packed.size()), false};
+          for (std::size_t j = node.begin; j != node.end; ++j)
+            expand(node.box, _nodes[j].box);
+          parents.push_back(_nodes.size());
+          _nodes.push_back(node);
+        }
+        level.swap(parents);
+      }
+      _root = level.front();
+    }
+
+    /**
+     * @brief the number of items
+     */
+    [[nodiscard]] inline std::size_t size() const { return _boxes.size(); }
+
+    /**
+     * @brief the box of the item
+     */
+    [[nodiscard]] inline const box_type &box(std::size_t item) const { return _boxes[item]; }
+
+    /**
+     * @brief visit the items whose boxes intersect the query box
+     *
+     * @param query the query box
+     * @param visit called as 'visit(item)', returning false stops the search
+     */
+    template <typename Visit>
+    void query(const box_type &query, Visit visit) const {
+      if (_nodes.empty())
+        return;
+      // deep enough for any tree with a fanout of at most 64
+      std::size_t stack[512];
+      std::size_t top = 0;
+      stack[top++] = _root;
+      while (top != 0) {
+        const auto &node = _nodes[stack[--top]];
+        if (!overlap(node.box, query))
+          continue;
+        if (node.leaf) {
+          for (std::size_t j = node.begin; j != node.end; ++j)
+            if (overlap(_boxes[_items[j]], query) && !visit(_items[j]))
+              return;
+        } else {
+          for (std::size_t j = node.begin; j != node.end; ++j)
+            stack[top++] = j;
+        }
+      }
+    }
+
+    /**
+     * @brief visit the items whose boxes contain the point
+     */
+    template <typename Visit>
+    void query(double x, double y, Visit visit) const {
+      this->query(box_type{x, y, x, y}, visit);
+    }
+
+    /**
+     * @brief collect the items whose boxes intersect the query box
+     */
+    [[nodiscard]] std::vector<std::size_t> query(const box_type &query) const {
+      std::vector<std::size_t> res;
+      this->query(query, [&res](std::size_t item) { res.push_back(item); return true; });
+      return res;
+    }
+
+    /**
+     * @brief find the item nearest to a point, searching the nodes best first
+     *
+     * @param distance called as 'distance(item)', the distance from the point to the item,
+     * which must not be less than the planar distance to the item's box
+     * @param best the distance of the nearest item, items beyond its initial value are ignored
+     * @return std::size_t the nearest item, 'size()' if there's none
+     */
+    template <typename Distance>
+    std::size_t nearest(double x, double y, Distance distance, double &best) const {
+      std::size_t res = this->size();
+      if (_nodes.empty())
+        return res;
+      // (lower bound, node or item, whether it's an item)
+      using entry_type = std::tuple<double, std::size_t, bool>;
+      std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> heap;
+      heap.push({boxDistance(_nodes[_root].box, x, y), _root, false});
+      while (!heap.empty()) {
+        auto [bound, idx, item] = heap.top();
+        heap.pop();
+        if (bound >= best)
+          break;
+        if (item) {
+          double d = distance(idx);
+          if (d < best)
+            best = d, res = idx;
+          continue;
+        }
+        const auto &node = _nodes[idx];
+        for (std::size_t j = node.begin; j != node.end; ++j) {
+          std::size_t child = node.leaf ? _items[j] : j;
+          double d = boxDistance(node.leaf ? _boxes[child] : _nodes[child].box, x, y);
+          if (d < best)
+            heap.push({d, child, node.leaf});
+        }
+      }
+      return res;
+    }
+
+    /**
+     * @brief the planar distance from a point to a box, zero inside
+     */
+    static inline double boxDistance(const box_type &box, double x, double y) {
+      double dx = std::max(0.0, std::max(box[0] - x, x - box[2]));
+      double dy = std::max(0.0, std::max(box[1] - y, y - box[3]));
+      return std::sqrt(dx * dx + dy * dy);
+    }
+
+    static inline box_type emptyBox() {
+      double inf = std::numeric_limits<double>::max();
+      return box_type{inf, inf, -inf, -inf};
+    }
+
+    static inline void expand(box_type &box, const box_type &other) {
+      box[0] = std::min(box[0], other[0]), box[1] = std::min(box[1], other[1]);
+      box[2] = std::max(box[2], other[2]), box[3] = std::max(box[3], other[3]);
+    }
+
+    static inline bool overlap(const box_type &a, const box_type &b) {
+      return a[0] <= b[2] && b[0] <= a[2] && a[1] <= b[3] && b[1] <= a[3];
+    }
+
+  protected:
+    /**
+     * @brief order the entries into vertical slices, each sorted by y (Sort-Tile-Recursive)
+     */
+    template <typename Centre>
+    static void strSort(std::vector<std::size_t> &entries, std::size_t fanout, Centre centre) {
+      std::size_t pages = (entries.size() + fanout - 1) / fanout;
+      auto slices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(pages))));
+      std::size_t sliceSize = slices * fanout;
+      std::sort(entries.begin(), entries.end(), [&](std::size_t a, std::size_t b) { return centre(a, 0) < centre(b, 0); });
+      for (std::size_t i = 0; i < entries.size(); i += sliceSize) {
+        auto end = entries.begin() + std::min(i + sliceSize, entries.size());
+        std::sort(entries.begin() + i, end, [&](std::size_t a, std::size_t b) { return centre(a, 1) < centre(b, 1); });
+      }
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
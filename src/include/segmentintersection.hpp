@@ -0,0 +1,360 @@
+#ifndef SEGMENTINTERSECTION_HPP
+#define SEGMENTINTERSECTION_HPP
+
+/**
+ * @file segmentintersection.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Report the crossings among large collections of segments
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "line.hpp"
+#include "linestring.hpp"
+#include "parallel.hpp"
+#include <limits>
+
+namespace ns_geo {
+#pragma region SegmentIntersector
+
+  /**
+   * @brief find every intersecting pair of segments in a collection of lines or line strings
+   *
+   * @attention the segments are bucketed into a uniform grid of tiles and each tile runs
+   * a small sweep over its own segments, so the tiles are processed in parallel.
+   * a segment is registered in every tile it passes through, and a pair sharing several
+   * tiles is only reported by the first of them in row-major order, so the result holds
+   * every pair exactly once. the consecutive segments of a line string touching at their
+   * shared vertex are not reported, but they are if they overlap.
+   */
+  template <typename Ty = float>
+  class SegmentIntersector {
+  public:
+    using value_type = Ty;
+    using id_type = uint;
+    using point_type = Point2<value_type>;
+    using line_type = Line2<value_type>;
+    using linestring_type = LineString2<value_type>;
+    using self_type = SegmentIntersector<value_type>;
+
+    /**
+     * @brief an intersecting pair of segments
+     *
+     * @attention for overlapping collinear segments the point is the start of the overlap
+     */
+    struct Crossing {
+      id_type first;
+      id_type second;
+      point_type point;
+    };
+
+  protected:
+    struct Segment {
+      double x0, y0, x1, y1;
+    };
+
+    std::vector<Segment> _segs;
+    // the line (string) every segment comes from, and the first segment id of each line string
+    std::vector<id_type> _owner;
+    std::vector<id_type> _starts;
+    std::vector<bool> _closed;
+    // the tiles, in the compressed row form
+    std::vector<std::size_t> _offset;
+    std::vector<id_type> _items;
+    double _xmin = 0.0, _ymin = 0.0, _invW = 0.0, _invH = 0.0, _cellW = 0.0, _cellH = 0.0, _pad = 0.0;
+    std::size_t _cols = 1, _rows = 1;
+
+  public:
+    /**
+     * @brief index the lines, the id of a segment is its index
+     */
+    explicit SegmentIntersector(const std::vector<line_type> &lines) {
+      _segs.reserve(lines.size());
+      for (const auto &line : lines) {
+        _owner.push_back(static_cast<id_type>(_segs.size()));
+        _segs.push_back(Segment{static_cast<double>(line.p1.x), static_cast<double>(line.p1.y),
+                                static_cast<double>(line.p2.x), static_cast<double>(line.p2.y)});
+      }
+      this->index();
+    }
+
+    /**
+     * @brief index the line strings, the segments are numbered string after string
+     */
+    explicit SegmentIntersector(const std::vector<linestring_type> &strings) {
+      for (std::size_t k = 0; k != strings.size(); ++k) {
+        const auto &ls = strings[k];
+        _starts.push_back(static_cast<id_type>(_segs.size()));
+        _closed.push_back(ls.size() > 3 && ls.front().x == ls.back().x && ls.front().y == ls.back().y);
+        for (std::size_t i = 1; i < ls.size(); ++i) {
+          _owner.push_back(static_cast<id_type>(k));
+          _segs.push_back(Segment{static_cast<double>(ls[i - 1].x), static_cast<double>(ls[i - 1].y),
+                                  static_cast<double>(ls[i].x), static_cast<double>(ls[i].y)});
+        }
+      }
+      _starts.push_back(static_cast<id_type>(_segs.size()));
+      this->index();
+    }
+
+    /**
+     * @brief the number of segments
+     */
+    [[nodiscard]] inline std::size_t size() const { return _segs.size(); }
+
+    /**
+     * @brief the segment of the id
+     */
+    [[nodiscard]] inline line_type segment(id_type id) const {
+      const auto &s = _segs[id];
+      return line_type(s.x0, s.y0, s.x1, s.y1);
+    }
+
+    /**
+     * @brief the (line string index, segment index in the string) of a segment id
+     *
+     * @attention for indexed lines it's simply (id, 0)
+     */
+    [[nodiscard]] std::pair<std::size_t, std::size_t> locate(id_type id) const {
+      if (_starts.empty())
+        return {id, 0};
+      return {_owner[id], id - _starts[_owner[id]]};
+    }
+
+    /**
+     * @brief every intersecting pair of segments
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::vector<Crossing> the pairs with 'first < second', ordered by the ids
+     */
+    [[nodiscard]] std::vector<Crossing> crossings(std::size_t threads = 0) const {
+      std::size_t tiles = _rows * _cols;
+      std::vector<std::vector<Crossing>> buffers(parallelWorkers(tiles, threads, 1));
+      std::vector<std::vector<id_type>> scratch(buffers.size());
+      parallelFor(
+          0, tiles, [&](std::size_t tile, std::size_t worker) { this->tileCrossings(tile, scratch[worker], buffers[worker]); },
+          threads, 1);
+      std::vector<Crossing> res;
+      std::size_t total = 0;
+      for (const auto &buf : buffers)
+        total += buf.size();
+      res.reserve(total);
+      for (const auto &buf : buffers)
+        res.insert(res.end(), buf.begin(), buf.end());
+      std::sort(res.begin(), res.end(), [](const Crossing &a, const Crossing &b) {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+      });
+      return res;
+    }
+
+    /**
+     * @brief intersect two segments
+     *
+     * @param p the intersection point, the start of the overlap for collinear segments
+     * @return int 0 if they are apart, 1 if they meet at a point, 2 if they overlap
+     */
+    static int intersect(const line_type &a, const line_type &b, point_type &p) {
+      double px, py;
+      int kind = intersect(Segment{static_cast<double>(a.p1.x), static_cast<double>(a.p1.y),
+                                   static_cast<double>(a.p2.x), static_cast<double>(a.p2.y)},
+                           Segment{static_cast<double>(b.p1.x), static_cast<double>(b.p1.y),
+                                   static_cast<double>(b.p2.x), static_cast<double>(b.p2.y)},
+                           px, py);
+      if (kind != 0)
+        p = point_type(static_cast<value_type>(px), static_cast<value_type>(py));
+      return kind;
+    }
+
+  protected:
+    static inline double cross(double ax, double ay, double bx, double by, double cx, double cy) {
+      return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    }
+
+    static inline bool lexLess(double ax, double ay, double bx, double by) {
+      return ax < bx || (ax == bx && ay < by);
+    }
+
+    static int intersect(const Segment &s, const Segment &t, double &px, double &py) {
+      double o1 = cross(s.x0, s.y0, s.x1, s.y1, t.x0, t.y0);
+      double o2 = cross(s.x0, s.y0, s.x1, s.y1, t.x1, t.y1);
+      double o3 = cross(t.x0, t.y0, t.x1, t.y1, s.x0, s.y0);
+      double o4 = cross(t.x0, t.y0, t.x1, t.y1, s.x1, s.y1);
+      if ((o1 > 0.0 && o2 > 0.0) || (o1 < 0.0 && o2 < 0.0) || (o3 > 0.0 && o4 > 0.0) || (o3 < 0.0 && o4 < 0.0))
+        return 0;
+      if (o1 == 0.0 && o2 == 0.0 && o3 == 0.0 && o4 == 0.0) {
+        // collinear, the lexicographic order runs along the common line
+        double sx0 = s.x0, sy0 = s.y0, sx1 = s.x1, sy1 = s.y1;
+        double tx0 = t.x0, ty0 = t.y0, tx1 = t.x1, ty1 = t.y1;
+        if (lexLess(sx1, sy1, sx0, sy0))
+          std::swap(sx0, sx1), std::swap(sy0, sy1);
+        if (lexLess(tx1, ty1, tx0, ty0))
+          std::swap(tx0, tx1), std::swap(ty0, ty1);
+        double bx = sx0, by = sy0, ex = sx1, ey = sy1;
+        if (lexLess(bx, by, tx0, ty0))
+          bx = tx0, by = ty0;
+        if (lexLess(tx1, ty1, ex, ey))
+          ex = tx1, ey = ty1;
+        if (lexLess(ex, ey, bx, by))
+          return 0;
+        px = bx, py = by;
+        return (bx == ex && by == ey) ? 1 : 2;
+      }
+      if (o1 == 0.0)
+        px = t.x0, py = t.y0;
+      else if (o2 == 0.0)
+        px = t.x1, py = t.y1;
+      else if (o3 == 0.0)
+        px = s.x0, py = s.y0;
+      else if (o4 == 0.0)
+        px = s.x1, py = s.y1;
+      else {
+        double r = o3 / (o3 - o4);
+        px = s.x0 + r * (s.x1 - s.x0), py = s.y0 + r * (s.y1 - s.y0);
+      }
+      return 1;
+    }
+
+    /**
+     * @brief whether two segments are consecutive in a line string
+     */
+    inline bool adjacent(id_type a, id_type b) const {
+      if (_starts.empty() || _owner[a] != _owner[b])
+        return false;
+      if (a > b)
+        std::swap(a, b);
+      if (b == a + 1)
+        return true;
+      auto k = _owner[a];
+      return _closed[k] && a == _starts[k] && b + 1 == _starts[k + 1];
+    }
+
+    static inline bool degenerate(const Segment &s) {
+      return s.x0 == s.x1 && s.y0 == s.y1;
+    }
+
+    void index() {
+      double xmax = std::numeric_limits<double>::lowest(), ymax = xmax;
+      _xmin = _ymin = std::numeric_limits<double>::max();
+      std::size_t n = 0;
+      for (const auto &s : _segs) {
+        if (degenerate(s))
+          continue;
+        ++n;
+        _xmin = std::min(_xmin, std::min(s.x0, s.x1)), xmax = std::max(xmax, std::max(s.x0, s.x1));
+        _ymin = std::min(_ymin, std::min(s.y0, s.y1)), ymax = std::max(ymax, std::max(s.y0, s.y1));
+      }
+      if (n == 0) {
+        _offset.assign(2, 0);
+        return;
+      }
+      // about four segments a tile
+      double w = xmax - _xmin, h = ymax - _ymin;
+      auto side = static_cast<std::size_t>(std::ceil(std::sqrt(n / 4.0)));
+      side = std::min<std::size_t>(std::max<std::size_t>(side, 1), 1024);
+      _cols = w > 0.0 ? side : 1, _rows = h > 0.0 ? side : 1;
+      _cellW = w / _cols, _cellH = h / _rows;
+      _invW = w > 0.0 ? _cols / w : 0.0, _invH = h > 0.0 ? _rows / h : 0.0;
+      // a little slack so a crossing computed on a tile border is found in its tile
+      _pad = 1E-9 * (w + h);
+
+      _offset.assign(_rows * _cols + 1, 0);
+      for (std::size_t i = 0; i != _segs.size(); ++i)
+        this->visitTiles(i, [this](std::size_t tile) { ++_offset[tile + 1]; });
+      for (std::size_t t = 0; t + 1 < _offset.size(); ++t)
+        _offset[t + 1] += _offset[t];
+      _items.resize(_offset.back());
+      std::vector<std::size_t> cursor(_offset.cbegin(), _offset.cend() - 1);
+      for (std::size_t i = 0; i != _segs.size(); ++i)
+        this->visitTiles(i, [&](std::size_t tile) { _items[cursor[tile]++] = static_cast<id_type>(i); });
+    }
+
+    inline std::size_t clampCell(double v, double lo, double inv, std::size_t num) const {
+      double c = (v - lo) * inv;
+      if (!(c > 0.0))
+        return 0;
+      return std::min(static_cast<std::size_t>(c), num - 1);
+    }
+
+    /**
+     * @brief the rows a segment passes through
+     */
+    inline void rowSpan(const Segment &s, std::size_t &r0, std::size_t &r1) const {
+      r0 = clampCell(std::min(s.y0, s.y1) - _pad, _ymin, _invH, _rows);
+      r1 = clampCell(std::max(s.y0, s.y1) + _pad, _ymin, _invH, _rows);
+    }
+
+    /**
+     * @brief the columns a segment passes through within a row
+     */
+    inline void colSpan(const Segment &s, std::size_t row, std::size_t &c0, std::size_t &c1) const {
+      double xa = std::min(s.x0, s.x1), xb = std::max(s.x0, s.x1);
+      if (_rows > 1 && s.y0 != s.y1) {
+        double lo = _ymin + row * _cellH - _pad, hi = _ymin + (row + 1) * _cellH + _pad;
+        double ya = std::max(lo, std::min(s.y0, s.y1)), yb = std::min(hi, std::max(s.y0, s.y1));
+        double k = (s.x1 - s.x0) / (s.y1 - s.y0);
+        double x0 = s.x0 + (ya - s.y0) * k, x1 = s.x0 + (yb - s.y0) * k;
+        xa = std::max(xa, std::min(x0, x1)), xb = std::min(xb, std::max(x0, x1));
+      }
+      c0 = clampCell(xa - _pad, _xmin, _invW, _cols);
+      c1 = clampCell(xb + _pad, _xmin, _invW, _cols);
+    }
+
+    template <typename Visit>
+    void visitTiles(std::size_t i, Visit visit) const {
+      const auto &s = _segs[i];
+      if (degenerate(s))
+        return;
+      std::size_t r0, r1, c0, c1;
+      rowSpan(s, r0, r1);
+      for (std::size_t r = r0; r <= r1; ++r) {
+        colSpan(s, r, c0, c1);
+        for (std::size_t c = c0; c <= c1; ++c)
+          visit(r * _cols + c);
+      }
+    }
+
+    /**
+     * @brief the first tile in row-major order shared by both segments
+     */
+    std::size_t firstSharedTile(const Segment &a, const Segment &b) const {
+      std::size_t ar0, ar1, br0, br1, ac0, ac1, bc0, bc1;
+      rowSpan(a, ar0, ar1), rowSpan(b, br0, br1);
+      for (std::size_t r = std::max(ar0, br0), end = std::min(ar1, br1); r <= end; ++r) {
+        colSpan(a, r, ac0, ac1), colSpan(b, r, bc0, bc1);
+        if (std::max(ac0, bc0) <= std::min(ac1, bc1))
+          return r * _cols + std::max(ac0, bc0);
+      }
+      return std::numeric_limits<std::size_t>::max();
+    }
+
+    void tileCrossings(std::size_t tile, std::vector<id_type> &ids, std::vector<Crossing> &out) const {
+      ids.assign(_items.cbegin() + _offset[tile], _items.cbegin() + _offset[tile + 1]);
+      if (ids.size() < 2)
+        return;
+      auto left = [this](id_type i) { return std::min(_segs[i].x0, _segs[i].x1); };
+      std::sort(ids.begin(), ids.end(), [&](id_type a, id_type b) { return left(a) < left(b); });
+      for (std::size_t i = 0; i != ids.size(); ++i) {
+        const auto &s = _segs[ids[i]];
+        double right = std::max(s.x0, s.x1), ylo = std::min(s.y0, s.y1), yhi = std::max(s.y0, s.y1);
+        for (std::size_t j = i + 1; j != ids.size() && left(ids[j]) <= right; ++j) {
+          const auto &t = _segs[ids[j]];
+          if (std::max(t.y0, t.y1) < ylo || std::min(t.y0, t.y1) > yhi)
+            continue;
+          double px, py;
+          int kind = intersect(s, t, px, py);
+          if (kind == 0 || (kind == 1 && this->adjacent(ids[i], ids[j])))
+            continue;
+          if (this->firstSharedTile(s, t) != tile)
+            continue;
+          auto a = std::min(ids[i], ids[j]), b = std::max(ids[i], ids[j]);
+          out.push_back(Crossing{a, b, point_type(static_cast<value_type>(px), static_cast<value_type>(py))});
+        }
+      }
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
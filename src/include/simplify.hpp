@@ -0,0 +1,331 @@
+#ifndef SIMPLIFY_HPP
+#define SIMPLIFY_HPP
+
+/**
+ * @file simplify.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Line string and polygon simplification
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "linestring.hpp"
+#include "parallel.hpp"
+#include "polygon.hpp"
+#include <limits>
+#include <queue>
+
+namespace ns_geo {
+#pragma region Simplifier
+
+  /**
+   * @brief the Douglas-Peucker and Visvalingam-Whyatt simplifications
+   *
+   * @attention the results are the ascending positions of the kept vertices in the input,
+   * so a reference line string is simplified by picking its point ids without copying points.
+   * the end points of a line string are always kept, and a polygon keeps at least three vertices.
+   * Douglas-Peucker runs on an explicit stack, Visvalingam on a heap, both O(n log n) typically.
+   */
+  template <typename Ty = float>
+  class Simplifier {
+  public:
+    using value_type = Ty;
+    using index_list = std::vector<std::size_t>;
+    using linestring2_type = LineString2<value_type>;
+    using linestring3_type = LineString3<value_type>;
+    using reflinestring2_type = RefLineString2<value_type>;
+    using reflinestring3_type = RefLineString3<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using self_type = Simplifier<value_type>;
+
+  protected:
+    using coord_type = std::array<double, 3>;
+
+  public:
+    /**
+     * @brief Douglas-Peucker, drop the vertices closer than 'tolerance' to the simplified line
+     */
+    static index_list douglasPeucker(const linestring2_type &ls, double tolerance) {
+      return dp(ls.size(), getter2(ls), tolerance, false);
+    }
+
+    static index_list douglasPeucker(const linestring3_type &ls, double tolerance) {
+      return dp(ls.size(), getter3(ls), tolerance, false);
+    }
+
+    static index_list douglasPeucker(const reflinestring2_type &ls, double tolerance) {
+      return dp(ls.size(), refGetter2(ls), tolerance, false);
+    }
+
+    static index_list douglasPeucker(const reflinestring3_type &ls, double tolerance) {
+      return dp(ls.size(), refGetter3(ls), tolerance, false);
+    }
+
+    /**
+     * @brief Douglas-Peucker for the closed ring of a polygon
+     */
+    static index_list douglasPeucker(const polygon_type &polygon, double tolerance) {
+      return dp(polygon.size(), getter2(polygon), tolerance, true);
+    }
+
+    /**
+     * @brief Visvalingam-Whyatt, drop the vertices whose effective triangle area is below 'minArea'
+     */
+    static index_list visvalingam(const linestring2_type &ls, double minArea) {
+      return vw(ls.size(), getter2(ls), minArea, false);
+    }
+
+    static index_list visvalingam(const linestring3_type &ls, double minArea) {
+      return vw(ls.size(), getter3(ls), minArea, false);
+    }
+
+    static index_list visvalingam(const reflinestring2_type &ls, double minArea) {
+      return vw(ls.size(), refGetter2(ls), minArea, false);
+    }
+
+    static index_list visvalingam(const reflinestring3_type &ls, double minArea) {
+      return vw(ls.size(), refGetter3(ls), minArea, false);
+    }
+
+    /**
+     * @brief Visvalingam-Whyatt for the closed ring of a polygon
+     */
+    static index_list visvalingam(const polygon_type &polygon, double minArea) {
+      return vw(polygon.size(), getter2(polygon), minArea, true);
+    }
+
+    /**
+     * @brief simplify a whole collection with Douglas-Peucker
+     *
+     * @param shapes the line strings or polygons
+     * @param tolerance the distance tolerance
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::vector<index_list> the kept positions of every shape
+     */
+    template <typename ShapeType>
+    static std::vector<index_list> douglasPeuckerBatch(const std::vector<ShapeType> &shapes, double tolerance,
+                                                       std::size_t threads = 0) {
+      std::vector<index_list> res(shapes.size());
+      parallelFor(
+          0, shapes.size(), [&](std::size_t i, std::size_t) { res[i] = douglasPeucker(shapes[i], tolerance); },
+          threads, 16);
+      return res;
+    }
+
+    /**
+     * @brief simplify a whole collection with Visvalingam-Whyatt
+     */
+    template <typename ShapeType>
+    static std::vector<index_list> visvalingamBatch(const std::vector<ShapeType> &shapes, double minArea,
+                                                    std::size_t threads = 0) {
+      std::vector<index_list> res(shapes.size());
+      parallelFor(
+          0, shapes.size(), [&](std::size_t i, std::size_t) { res[i] = visvalingam(shapes[i], minArea); },
+          threads, 16);
+      return res;
+    }
+
+    /**
+     * @brief copy the kept vertices of a line string or polygon
+     */
+    template <typename ShapeType>
+    static ShapeType pick(const ShapeType &shape, const index_list &kept) {
+      ShapeType res;
+      res.reserve(kept.size());
+      for (auto i : kept)
+        res.push_back(shape[i]);
+      return res;
+    }
+
+  protected:
+    template <typename ShapeType>
+    static auto getter2(const ShapeType &shape) {
+      return [&shape](std::size_t i) {
+        return coord_type{static_cast<double>(shape[i].x), static_cast<double>(shape[i].y), 0.0};
+      };
+    }
+
+    template <typename ShapeType>
+    static auto getter3(const ShapeType &shape) {
+      return [&shape](std::size_t i) {
+        return coord_type{static_cast<double>(shape[i].x), static_cast<double>(shape[i].y), static_cast<double>(shape[i].z)};
+      };
+    }
+
+    template <typename ShapeType>
+    static auto refGetter2(const ShapeType &shape) {
+      auto rps = shape.refPointSet();
+      return [&shape, rps](std::size_t i) {
+        const auto &p = rps->at(shape[i]);
+        return coord_type{static_cast<double>(p.x), static_cast<double>(p.y), 0.0};
+      };
+    }
+
+    template <typename ShapeType>
+    static auto refGetter3(const ShapeType &shape) {
+      auto rps = shape.refPointSet();
+      return [&shape, rps](std::size_t i) {
+        const auto &p = rps->at(shape[i]);
+        return coord_type{static_cast<double>(p.x), static_cast<double>(p.y), static_cast<double>(p.z)};
+      };
+    }
+
+    /**
+     * @brief the squared distance from 'p' to the segment 'ab'
+     */
+    static double segmentDistance2(const coord_type &p, const coord_type &a, const coord_type &b) {
+      double ab[3], ap[3], len2 = 0.0, dot = 0.0;
+      for (int k = 0; k != 3; ++k) {
+        ab[k] = b[k] - a[k], ap[k] = p[k] - a[k];
+        len2 += ab[k] * ab[k], dot += ab[k] * ap[k];
+      }
+      double t = len2 > 0.0 ? std::min(1.0, std::max(0.0, dot / len2)) : 0.0, d2 = 0.0;
+      for (int k = 0; k != 3; ++k)
+        d2 += (ap[k] - t * ab[k]) * (ap[k] - t * ab[k]);
+      return d2;
+    }
+
+    /**
+     * @brief the area of the triangle 'abc'
+     */
+    static double triangleArea(const coord_type &a, const coord_type &b, const coord_type &c) {
+      double u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      double v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      double x = u[1] * v[2] - u[2] * v[1], y = u[2] * v[0] - u[0] * v[2], z = u[0] * v[1] - u[1] * v[0];
+      return 0.5 * std::sqrt(x * x + y * y + z * z);
+    }
+
+    /**
+     * @brief mark the kept vertices of the open chain [first, last], where 'last' may be 'n' for a ring
+     */
+    template <typename Get>
+    static void dpChain(std::size_t first, std::size_t last, std::size_t n, Get &get, double tol2,
+                        std::vector<char> &keep, std::vector<std::pair<std::size_t, std::size_t>> &stack) {
+      stack.clear();
+      stack.push_back({first, last});
+      while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+        if (b - a < 2)
+          continue;
+        auto pa = get(a % n), pb = get(b % n);
+        double best = -1.0;
+        std::size_t far = a;
+        for (std::size_t i = a + 1; i != b; ++i) {
+          double d2 = segmentDistance2(get(i), pa, pb);
+          if (d2 > best)
+            best = d2, far = i;
+        }
+        if (best > tol2) {
+          keep[far] = 1;
+          stack.push_back({a, far});
+          stack.push_back({far, b});
+        }
+      }
+    }
+
+    template <typename Get>
+    static index_list dp(std::size_t n, Get get, double tolerance, bool ring) {
+      index_list res;
+      if (n <= (ring ? 3u : 2u)) {
+        for (std::size_t i = 0; i != n; ++i)
+          res.push_back(i);
+        return res;
+      }
+      double tol2 = tolerance * tolerance;
+      std::vector<char> keep(n, 0);
+      std::vector<std::pair<std::size_t, std::size_t>> stack;
+      keep[0] = 1;
+      if (!ring) {
+        keep[n - 1] = 1;
+        dpChain(0, n - 1, n, get, tol2, keep, stack);
+      } else {
+        // split the ring at the vertex farthest from the first one
+        auto p0 = get(0);
+        std::size_t far = 1;
+        double best = -1.0;
+        for (std::size_t i = 1; i != n; ++i) {
+          double d2 = segmentDistance2(get(i), p0, p0);
+          if (d2 > best)
+            best = d2, far = i;
+        }
+        keep[far] = 1;
+        dpChain(0, far, n, get, tol2, keep, stack);
+        dpChain(far, n, n, get, tol2, keep, stack);
+        if (std::count(keep.cbegin(), keep.cend(), 1) < 3) {
+          // keep a triangle at least
+          auto pf = get(far);
+          std::size_t third = 0;
+          best = -1.0;
+          for (std::size_t i = 1; i != n; ++i) {
+            double d2 = i == far ? -1.0 : segmentDistance2(get(i), p0, pf);
+            if (d2 > best)
+              best = d2, third = i;
+          }
+          keep[third] = 1;
+        }
+      }
+      for (std::size_t i = 0; i != n; ++i)
+        if (keep[i])
+          res.push_back(i);
+      return res;
+    }
+
+    template <typename Get>
+    static index_list vw(std::size_t n, Get get, double minArea, bool ring) {
+      index_list res;
+      if (n <= (ring ? 3u : 2u)) {
+        for (std::size_t i = 0; i != n; ++i)
+          res.push_back(i);
+        return res;
+      }
+      std::vector<coord_type> pts(n);
+      for (std::size_t i = 0; i != n; ++i)
+        pts[i] = get(i);
+      // a doubly linked list over the remaining vertices
+      std::vector<std::size_t> prev(n), next(n);
+      for (std::size_t i = 0; i != n; ++i)
+        prev[i] = (i + n - 1) % n, next[i] = (i + 1) % n;
+      std::vector<double> area(n, std::numeric_limits<double>::infinity());
+      std::vector<char> removed(n, 0);
+      using entry_type = std::pair<double, std::size_t>;
+      std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> heap;
+      auto interior = [&](std::size_t i) { return ring || (i != 0 && i != n - 1); };
+      for (std::size_t i = 0; i != n; ++i)
+        if (interior(i)) {
+          area[i] = triangleArea(pts[prev[i]], pts[i], pts[next[i]]);
+          heap.push({area[i], i});
+        }
+      std::size_t remain = n, floor = ring ? 3 : 2;
+      while (!heap.empty() && remain > floor) {
+        auto [a, i] = heap.top();
+        heap.pop();
+        // skip the stale entries
+        if (removed[i] || a != area[i])
+          continue;
+        if (a >= minArea)
+          break;
+        removed[i] = 1, --remain;
+        std::size_t p = prev[i], q = next[i];
+        next[p] = q, prev[q] = p;
+        // the effective area never drops below the one just removed
+        for (auto j : {p, q})
+          if (interior(j)) {
+            area[j] = std::max(a, triangleArea(pts[prev[j]], pts[j], pts[next[j]]));
+            heap.push({area[j], j});
+          }
+      }
+      res.reserve(remain);
+      for (std::size_t i = 0; i != n; ++i)
+        if (!removed[i])
+          res.push_back(i);
+      return res;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -33,39 +33,71 @@ namespace ns_geo {
       this->c = c / norm;
     }
 
-    SLine2(const point_type &p1, const point_type &p2) {
-      Eigen::MatrixXd A(2, 3);
-      A(0, 0) = p1.x, A(0, 1) = p1.y, A(0, 2) = 1;
-      A(1, 0) = p2.x, A(1, 1) = p2.y, A(1, 2) = 1;
-      Eigen::JacobiSVD<Eigen::MatrixXd> svd(A, Eigen::ComputeFullV);
-      Eigen::Matrix3d vMatrix = svd.matrixV();
-      Eigen::Vector3d param = vMatrix.col(vMatrix.cols() - 1);
-      a = param(0), b = param(1), c = param(2);
+    // the line through two points, their cross product in homogeneous coordinates, and the
+    // horizontal line through the point when they are the same
+    SLine2(const point_type &p1, const point_type &p2)
+        : SLine2(p1.x == p2.x && p1.y == p2.y ? SLine2(0.0, 1.0, -p1.y)
+                                              : SLine2(p1.y - p2.y, p2.x - p1.x, p1.x * p2.y - p2.x * p1.y)) {}
+
+    /**
+     * @brief the orthogonal (total least squares) line fit
+     *
+     * @param iter unused, the fit is in closed form
+     * @attention one pass sums the scatter of the points, and the line runs through their
+     * centroid along the major axis of the scatter, so vertical lines are fine as well. an
+     * empty set gives a line of NaNs
+     */
+    static self_type fit(const pointset_type &pts, [[maybe_unused]] const ushort iter = 10) {
+      return fit(pts.data(), pts.size());
     }
 
-    // Fit lines from points
-    static self_type fit(const pointset_type &pts, const ushort iter = 10) {
-      // ransac
-      self_type l = self_type::ransac(pts, iter);
-      // gauss newton [assign init value]
-      value_type k = -l.a / l.b, b = -l.c / l.b;
-      for (int i = 0; i != iter; ++i) {
-        Eigen::Matrix2d H = Eigen::Matrix2d::Zero();
-        Eigen::Vector2d g = Eigen::Vector2d::Zero();
-        for (const auto &p : pts) {
-          value_type x = p.x, y = p.y;
-          value_type d = (k * x - y + b) / std::sqrt(k * k + 1.0);
-          value_type jk = (x * (k * k + 1.0) - k * (k * x - y + b)) / std::pow(k * k + 1, 1.5);
-          value_type jb = 1.0 / std::sqrt(k * k + 1.0);
-          Eigen::Vector2d j(jk, jb);
-          H += j * j.transpose();
-          g -= j * d;
-        }
-        auto delta = H.ldlt().solve(g);
-        k += delta(0);
-        b += delta(1);
+    /**
+     * @brief the orthogonal line fit of the points 'pts[0, num)', it allocates nothing
+     */
+    static self_type fit(const point_type *pts, std::size_t num) {
+      const value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+      if (num == 0)
+        return self_type(nan, nan, nan);
+      value_type ox = pts[0].x, oy = pts[0].y;
+      value_type sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0;
+      for (std::size_t i = 0; i != num; ++i) {
+        value_type x = pts[i].x - ox, y = pts[i].y - oy;
+        sx += x, sy += y, sxx += x * x, sxy += x * y, syy += y * y;
       }
-      return self_type(k, -1.0, b);
+      value_type mx = sx / num, my = sy / num;
+      return principal(mx + ox, my + oy, sxx / num - mx * mx, sxy / num - mx * my, syy / num - my * my);
+    }
+
+    /**
+     * @brief the weighted orthogonal line fit
+     *
+     * @param weights the non-negative weight of each point
+     * @attention an empty set gives a line of NaNs
+     */
+    static self_type fit(const pointset_type &pts, const std::vector<value_type> &weights) {
+      const value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+      if (pts.empty())
+        return self_type(nan, nan, nan);
+      // the sums are taken relative to the first point against the cancellation
+      value_type ox = pts.front().x, oy = pts.front().y;
+      value_type sw = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0;
+      for (std::size_t i = 0; i != pts.size(); ++i) {
+        value_type w = weights[i], x = pts[i].x - ox, y = pts[i].y - oy;
+        sw += w, sx += w * x, sy += w * y, sxx += w * x * x, sxy += w * x * y, syy += w * y * y;
+      }
+      value_type mx = sx / sw, my = sy / sw;
+      return principal(mx + ox, my + oy, sxx / sw - mx * mx, sxy / sw - mx * my, syy / sw - my * my);
+    }
+
+    /**
+     * @brief the line through a centroid along the major axis of a scatter matrix
+     *
+     * @attention the normal is the eigenvector of the smaller eigenvalue, solved in closed form
+     */
+    static self_type principal(value_type mx, value_type my, value_type sxx, value_type sxy, value_type syy) {
+      value_type theta = 0.5 * std::atan2(2.0 * sxy, sxx - syy);
+      value_type a = -std::sin(theta), b = std::cos(theta);
+      return self_type(a, b, -(a * mx + b * my));
     }
 
     static self_type ransac(const pointset_type &pts, const ushort iter = 10) {
@@ -0,0 +1,152 @@
+#ifndef SPATIALJOIN_HPP
+#define SPATIALJOIN_HPP
+
+/**
+ * @file spatialjoin.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Assign points to the polygons containing them
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "preparedpolygon.hpp"
+#include "rtree.hpp"
+
+namespace ns_geo {
+#pragma region SpatialJoin
+
+  /**
+   * @brief a point-in-polygon join over a fixed set of polygons
+   *
+   * @attention an R-tree over the polygon boxes gives the candidates of a point and
+   * the prepared polygons settle the containment. when polygons overlap,
+   * a point goes to the one with the lowest index.
+   */
+  template <typename Ty = float>
+  class SpatialJoin {
+  public:
+    using value_type = Ty;
+    using id_type = uint;
+    using index_type = std::int32_t;
+    using pointset_type = PointSet2<value_type>;
+    using refpointset_type = RefPointSet2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using refpolygon_type = RefPolygon<value_type>;
+    using prepared_type = PreparedPolygon<value_type>;
+    using self_type = SpatialJoin<value_type>;
+
+    /**
+     * @brief the index of no polygon
+     */
+    static constexpr index_type NONE = -1;
+
+  private:
+    std::vector<prepared_type> _polys;
+    RTree _tree;
+
+  public:
+    /**
+     * @brief prepare the join for the polygons
+     */
+    explicit SpatialJoin(const std::vector<polygon_type> &polys)
+        : _polys(prepare(polys)), _tree(boxes(_polys)) {}
+
+    /**
+     * @brief prepare the join for the reference polygons
+     */
+    explicit SpatialJoin(const std::vector<refpolygon_type> &polys)
+        : _polys(prepare(polys)), _tree(boxes(_polys)) {}
+
+    /**
+     * @brief the number of polygons
+     */
+    [[nodiscard]] inline std::size_t size() const { return _polys.size(); }
+
+    /**
+     * @brief the index of the polygon containing the point, 'NONE' if there's none
+     */
+    [[nodiscard]] index_type locate(const Point2<value_type> &p) const {
+      double x = p.x, y = p.y;
+      index_type best = NONE;
+      _tree.query(x, y, [&](std::size_t i) {
+        if ((best == NONE || static_cast<index_type>(i) < best) && _polys[i].contains(x, y))
+          best = static_cast<index_type>(i);
+        return true;
+      });
+      return best;
+    }
+
+    /**
+     * @brief join a point set
+     *
+     * @param ps the points
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::vector<index_type> the polygon index of every point, 'NONE' for the outsiders
+     */
+    [[nodiscard]] std::vector<index_type> join(const pointset_type &ps, std::size_t threads = 0) const {
+      std::vector<index_type> res(ps.size());
+      // each task owns a disjoint range of the result
+      parallelFor(
+          0, ps.size(), [&](std::size_t i, std::size_t) { res[i] = this->locate(ps[i]); }, threads, 4096);
+      return res;
+    }
+
+    /**
+     * @brief join a reference point set
+     *
+     * @param rps the reference points
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::vector<std::pair<id_type, index_type>> the (point id, polygon index) pairs
+     * of the points inside any polygon, ordered by the point id
+     */
+    [[nodiscard]] std::vector<std::pair<id_type, index_type>> join(const refpointset_type &rps,
+                                                                   std::size_t threads = 0) const {
+      std::vector<const RefPoint2<value_type> *> pts;
+      pts.reserve(rps.size());
+      for (const auto &[id, p] : rps)
+        pts.push_back(&p);
+      const std::size_t grain = 4096;
+      // every worker collects into its own buffer, merged afterwards
+      std::vector<std::vector<std::pair<id_type, index_type>>> buffers(parallelWorkers(pts.size(), threads, grain));
+      parallelFor(
+          0, pts.size(), [&](std::size_t i, std::size_t worker) {
+            auto idx = this->locate(*pts[i]);
+            if (idx != NONE)
+              buffers[worker].push_back({pts[i]->id, idx});
+          },
+          threads, grain);
+      std::vector<std::pair<id_type, index_type>> res;
+      std::size_t total = 0;
+      for (const auto &buf : buffers)
+        total += buf.size();
+      res.reserve(total);
+      for (const auto &buf : buffers)
+        res.insert(res.end(), buf.begin(), buf.end());
+      std::sort(res.begin(), res.end());
+      return res;
+    }
+
+  protected:
+    template <typename PolygonType>
+    static std::vector<prepared_type> prepare(const std::vector<PolygonType> &polys) {
+      std::vector<prepared_type> prepared;
+      prepared.reserve(polys.size());
+      for (const auto &poly : polys)
+        prepared.emplace_back(poly);
+      return prepared;
+    }
+
+    static std::vector<RTree::box_type> boxes(const std::vector<prepared_type> &polys) {
+      std::vector<RTree::box_type> res(polys.size());
+      for (std::size_t i = 0; i != polys.size(); ++i)
+        res[i] = polys[i].bound();
+      return res;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
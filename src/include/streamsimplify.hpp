@@ -0,0 +1,178 @@
+#ifndef STREAMSIMPLIFY_HPP
+#define STREAMSIMPLIFY_HPP
+
+/**
+ * @file streamsimplify.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Online simplification of line strings arriving point by point
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "linestring.hpp"
+
+namespace ns_geo {
+#pragma region StreamSimplifier
+
+  /**
+   * @brief an opening-window simplifier with constant memory
+   *
+   * @attention every dropped point lies within 'tolerance' of the retained segment spanning it.
+   * instead of keeping the window, each point narrows a cone of directions from the anchor
+   * (the last retained vertex) the segment may take, so a point is handled in O(1).
+   * when a new point leaves the cone, or comes back nearer to the anchor than an earlier one,
+   * the previous point is retained and becomes the anchor.
+   */
+  template <typename Ty = float>
+  class StreamSimplifier {
+  public:
+    using value_type = Ty;
+    using point_type = Point2<value_type>;
+    using linestring_type = LineString2<value_type>;
+    using self_type = StreamSimplifier<value_type>;
+
+  private:
+    double _tol;
+    linestring_type _out;
+    std::size_t _retained = 0;
+    std::size_t _consumed = 0;
+    // the window: its anchor, its last point, and the cone of directions [_lo, _hi]
+    point_type _anchor, _last;
+    bool _hasAnchor = false, _hasLast = false, _constrained = false;
+    double _lo = 0.0, _hi = 0.0, _rmax = 0.0;
+
+  public:
+    /**
+     * @brief construct a simplifier
+     *
+     * @param tolerance the max distance from a dropped point to the retained line string
+     */
+    explicit StreamSimplifier(double tolerance) : _tol(tolerance) {}
+
+    /**
+     * @brief consume the next point
+     *
+     * @return bool whether a vertex was retained by this point
+     */
+    bool push(const point_type &p) {
+      ++_consumed;
+      if (!_hasAnchor) {
+        this->retain(p);
+        return true;
+      }
+      if (this->accept(p))
+        return false;
+      // the window can't take 'p', close it at the previous point
+      this->retain(_last);
+      this->accept(p);
+      return true;
+    }
+
+    /**
+     * @brief consume several points
+     */
+    template <typename Iter>
+    void push(Iter begin, Iter end) {
+      for (; begin != end; ++begin)
+        this->push(*begin);
+    }
+
+    /**
+     * @brief retain the last point, call it at the end of the stream
+     */
+    void finish() {
+      if (_hasLast)
+        this->retain(_last);
+    }
+
+    /**
+     * @brief the vertices retained since the last 'flush'
+     */
+    [[nodiscard]] inline const linestring_type &retained() const { return _out; }
+
+    /**
+     * @brief hand over the vertices retained so far, keeping the memory bounded on long streams
+     */
+    linestring_type flush() {
+      linestring_type res;
+      res.swap(_out);
+      return res;
+    }
+
+    /**
+     * @brief the number of points consumed
+     */
+    [[nodiscard]] inline std::size_t consumed() const { return _consumed; }
+
+    /**
+     * @brief the number of vertices retained in total
+     */
+    [[nodiscard]] inline std::size_t retainedNum() const { return _retained; }
+
+    /**
+     * @brief start a new stream
+     */
+    void reset() {
+      _out.clear();
+      _retained = _consumed = 0;
+      _hasAnchor = _hasLast = _constrained = false;
+    }
+
+    /**
+     * @brief simplify a whole line string at once
+     */
+    static linestring_type simplify(const linestring_type &ls, double tolerance) {
+      self_type ss(tolerance);
+      ss.push(ls.cbegin(), ls.cend());
+      ss.finish();
+      return ss.flush();
+    }
+
+  protected:
+    void retain(const point_type &p) {
+      _out.push_back(p);
+      ++_retained;
+      _anchor = p;
+      _hasAnchor = true;
+      _hasLast = _constrained = false;
+      _rmax = 0.0;
+    }
+
+    /**
+     * @brief try to extend the window to 'p', narrowing the cone on success
+     */
+    bool accept(const point_type &p) {
+      double dx = static_cast<double>(p.x) - _anchor.x, dy = static_cast<double>(p.y) - _anchor.y;
+      double r = std::sqrt(dx * dx + dy * dy);
+      // a repeat of the anchor changes nothing
+      if (r == 0.0)
+        return true;
+      double theta = std::atan2(dy, dx);
+      if (_constrained) {
+        // bring the direction next to the cone
+        double mid = 0.5 * (_lo + _hi);
+        theta += 2.0 * M_PI * std::round((mid - theta) / (2.0 * M_PI));
+      }
+      if (r < _rmax || (_constrained && (theta < _lo || theta > _hi)))
+        return false;
+      if (r > _tol) {
+        // the points near the anchor are within the tolerance of any segment from it
+        _rmax = r;
+        double half = std::asin(_tol / r);
+        if (!_constrained)
+          _lo = theta - half, _hi = theta + half, _constrained = true;
+        else
+          _lo = std::max(_lo, theta - half), _hi = std::min(_hi, theta + half);
+      }
+      _last = p;
+      _hasLast = true;
+      return true;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
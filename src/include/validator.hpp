@@ -0,0 +1,367 @@
+#ifndef VALIDATOR_HPP
+#define VALIDATOR_HPP
+
+/**
+ * @file validator.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Check polygons for self-intersections, orientation, duplicate vertices and spikes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "parallel.hpp"
+#include "polygon.hpp"
+#include <set>
+
+namespace ns_geo {
+#pragma region PolygonValidator
+
+  enum class Orientation {
+    COUNTER_CLOCKWISE,
+    CLOCKWISE,
+    /**
+     * @brief less than three distinct vertices or no area at all
+     */
+    DEGENERATE
+  };
+
+  /**
+   * @brief what the validator found in a polygon, the indices refer to its vertices
+   */
+  struct ValidityReport {
+    Orientation orientation = Orientation::DEGENERATE;
+    /**
+     * @brief the vertices repeating their predecessor, the first one repeating the last
+     */
+    std::vector<std::size_t> duplicates;
+    /**
+     * @brief the vertices where the boundary turns straight back on itself
+     */
+    std::vector<std::size_t> spikes;
+    /**
+     * @brief whether two non-adjacent edges meet, touching included
+     */
+    bool selfIntersecting = false;
+    /**
+     * @brief the start vertices of the first two edges found meeting
+     */
+    std::array<std::size_t, 2> crossing{0, 0};
+
+    /**
+     * @brief a valid polygon is simple, free of spikes and has an area
+     *
+     * @attention duplicate vertices alone don't make a polygon invalid, 'removeDuplicates' drops them
+     */
+    [[nodiscard]] inline bool valid() const {
+      return orientation != Orientation::DEGENERATE && !selfIntersecting && spikes.empty();
+    }
+  };
+
+  /**
+   * @brief validate polygons before they go into 'area', the clipper or the triangulators
+   *
+   * @attention the self-intersection test is the Shamos-Hoey sweep, O(n log n) for n vertices:
+   * the edges enter and leave an ordered status by their end points, and only the neighbors in it
+   * are tested, stopping at the first pair found. small polygons skip the sweep and test all the
+   * pairs. the validator keeps no state, so one validator serves any number of threads.
+   */
+  template <typename Ty = float>
+  class PolygonValidator {
+  public:
+    using value_type = Ty;
+    using polygon_type = Polygon<value_type>;
+    using refpolygon_type = RefPolygon<value_type>;
+    using self_type = PolygonValidator<value_type>;
+
+  protected:
+    struct Edge {
+      // the left (lexicographically smaller) and the right end
+      double lx, ly, rx, ry;
+      // the position of the edge along the deduplicated ring
+      std::size_t pos;
+    };
+
+    // the rings with at most this many edges test all the pairs
+    static constexpr std::size_t BRUTE_FORCE = 32;
+
+  public:
+    /**
+     * @brief check a polygon
+     */
+    static ValidityReport check(const polygon_type &polygon) {
+      std::vector<double> xs(polygon.size()), ys(polygon.size());
+      for (std::size_t i = 0; i != polygon.size(); ++i)
+        xs[i] = polygon[i].x, ys[i] = polygon[i].y;
+      return check(xs, ys);
+    }
+
+    static ValidityReport check(const refpolygon_type &polygon) {
+      std::vector<double> xs(polygon.size()), ys(polygon.size());
+      for (std::size_t i = 0; i != polygon.size(); ++i) {
+        const auto &p = polygon.refPointSet()->at(polygon[i]);
+        xs[i] = p.x, ys[i] = p.y;
+      }
+      return check(xs, ys);
+    }
+
+    /**
+     * @brief check many polygons
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     */
+    static std::vector<ValidityReport> check(const std::vector<polygon_type> &polygons, std::size_t threads = 0) {
+      std::vector<ValidityReport> res(polygons.size());
+      parallelFor(
+          0, polygons.size(), [&](std::size_t i, std::size_t) { res[i] = check(polygons[i]); }, threads, 64);
+      return res;
+    }
+
+    /**
+     * @brief whether the polygon is valid, see 'ValidityReport::valid'
+     */
+    static bool isValid(const polygon_type &polygon) { return check(polygon).valid(); }
+
+    /**
+     * @brief whether no two non-adjacent edges meet
+     */
+    static bool isSimple(const polygon_type &polygon) { return !check(polygon).selfIntersecting; }
+
+    /**
+     * @brief the orientation by the sign of the shoelace sum
+     */
+    static Orientation orientation(const polygon_type &polygon) {
+      double s = 0.0;
+      for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        s += static_cast<double>(polygon[j].x) * polygon[i].y - static_cast<double>(polygon[i].x) * polygon[j].y;
+      return s > 0.0 ? Orientation::COUNTER_CLOCKWISE : (s < 0.0 ? Orientation::CLOCKWISE : Orientation::DEGENERATE);
+    }
+
+    /**
+     * @brief reverse the polygon in place if it doesn't wind the wanted way
+     *
+     * @return bool whether it was reversed
+     */
+    static bool fixOrientation(polygon_type &polygon, bool counterClockwise = true) {
+      auto o = orientation(polygon);
+      if (o == Orientation::DEGENERATE || (o == Orientation::COUNTER_CLOCKWISE) == counterClockwise)
+        return false;
+      std::reverse(polygon.begin(), polygon.end());
+      return true;
+    }
+
+    static bool fixOrientation(refpolygon_type &polygon, bool counterClockwise = true) {
+      double s = 0.0;
+      const auto *rps = polygon.refPointSet();
+      for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const auto &pi = rps->at(polygon[i]), &pj = rps->at(polygon[j]);
+        s += static_cast<double>(pj.x) * pi.y - static_cast<double>(pi.x) * pj.y;
+      }
+      if (s == 0.0 || (s > 0.0) == counterClockwise)
+        return false;
+      std::reverse(polygon.begin(), polygon.end());
+      return true;
+    }
+
+    /**
+     * @brief drop the vertices repeating their predecessor
+     *
+     * @return std::size_t the number of vertices dropped
+     */
+    static std::size_t removeDuplicates(polygon_type &polygon) {
+      std::size_t n = polygon.size();
+      auto last = std::unique(polygon.begin(), polygon.end(), [](const auto &p, const auto &q) {
+        return p.x == q.x && p.y == q.y;
+      });
+      polygon.erase(last, polygon.end());
+      while (polygon.size() > 1 && polygon.front().x == polygon.back().x && polygon.front().y == polygon.back().y)
+        polygon.pop_back();
+      return n - polygon.size();
+    }
+
+  protected:
+    static inline double cross(double ax, double ay, double bx, double by, double cx, double cy) {
+      return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    }
+
+    static ValidityReport check(const std::vector<double> &xs, const std::vector<double> &ys) {
+      ValidityReport rep;
+      std::size_t n = xs.size();
+      // the distinct vertices along the ring
+      std::vector<std::size_t> ring;
+      for (std::size_t i = 0; i != n; ++i) {
+        std::size_t prev = (i + n - 1) % n;
+        if (n > 1 && xs[i] == xs[prev] && ys[i] == ys[prev])
+          rep.duplicates.push_back(i);
+        else
+          ring.push_back(i);
+      }
+      // all the vertices are the same point
+      if (ring.empty() && n != 0)
+        ring.push_back(0);
+      std::size_t m = ring.size();
+      if (m < 3)
+        return rep;
+
+      double s = 0.0;
+      for (std::size_t k = 0; k != m; ++k) {
+        std::size_t i = ring[k], j = ring[(k + 1) % m];
+        s += xs[i] * ys[j] - xs[j] * ys[i];
+      }
+      rep.orientation = s > 0.0 ? Orientation::COUNTER_CLOCKWISE
+                                : (s < 0.0 ? Orientation::CLOCKWISE : Orientation::DEGENERATE);
+
+      for (std::size_t k = 0; k != m; ++k) {
+        std::size_t a = ring[(k + m - 1) % m], b = ring[k], c = ring[(k + 1) % m];
+        double ux = xs[b] - xs[a], uy = ys[b] - ys[a], vx = xs[c] - xs[b], vy = ys[c] - ys[b];
+        if (ux * vy - uy * vx == 0.0 && ux * vx + uy * vy < 0.0)
+          rep.spikes.push_back(b);
+      }
+
+      std::vector<Edge> edges(m);
+      for (std::size_t k = 0; k != m; ++k) {
+        std::size_t i = ring[k], j = ring[(k + 1) % m];
+        bool forward = xs[i] < xs[j] || (xs[i] == xs[j] && ys[i] < ys[j]);
+        edges[k] = forward ? Edge{xs[i], ys[i], xs[j], ys[j], k} : Edge{xs[j], ys[j], xs[i], ys[i], k};
+      }
+      std::array<std::size_t, 2> hit{};
+      if (m <= BRUTE_FORCE ? allPairs(edges, hit) : sweep(edges, hit)) {
+        rep.selfIntersecting = true;
+        rep.crossing = {ring[std::min(hit[0], hit[1])], ring[std::max(hit[0], hit[1])]};
+      }
+      return rep;
+    }
+
+    static inline bool adjacent(const Edge &a, const Edge &b, std::size_t m) {
+      std::size_t d = a.pos > b.pos ? a.pos - b.pos : b.pos - a.pos;
+      return d == 1 || d == m - 1;
+    }
+
+    static inline bool onSegment(const Edge &e, double x, double y) {
+      return std::min(e.lx, e.rx) <= x && x <= std::max(e.lx, e.rx) && std::min(e.ly, e.ry) <= y &&
+             y <= std::max(e.ly, e.ry);
+    }
+
+    /**
+     * @brief whether two edges share any point
+     */
+    static bool meet(const Edge &a, const Edge &b) {
+      double d1 = cross(b.lx, b.ly, b.rx, b.ry, a.lx, a.ly), d2 = cross(b.lx, b.ly, b.rx, b.ry, a.rx, a.ry);
+      double d3 = cross(a.lx, a.ly, a.rx, a.ry, b.lx, b.ly), d4 = cross(a.lx, a.ly, a.rx, a.ry, b.rx, b.ry);
+      if (((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) && ((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0)))
+        return true;
+      return (d1 == 0.0 && onSegment(b, a.lx, a.ly)) || (d2 == 0.0 && onSegment(b, a.rx, a.ry)) ||
+             (d3 == 0.0 && onSegment(a, b.lx, b.ly)) || (d4 == 0.0 && onSegment(a, b.rx, b.ry));
+    }
+
+    static bool allPairs(const std::vector<Edge> &edges, std::array<std::size_t, 2> &hit) {
+      std::size_t m = edges.size();
+      for (std::size_t i = 0; i != m; ++i)
+        for (std::size_t j = i + 2; j < m; ++j)
+          if (!adjacent(edges[i], edges[j], m) && meet(edges[i], edges[j])) {
+            hit = {i, j};
+            return true;
+          }
+      return false;
+    }
+
+    /**
+     * @brief the order of two edges in the status, both crossing the sweep line and not meeting
+     * any other edge before it
+     */
+    struct Below {
+      const std::vector<Edge> *edges;
+
+      bool operator()(std::size_t i, std::size_t j) const {
+        if (i == j)
+          return false;
+        const Edge &a = (*edges)[i], &b = (*edges)[j];
+        // tell where the edge starting later lies against the other one
+        bool bLater = a.lx < b.lx || (a.lx == b.lx && a.ly < b.ly);
+        const Edge &base = bLater ? a : b, &later = bLater ? b : a;
+        double s = cross(base.lx, base.ly, base.rx, base.ry, later.lx, later.ly);
+        if (s == 0.0)
+          s = cross(base.lx, base.ly, base.rx, base.ry, later.rx, later.ry);
+        if (s == 0.0)
+          return i < j;
+        // 'later' lies above 'base' for a positive turn
+        return bLater ? s > 0.0 : s < 0.0;
+      }
+    };
+
+    static bool sweep(const std::vector<Edge> &edges, std::array<std::size_t, 2> &hit) {
+      std::size_t m = edges.size();
+      // the end points of the edges, the left ones before the right ones at the same point
+      std::vector<std::pair<std::size_t, bool>> events;
+      events.reserve(2 * m);
+      for (std::size_t k = 0; k != m; ++k)
+        events.emplace_back(k, true), events.emplace_back(k, false);
+      auto at = [&edges](const std::pair<std::size_t, bool> &e) {
+        const Edge &edge = edges[e.first];
+        return e.second ? std::make_pair(edge.lx, edge.ly) : std::make_pair(edge.rx, edge.ry);
+      };
+      std::sort(events.begin(), events.end(), [&at](const auto &e1, const auto &e2) {
+        auto p1 = at(e1), p2 = at(e2);
+        if (p1 != p2)
+          return p1 < p2;
+        return e1.second && !e2.second;
+      });
+
+      auto test = [&edges, &hit, m](std::size_t i, std::size_t j) {
+        if (adjacent(edges[i], edges[j], m) || !meet(edges[i], edges[j]))
+          return false;
+        hit = {i, j};
+        return true;
+      };
+      using status_type = std::set<std::size_t, Below>;
+      status_type status(Below{&edges});
+      std::vector<typename status_type::iterator> where(m);
+      // the first edge from 'it' on, downwards or upwards, that isn't next to 'k' along the ring.
+      // a spike retraces the edge before it, and then lies in the status between that edge
+      // and the one after the spike, which touches it
+      auto beyond = [&status, &edges, m](typename status_type::iterator it, bool up, std::size_t k) {
+        while (it != status.end()) {
+          if (!adjacent(edges[*it], edges[k], m))
+            return it;
+          if (up)
+            ++it;
+          else
+            it = it == status.begin() ? status.end() : std::prev(it);
+        }
+        return it;
+      };
+      for (const auto &e : events) {
+        std::size_t k = e.first;
+        if (e.second) {
+          auto it = status.insert(k).first;
+          where[k] = it;
+          auto lo = it == status.begin() ? status.end() : beyond(std::prev(it), false, k);
+          if (lo != status.end() && test(*lo, k))
+            return true;
+          auto hi = beyond(std::next(it), true, k);
+          if (hi != status.end() && test(k, *hi))
+            return true;
+        } else {
+          auto it = where[k];
+          auto next = std::next(it);
+          if (it != status.begin() && next != status.end()) {
+            auto prev = std::prev(it);
+            auto hi = beyond(next, true, *prev);
+            if (hi != status.end() && test(*prev, *hi))
+              return true;
+            auto lo = adjacent(edges[*prev], edges[*next], m) ? beyond(prev, false, *next) : status.end();
+            if (lo != status.end() && test(*lo, *next))
+              return true;
+          }
+          status.erase(it);
+        }
+      }
+      return false;
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef VORONOI_HPP
+#define VORONOI_HPP
+
+/**
+ * @file voronoi.hpp
+ * @author csl (3079625093@qq.com)
+ * @brief Voronoi diagram derived from the Delaunay triangulation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "delaunay.hpp"
+#include "parallel.hpp"
+#include "polygon.hpp"
+#include "rectangle.hpp"
+
+namespace ns_geo {
+#pragma region Voronoi2
+
+  /**
+   * @brief the Voronoi cells of reference point sites, clipped to a rectangle
+   *
+   * @attention the cell corners are the circumcentres of the Delaunay triangles around a site.
+   * they are computed for the whole mesh in one pass, while a cell is only assembled
+   * when it's asked for, so querying a few sites is cheap. the cells of the hull sites close
+   * at the circumcentres of the super vertices, which are placed far enough that the bound
+   * never reaches the cells of the super vertices, so a cell is only ever cut by the bound.
+   */
+  template <typename Ty = float>
+  class Voronoi2 {
+  public:
+    using value_type = Ty;
+    using id_type = uint;
+    using refpointset_type = RefPointSet2<value_type>;
+    using polygon_type = Polygon<value_type>;
+    using rectangle_type = Rectangle<value_type>;
+    using self_type = Voronoi2<value_type>;
+
+  private:
+    Delaunay2<value_type> _dt;
+    // the circumcentres of the mesh facets (relative to the triangulation's origin)
+    std::vector<double> _cx;
+    std::vector<double> _cy;
+    // the clipping bound (relative to the triangulation's origin)
+    double _xmin, _xmax, _ymin, _ymax;
+
+  public:
+    /**
+     * @brief construct a new Voronoi2 object
+     *
+     * @param sites the sites
+     * @param bound the rectangle the cells are clipped to
+     */
+    Voronoi2(const refpointset_type &sites, const rectangle_type &bound) : _dt(sites) {
+      const auto &o = _dt._origin;
+      _xmin = std::min<double>(bound.topLeftPt.x, bound.bottomRightPt.x) - o.x;
+      _xmax = std::max<double>(bound.topLeftPt.x, bound.bottomRightPt.x) - o.x;
+      _ymin = std::min<double>(bound.topLeftPt.y, bound.bottomRightPt.y) - o.y;
+      _ymax = std::max<double>(bound.topLeftPt.y, bound.bottomRightPt.y) - o.y;
+      this->computeCentres();
+    }
+
+    /**
+     * @brief the underlying Delaunay triangulation
+     */
+    inline const Delaunay2<value_type> &delaunay() const { return _dt; }
+
+    /**
+     * @brief the clipped cell of the site
+     *
+     * @param id the id of the site
+     * @return polygon_type the counter-clockwise cell, empty for a duplicated site
+     * or when the cell lies outside the bound
+     * @throw std::out_of_range if there is no such site
+     */
+    polygon_type cellOf(id_type id) const {
+      int v = _dt._vertexOf.at(id);
+      int start = _dt._facetOf[v];
+      polygon_type cell;
+      if (start < 0)
+        return cell;
+      // walk the fan of facets around the site counter-clockwise
+      std::vector<std::pair<double, double>> ring;
+      int f = start;
+      do {
+        ring.push_back({_cx[f], _cy[f]});
+        const auto &fa = _dt._facets[f];
+        int i = fa.v[0] == v ? 0 : (fa.v[1] == v ? 1 : 2);
+        f = fa.n[(i + 1) % 3];
+      } while (f != start && f >= 0);
+      this->clip(ring);
+      const auto &o = _dt._origin;
+      cell.reserve(ring.size());
+      for (const auto &[x, y] : ring)
+        cell.push_back(Point2<value_type>(static_cast<value_type>(x + o.x), static_cast<value_type>(y + o.y)));
+      return cell;
+    }
+
+    /**
+     * @brief the clipped cells of all the sites
+     *
+     * @param threads the number of threads, zero means all hardware threads
+     * @return std::unordered_map<id_type, polygon_type> the cells keyed by site id
+     */
+    std::unordered_map<id_type, polygon_type> cells(std::size_t threads = 0) const {
+      const auto &ids = _dt._ids;
+      std::vector<polygon_type> polys(ids.size());
+      parallelFor(
+          0, ids.size(), [&](std::size_t i, std::size_t) { polys[i] = this->cellOf(ids[i]); },
+          threads, 256);
+      std::unordered_map<id_type, polygon_type> res;
+      res.reserve(ids.size());
+      for (std::size_t i = 0; i != ids.size(); ++i)
+        res.emplace(ids[i], std::move(polys[i]));
+      return res;
+    }
+
+  protected:
+    /**
+     * @brief the circumcentres of all the facets in a single sweep
+     */
+    void computeCentres() {
+      const auto &facets = _dt._facets;
+      const auto &x = _dt._x, &y = _dt._y;
+      // a point of the bound lies within 'reach' of the origin and so within twice that of its
+      // site, while a super vertex 'big' away lies over 'big - reach' from it, so the super
+      // vertices are moved out to four times the reach when the bound is far
+      const int s = static_cast<int>(_dt._siteNum);
+      double reach = 0.0;
+      for (int i = 0; i != s; ++i)
+        reach = std::max(reach, std::hypot(x[i], y[i]));
+      for (double bx : {_xmin, _xmax})
+        for (double by : {_ymin, _ymax})
+          reach = std::max(reach, std::hypot(bx, by));
+      // the third super vertex is at '(0, big)'
+      const double big = std::max(y[s + 2], 4.0 * reach);
+      auto vx = [&](int v) { return v < s ? x[v] : big * Delaunay2<value_type>::SUPER_X[v - s]; };
+      auto vy = [&](int v) { return v < s ? y[v] : big * Delaunay2<value_type>::SUPER_Y[v - s]; };
+      std::size_t n = facets.size();
+      _cx.resize(n), _cy.resize(n);
+      for (std::size_t i = 0; i != n; ++i) {
+        const auto &v = facets[i].v;
+        double ax = vx(v[0]), ay = vy(v[0]);
+        double bx = vx(v[1]) - ax, by = vy(v[1]) - ay;
+        double cx = vx(v[2]) - ax, cy = vy(v[2]) - ay;
+        double b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+        double d = 0.5 / (bx * cy - by * cx);
+        _cx[i] = ax + (cy * b2 - by * c2) * d;
+        _cy[i] = ay + (bx * c2 - cx * b2) * d;
+      }
+    }
+
+    /**
+     * @brief clip a convex ring against the bound (Sutherland-Hodgman)
+     */
+    void clip(std::vector<std::pair<double, double>> &ring) const {
+      std::vector<std::pair<double, double>> out;
+      // the four sides as 'value(p) >= 0' with value = sign * (coordinate - limit)
+      const double limits[4] = {_xmin, _xmax, _ymin, _ymax};
+      const double signs[4] = {1.0, -1.0, 1.0, -1.0};
+      for (int side = 0; side != 4 && !ring.empty(); ++side) {
+        bool isX = side < 2;
+        auto value = [&](const std::pair<double, double> &p) {
+          return signs[side] * ((isX ? p.first : p.second) - limits[side]);
+        };
+        out.clear();
+        for (std::size_t i = 0; i != ring.size(); ++i) {
+          const auto &cur = ring[i], &nxt = ring[(i + 1) % ring.size()];
+          double vc = value(cur), vn = value(nxt);
+          if (vc >= 0.0)
+            out.push_back(cur);
+          if ((vc >= 0.0) != (vn >= 0.0)) {
+            double t = vc / (vc - vn);
+            out.push_back({cur.first + t * (nxt.first - cur.first),
+                           cur.second + t * (nxt.second - cur.second)});
+          }
+        }
+        ring.swap(out);
+      }
+    }
+  };
+
+#pragma endregion
+} // namespace ns_geo
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef TEST_BATCHFIT_H
+#define TEST_BATCHFIT_H
+
+#include "helper.h"
+#include "include/batchfit.hpp"
+
+TEST(BatchFitter, lines) {
+  std::uniform_int_distribution<std::size_t> size(2, 40);
+  std::uniform_real_distribution<double> u(-50.0, 50.0), angle(0.0, M_PI);
+  std::normal_distribution<double> noise(0.0, 0.05);
+  ns_geo::PointSet2d ps;
+  std::vector<std::size_t> sizes;
+  for (int k = 0; k != 5000; ++k) {
+    sizes.push_back(size(ns_geo::engine));
+    double ox = u(ns_geo::engine), oy = u(ns_geo::engine), theta = angle(ns_geo::engine);
+    for (std::size_t i = 0; i != sizes.back(); ++i) {
+      double t = u(ns_geo::engine) * 0.1;
+      ps.push_back({ox + t * std::cos(theta) + noise(ns_geo::engine), oy + t * std::sin(theta) + noise(ns_geo::engine)});
+    }
+  }
+  auto offsets = ns_geo::BatchFitter::offsets(sizes);
+  ASSERT_EQ(offsets.back(), ps.size());
+  std::vector<ns_geo::SLine2> out;
+  ns_geo::BatchFitter::lines(ps, offsets, out, 4);
+  ASSERT_EQ(out.size(), sizes.size());
+  for (std::size_t k = 0; k != sizes.size(); ++k) {
+    auto line = ns_geo::SLine2::fit(ns_geo::PointSet2d(ps.begin() + offsets[k], ps.begin() + offsets[k + 1]));
+    EXPECT_DOUBLE_EQ(out[k].a, line.a);
+    EXPECT_DOUBLE_EQ(out[k].b, line.b);
+    EXPECT_DOUBLE_EQ(out[k].c, line.c);
+  }
+  // the models are written in place
+  const auto *data = out.data();
+  ns_geo::BatchFitter::lines(ps, offsets, out, 1);
+  EXPECT_EQ(out.data(), data);
+  // and a longer one is cut to the clusters
+  offsets.resize(11);
+  ns_geo::BatchFitter::lines(ps, offsets, out, 1);
+  EXPECT_EQ(out.size(), 10);
+  EXPECT_EQ(out.data(), data);
+}
+
+TEST(BatchFitter, circles) {
+  std::uniform_int_distribution<std::size_t> size(3, 30);
+  std::uniform_real_distribution<double> u(-50.0, 50.0), rad(0.5, 5.0), theta(0.0, 2.0 * M_PI);
+  std::normal_distribution<double> noise(0.0, 0.02);
+  ns_geo::PointSet2d ps;
+  std::vector<std::size_t> sizes;
+  std::vector<ns_geo::Circle> truth;
+  for (int k = 0; k != 3000; ++k) {
+    sizes.push_back(size(ns_geo::engine));
+    truth.emplace_back(ns_geo::Point2d(u(ns_geo::engine), u(ns_geo::engine)), rad(ns_geo::engine));
+    for (std::size_t i = 0; i != sizes.back(); ++i) {
+      double t = theta(ns_geo::engine);
+      ps.push_back({truth.back().cen.x + truth.back().rad * std::cos(t) + noise(ns_geo::engine),
+                    truth.back().cen.y + truth.back().rad * std::sin(t) + noise(ns_geo::engine)});
+    }
+  }
+  auto offsets = ns_geo::BatchFitter::offsets(sizes);
+  std::vector<ns_geo::Circle> out(sizes.size(), ns_geo::Circle({0.0, 0.0}, 0.0));
+  ns_geo::BatchFitter::circles(ps, offsets, out, 10, 3);
+  std::size_t close = 0;
+  for (std::size_t k = 0; k != sizes.size(); ++k) {
+    auto cir = ns_geo::Circle::fit(ns_geo::PointSet2d(ps.begin() + offsets[k], ps.begin() + offsets[k + 1]));
+    EXPECT_DOUBLE_EQ(out[k].cen.x, cir.cen.x);
+    EXPECT_DOUBLE_EQ(out[k].cen.y, cir.cen.y);
+    EXPECT_DOUBLE_EQ(out[k].rad, cir.rad);
+    close += std::abs(out[k].rad - truth[k].rad) < 0.1;
+  }
+  EXPECT_GT(close, sizes.size() * 9 / 10);
+
+  // no clusters
+  std::vector<ns_geo::Circle> none;
+  ns_geo::BatchFitter::circles(ps, {0}, none);
+  ns_geo::BatchFitter::circles(ps, {}, none);
+  EXPECT_TRUE(none.empty());
+}
+
+#endif
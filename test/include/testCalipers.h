@@ -0,0 +1,90 @@
+#ifndef TEST_CALIPERS_H
+#define TEST_CALIPERS_H
+
+#include "helper.h"
+#include "include/calipers.hpp"
+
+using RotatingCalipersd = ns_geo::RotatingCalipers<double>;
+
+TEST(RotatingCalipers, square) {
+  // a rotated square with points inside and on its edges
+  ns_geo::PointSet2d ps{{0.0, 1.0}, {1.0, 0.0}, {2.0, 1.0}, {1.0, 2.0}, {1.0, 1.0}, {0.5, 0.5}, {1.2, 0.9}};
+  auto hull = RotatingCalipersd::hull(ps);
+  ASSERT_EQ(hull.size(), 4);
+  test_point2d_eq(hull.front(), {0.0, 1.0});
+  test_point2d_eq(hull[1], {1.0, 0.0});
+
+  auto m = RotatingCalipersd::measure(ps);
+  EXPECT_DOUBLE_EQ(m.diameter.length, 2.0);
+  EXPECT_NEAR(m.width.length, std::sqrt(2.0), 1E-12);
+  EXPECT_NEAR(m.minArea.area(), 2.0, 1E-12);
+  EXPECT_NEAR(m.minPerimeter.perimeter(), 4.0 * std::sqrt(2.0), 1E-12);
+  test_point2d_eq(m.minArea.center, {1.0, 1.0});
+  // the corners are the square itself
+  for (const auto &c : m.minArea.corners()) {
+    auto iter = std::find_if(hull.cbegin(), hull.cend(), [&c](const auto &p) {
+      return std::abs(p.x - c.x) < 1E-12 && std::abs(p.y - c.y) < 1E-12;
+    });
+    EXPECT_NE(iter, hull.cend());
+  }
+
+  // a segment and a point
+  m = RotatingCalipersd::measure({{0.0, 0.0}, {3.0, 4.0}, {1.5, 2.0}});
+  EXPECT_EQ(RotatingCalipersd::hull({{0.0, 0.0}, {3.0, 4.0}, {1.5, 2.0}}).size(), 2);
+  EXPECT_DOUBLE_EQ(m.diameter.length, 5.0);
+  EXPECT_DOUBLE_EQ(m.width.length, 0.0);
+  EXPECT_DOUBLE_EQ(m.minArea.width, 5.0);
+  EXPECT_DOUBLE_EQ(m.minArea.height, 0.0);
+  test_point2d_eq(m.minArea.center, {1.5, 2.0});
+  EXPECT_DOUBLE_EQ(RotatingCalipersd::diameter({{1.0, 1.0}}).length, 0.0);
+  EXPECT_DOUBLE_EQ(RotatingCalipersd::diameter({}).length, 0.0);
+}
+
+TEST(RotatingCalipers, random) {
+  std::vector<ns_geo::PointSet2d> clusters;
+  for (int k = 0; k != 300; ++k)
+    clusters.push_back(ns_geo::PointSet2d::randomGenerator(3 + k % 40, -5.0, 5.0, -2.0, 2.0));
+  auto res = RotatingCalipersd::measure(clusters, 4);
+  ASSERT_EQ(res.size(), clusters.size());
+  for (std::size_t k = 0; k != clusters.size(); ++k) {
+    const auto &ps = clusters[k];
+    // the diameter over all the pairs
+    double diam = 0.0;
+    for (const auto &p : ps)
+      for (const auto &q : ps)
+        diam = std::max(diam, std::hypot(p.x - q.x, p.y - q.y));
+    EXPECT_NEAR(res[k].diameter.length, diam, 1E-12);
+    EXPECT_NEAR(std::hypot(res[k].diameter.p1.x - res[k].diameter.p2.x, res[k].diameter.p1.y - res[k].diameter.p2.y), diam, 1E-12);
+
+    // the strips and rectangles over every hull edge, projecting all the points
+    auto hull = RotatingCalipersd::hull(ps);
+    double width = std::numeric_limits<double>::infinity(), area = width, perimeter = width;
+    for (std::size_t i = 0; i != hull.size(); ++i) {
+      const auto &a = hull[i], &b = hull[(i + 1) % hull.size()];
+      double len = std::hypot(b.x - a.x, b.y - a.y), ux = (b.x - a.x) / len, uy = (b.y - a.y) / len;
+      double u0 = std::numeric_limits<double>::infinity(), u1 = -u0, v1 = 0.0;
+      for (const auto &p : ps) {
+        double u = (p.x - a.x) * ux + (p.y - a.y) * uy, v = (p.x - a.x) * -uy + (p.y - a.y) * ux;
+        EXPECT_GE(v, -1E-12);
+        u0 = std::min(u0, u), u1 = std::max(u1, u), v1 = std::max(v1, v);
+      }
+      width = std::min(width, v1);
+      area = std::min(area, (u1 - u0) * v1);
+      perimeter = std::min(perimeter, 2.0 * (u1 - u0 + v1));
+    }
+    EXPECT_NEAR(res[k].width.length, width, 1E-12);
+    EXPECT_NEAR(res[k].minArea.area(), area, 1E-12);
+    EXPECT_NEAR(res[k].minPerimeter.perimeter(), perimeter, 1E-12);
+
+    // the rectangle holds every point
+    const auto &r = res[k].minArea;
+    double ux = std::cos(r.angle), uy = std::sin(r.angle);
+    for (const auto &p : ps) {
+      double u = (p.x - r.center.x) * ux + (p.y - r.center.y) * uy, v = -(p.x - r.center.x) * uy + (p.y - r.center.y) * ux;
+      EXPECT_LE(std::abs(u), 0.5 * r.width + 1E-9);
+      EXPECT_LE(std::abs(v), 0.5 * r.height + 1E-9);
+    }
+  }
+}
+
+#endif
@@ -25,4 +25,102 @@ TEST(Circle, normalTesting) {
   EXPECT_EQ(cir.type(), ns_geo::GeoType::CIRCLE);
 }
 
+TEST(Circle, algebraicFit) {
+  // exact points on a circle far from the origin
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 12; ++i)
+    ps.push_back({1000.0 + 4.0 * std::cos(0.5 * i), -500.0 + 4.0 * std::sin(0.5 * i)});
+  for (auto cir : {ns_geo::Circle::kasa(ps), ns_geo::Circle::pratt(ps), ns_geo::Circle::taubin(ps), ns_geo::Circle::fit(ps)}) {
+    EXPECT_NEAR(cir.cen.x, 1000.0, 1E-8);
+    EXPECT_NEAR(cir.cen.y, -500.0, 1E-8);
+    EXPECT_NEAR(cir.rad, 4.0, 1E-8);
+  }
+  EXPECT_FALSE(std::isfinite(ns_geo::Circle::taubin({{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}}).rad));
+
+  // noisy points on a quarter arc, where Kasa shrinks the circle
+  std::normal_distribution<double> noise(0.0, 0.05);
+  double errs[4] = {0.0, 0.0, 0.0, 0.0};
+  for (int trial = 0; trial != 50; ++trial) {
+    ps.clear();
+    for (int i = 0; i != 60; ++i) {
+      double theta = 0.5 * M_PI * i / 60;
+      ps.push_back({2.0 + (5.0 + noise(ns_geo::engine)) * std::cos(theta), 1.0 + (5.0 + noise(ns_geo::engine)) * std::sin(theta)});
+    }
+    auto m = ns_geo::Circle::moments(ps);
+    EXPECT_EQ(m.num, ps.size());
+    int k = 0;
+    for (auto cir : {ns_geo::Circle::kasa(m), ns_geo::Circle::pratt(m), ns_geo::Circle::taubin(m), ns_geo::Circle::fit(ps)})
+      errs[k++] += std::abs(cir.rad - 5.0);
+  }
+  EXPECT_LT(errs[2], errs[0]);
+  EXPECT_LT(errs[1], errs[0]);
+  EXPECT_LT(errs[3] / 50, 0.1);
+  EXPECT_LT(errs[2] / 50, 0.1);
+}
+
+TEST(Circle, batch) {
+  ns_geo::Circle cir({1.0, -2.0}, 3.0);
+  auto ps = ns_geo::PointSet2d::randomGenerator(1000, -5.0, 5.0, -5.0, 5.0);
+  ps.push_back(cir.cen);
+  auto dis = cir.distances(ps);
+  auto near = cir.nearests(ps);
+  auto in = cir.contains(ps);
+  ASSERT_EQ(dis.size(), ps.size());
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    double len = std::hypot(ps[i].x - cir.cen.x, ps[i].y - cir.cen.y);
+    EXPECT_NEAR(dis[i], std::abs(len - cir.rad), 1E-12);
+    EXPECT_DOUBLE_EQ(dis[i], cir.distance(ps[i]));
+    EXPECT_NEAR(std::hypot(near[i].x - cir.cen.x, near[i].y - cir.cen.y), cir.rad, 1E-12);
+    EXPECT_NEAR(std::hypot(near[i].x - ps[i].x, near[i].y - ps[i].y), dis[i], 1E-12);
+    test_point2d_eq(near[i], cir.nearest(ps[i]));
+    EXPECT_EQ(in[i] != 0, len <= cir.rad);
+  }
+  test_point2d_eq(near.back(), {4.0, -2.0});
+}
+
+TEST(Circle, enclosing) {
+  for (std::size_t n : {1, 2, 3, 10, 40}) {
+    auto ps = ns_geo::PointSet2d::randomGenerator(n, -10.0, 10.0, 0.0, 5.0);
+    auto cir = ns_geo::Circle::enclosing(ps);
+    for (const auto &p : ps)
+      EXPECT_LE(std::hypot(p.x - cir.cen.x, p.y - cir.cen.y), cir.rad + 1E-9);
+    // the smallest of the circles through two or three of the points enclosing them all
+    double best = n == 1 ? 0.0 : std::numeric_limits<double>::infinity();
+    auto encloses = [&ps](double x, double y, double r) {
+      for (const auto &p : ps)
+        if (std::hypot(p.x - x, p.y - y) > r + 1E-9)
+          return false;
+      return true;
+    };
+    for (std::size_t i = 0; i != n; ++i)
+      for (std::size_t j = i + 1; j < n; ++j) {
+        double x = 0.5 * (ps[i].x + ps[j].x), y = 0.5 * (ps[i].y + ps[j].y);
+        double r = 0.5 * std::hypot(ps[i].x - ps[j].x, ps[i].y - ps[j].y);
+        if (r < best && encloses(x, y, r))
+          best = r;
+        for (std::size_t k = j + 1; k < n; ++k) {
+          ns_geo::Circle c(ps[i], ps[j], ps[k]);
+          double r = std::hypot(ps[i].x - c.cen.x, ps[i].y - c.cen.y);
+          if (r < best && encloses(c.cen.x, c.cen.y, r))
+            best = r;
+        }
+      }
+    EXPECT_NEAR(cir.rad, best, 1E-9);
+  }
+
+  // collinear and repeated points
+  auto cir = ns_geo::Circle::enclosing({{0.0, 0.0}, {1.0, 1.0}, {3.0, 3.0}, {1.0, 1.0}, {2.0, 2.0}});
+  test_point2d_eq(cir.cen, {1.5, 1.5});
+  EXPECT_NEAR(cir.rad, 1.5 * std::sqrt(2.0), 1E-12);
+  EXPECT_DOUBLE_EQ(ns_geo::Circle::enclosing({}).rad, 0.0);
+
+  // a large cloud inside the unit circle, with a few points on it
+  auto ps = ns_geo::PointSet2d::randomGenerator(100000, -0.7, 0.7, -0.7, 0.7);
+  ps.push_back({1.0, 0.0}), ps.push_back({-0.6, 0.8}), ps.push_back({-0.6, -0.8});
+  cir = ns_geo::Circle::enclosing(ps);
+  EXPECT_NEAR(cir.cen.x, 0.0, 1E-9);
+  EXPECT_NEAR(cir.cen.y, 0.0, 1E-9);
+  EXPECT_NEAR(cir.rad, 1.0, 1E-9);
+}
+
 #endif
\ No newline at end of file
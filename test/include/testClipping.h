@@ -0,0 +1,133 @@
+#ifndef TEST_CLIPPING_H
+#define TEST_CLIPPING_H
+
+#include "helper.h"
+#include "include/clipping.hpp"
+
+using Clipper = ns_geo::PolygonClipper<double>;
+
+/**
+ * @brief the even-odd test over all the rings of a multipolygon
+ */
+bool multipolygon_contains(const ns_geo::MultiPolygon<double> &mp, const ns_geo::Point2d &p) {
+  bool in = false;
+  for (const auto &ring : Clipper::rings(mp))
+    for (std::size_t i = 0, j = ring.size() - 1; i != ring.size(); j = i++) {
+      const auto &a = ring[i], &b = ring[j];
+      if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)
+        in = !in;
+    }
+  return in;
+}
+
+double multipolygon_area(const ns_geo::MultiPolygon<double> &mp) {
+  double s = 0.0;
+  for (const auto &poly : mp)
+    s += poly.area();
+  return s;
+}
+
+ns_geo::Polygond make_star(double cx, double cy, int n, double r0, double r1, double phase) {
+  ns_geo::Polygond poly;
+  for (int i = 0; i != n; ++i) {
+    double theta = phase + 2.0 * M_PI * i / n, r = (i % 2 == 0) ? r0 : r1;
+    poly.push_back({cx + r * std::cos(theta), cy + r * std::sin(theta)});
+  }
+  return poly;
+}
+
+TEST(PolygonClipper, squares) {
+  ns_geo::Polygond a{{0.0, 0.0}, {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+  ns_geo::Polygond b{{1.0, 1.0}, {3.0, 1.0}, {3.0, 3.0}, {1.0, 3.0}};
+  EXPECT_NEAR(multipolygon_area(Clipper::intersection(a, b)), 1.0, 1E-12);
+  EXPECT_NEAR(multipolygon_area(Clipper::compute({a}, {b}, ns_geo::BoolOp::INTERSECTION)), 1.0, 1E-12);
+  auto u = Clipper::unite(a, b);
+  ASSERT_EQ(u.size(), 1);
+  EXPECT_NEAR(u.front().area(), 7.0, 1E-12);
+  EXPECT_GT(ns_geo::PolygonWithHoles<double>::signedArea(u.front().outer), 0.0);
+  EXPECT_NEAR(multipolygon_area(Clipper::difference(a, b)), 3.0, 1E-12);
+  auto x = Clipper::symDifference(a, b);
+  EXPECT_EQ(x.size(), 2);
+  EXPECT_NEAR(multipolygon_area(x), 6.0, 1E-12);
+
+  // far apart
+  ns_geo::Polygond c{{5.0, 5.0}, {6.0, 5.0}, {6.0, 6.0}};
+  EXPECT_TRUE(Clipper::intersection(a, c).empty());
+  EXPECT_EQ(Clipper::unite(a, c).size(), 2);
+  EXPECT_NEAR(multipolygon_area(Clipper::difference(a, c)), 4.0, 1E-12);
+}
+
+TEST(PolygonClipper, holes) {
+  ns_geo::Polygond outer{{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}};
+  ns_geo::Polygond inner{{3.0, 3.0}, {7.0, 3.0}, {7.0, 7.0}, {3.0, 7.0}};
+  auto frame = Clipper::difference(outer, inner);
+  ASSERT_EQ(frame.size(), 1);
+  ASSERT_EQ(frame.front().holes.size(), 1);
+  EXPECT_NEAR(frame.front().area(), 84.0, 1E-12);
+  EXPECT_LT(ns_geo::PolygonWithHoles<double>::signedArea(frame.front().holes.front()), 0.0);
+
+  // an island in the hole
+  ns_geo::Polygond island{{4.0, 4.0}, {6.0, 4.0}, {6.0, 6.0}, {4.0, 6.0}};
+  auto res = Clipper::compute(frame, {ns_geo::PolygonWithHoles<double>(island)}, ns_geo::BoolOp::UNION);
+  ASSERT_EQ(res.size(), 2);
+  EXPECT_NEAR(multipolygon_area(res), 88.0, 1E-12);
+  EXPECT_TRUE(multipolygon_contains(res, {5.0, 5.0}));
+  EXPECT_FALSE(multipolygon_contains(res, {3.5, 5.0}));
+
+  // a bar across the frame splits its hole in two
+  ns_geo::Polygond bar{{-1.0, 4.5}, {11.0, 4.5}, {11.0, 5.5}, {-1.0, 5.5}};
+  auto cut = Clipper::compute(frame, {ns_geo::PolygonWithHoles<double>(bar)}, ns_geo::BoolOp::UNION);
+  ASSERT_EQ(cut.size(), 1);
+  EXPECT_EQ(cut.front().holes.size(), 2);
+  EXPECT_NEAR(cut.front().area(), 84.0 + 4.0 + 2.0, 1E-12);
+}
+
+TEST(PolygonClipper, stars) {
+  auto a = make_star(0.0, 0.0, 40, 10.0, 4.0, 0.0);
+  auto b = make_star(3.0, 1.0, 36, 9.0, 3.0, 0.1);
+  double sa = std::abs(ns_geo::PolygonWithHoles<double>::signedArea(a));
+  double sb = std::abs(ns_geo::PolygonWithHoles<double>::signedArea(b));
+  auto inter = Clipper::intersection(a, b), uni = Clipper::unite(a, b);
+  auto diff = Clipper::difference(a, b), xr = Clipper::symDifference(a, b);
+  double si = multipolygon_area(inter), su = multipolygon_area(uni);
+  EXPECT_GT(si, 0.0);
+  EXPECT_NEAR(su, sa + sb - si, 1E-9);
+  EXPECT_NEAR(multipolygon_area(diff), sa - si, 1E-9);
+  EXPECT_NEAR(multipolygon_area(xr), su - si, 1E-9);
+
+  // agree with the operands point by point
+  auto ps = ns_geo::PointSet2d::randomGenerator(4000, -11.0, 13.0, -11.0, 11.0);
+  for (const auto &p : ps) {
+    bool ia = multipolygon_contains({ns_geo::PolygonWithHoles<double>(a)}, p);
+    bool ib = multipolygon_contains({ns_geo::PolygonWithHoles<double>(b)}, p);
+    EXPECT_EQ(multipolygon_contains(inter, p), ia && ib);
+    EXPECT_EQ(multipolygon_contains(uni, p), ia || ib);
+    EXPECT_EQ(multipolygon_contains(diff, p), ia && !ib);
+    EXPECT_EQ(multipolygon_contains(xr, p), ia != ib);
+  }
+}
+
+TEST(PolygonClipper, fastPaths) {
+  auto circle = make_star(0.0, 0.0, 64, 5.0, 5.0, 0.0);
+  auto tri = ns_geo::Polygond{{-6.0, -6.0}, {6.0, -6.0}, {0.0, 4.0}};
+  EXPECT_TRUE(Clipper::isConvex(circle));
+  EXPECT_TRUE(Clipper::isConvex(tri));
+  EXPECT_FALSE(Clipper::isConvex(make_star(0.0, 0.0, 10, 5.0, 2.0, 0.0)));
+  // a pentagram turns one way only but isn't convex
+  ns_geo::Polygond pentagram;
+  for (int i = 0; i != 5; ++i)
+    pentagram.push_back({std::cos(4.0 * M_PI * i / 5), std::sin(4.0 * M_PI * i / 5)});
+  EXPECT_FALSE(Clipper::isConvex(pentagram));
+
+  double fast = ns_geo::PolygonWithHoles<double>::signedArea(Clipper::clipConvex(circle, tri));
+  double sweep = multipolygon_area(Clipper::compute({circle}, {tri}, ns_geo::BoolOp::INTERSECTION));
+  EXPECT_NEAR(std::abs(fast), sweep, 1E-9);
+
+  auto star = make_star(0.0, 0.0, 30, 5.0, 2.0, 0.3);
+  ns_geo::Rectangled rect(-1.0, 4.0, 6.0, -3.0);
+  ns_geo::Polygond box{{-1.0, -3.0}, {6.0, -3.0}, {6.0, 4.0}, {-1.0, 4.0}};
+  double clipped = ns_geo::PolygonWithHoles<double>::signedArea(Clipper::clipRect(star, rect));
+  EXPECT_NEAR(std::abs(clipped), multipolygon_area(Clipper::compute({star}, {box}, ns_geo::BoolOp::INTERSECTION)), 1E-9);
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef TEST_CONTOUR_H
+#define TEST_CONTOUR_H
+
+#include "helper.h"
+#include "include/contour.hpp"
+
+/**
+ * @brief a (n + 1) x (n + 1) grid TIN over [0, n] x [0, n] with the heights given by 'height'
+ */
+template <typename Func>
+void make_grid_tin(int n, Func height, ns_geo::PointSet3d &pts, ns_geo::ContourTracer<double>::tin_type &tin) {
+  for (int j = 0; j <= n; ++j)
+    for (int i = 0; i <= n; ++i)
+      pts.push_back({double(i), double(j), height(double(i), double(j))});
+  for (int j = 0; j != n; ++j)
+    for (int i = 0; i != n; ++i) {
+      std::size_t v = j * (n + 1) + i;
+      tin.push_back({v, v + 1, v + n + 2});
+      // clockwise on purpose, the tracer must cope with it
+      tin.push_back({v, v + n + 1, v + n + 2});
+    }
+}
+
+TEST(ContourTracer, plane) {
+  ns_geo::PointSet3d pts;
+  ns_geo::ContourTracer<double>::tin_type tin;
+  make_grid_tin(4, [](double x, double) { return x; }, pts, tin);
+  ns_geo::ContourTracer<double> tracer(pts, tin);
+
+  auto res = tracer.trace({0.5, 2.0, 3.25, 10.0}, 2);
+  ASSERT_EQ(res.size(), 4);
+  std::vector<double> xs{0.5, 2.0, 3.25};
+  for (int k = 0; k != 3; ++k) {
+    ASSERT_EQ(res[k].size(), 1);
+    const auto &ls = res[k].front();
+    EXPECT_EQ(ls.size(), 9);
+    for (const auto &p : ls)
+      EXPECT_NEAR(p.x, xs[k], 1E-12);
+    // the high ground (larger x) stays on the left, so the line runs downwards
+    EXPECT_FLOAT_EQ(ls.front().y, 4.0);
+    EXPECT_FLOAT_EQ(ls.back().y, 0.0);
+    EXPECT_FLOAT_EQ(ls.length(), 4.0f);
+  }
+  EXPECT_TRUE(res[3].empty());
+}
+
+TEST(ContourTracer, rings) {
+  ns_geo::PointSet3d pts;
+  ns_geo::ContourTracer<double>::tin_type tin;
+  // a cone with the peak at (5, 5)
+  make_grid_tin(10, [](double x, double y) { return 10.0 - std::hypot(x - 5.0, y - 5.0); }, pts, tin);
+  ns_geo::ContourTracer<double> tracer(pts, tin);
+
+  std::vector<std::size_t> count(3, 0);
+  std::vector<double> levels{6.5, 8.5, 9.5};
+  tracer.trace(
+      levels, [&](std::size_t idx, ns_geo::LineString2d &&ls) {
+        ++count[idx];
+        // closed ring around the peak
+        test_point2d_eq(ls.front(), ls.back());
+        for (const auto &p : ls)
+          EXPECT_LT(std::hypot(p.x - 5.0, p.y - 5.0), 10.0 - levels[idx] + 0.2);
+        double area = 0.0;
+        for (std::size_t i = 0; i + 1 < ls.size(); ++i)
+          area += ls[i].x * ls[i + 1].y - ls[i + 1].x * ls[i].y;
+        // the high ground is inside, so the ring is counter-clockwise
+        EXPECT_GT(area, 0.0);
+      },
+      3);
+  EXPECT_EQ(count, std::vector<std::size_t>(3, 1));
+}
+
+#endif
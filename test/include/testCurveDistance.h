@@ -0,0 +1,101 @@
+#ifndef TEST_CURVEDISTANCE_H
+#define TEST_CURVEDISTANCE_H
+
+#include "helper.h"
+#include "include/curvedistance.hpp"
+
+using CurveDistanced = ns_geo::CurveDistance<double>;
+
+ns_geo::LineString2d make_walk(std::size_t n, double sx, double sy) {
+  std::uniform_real_distribution<double> u(-1.0, 1.0);
+  ns_geo::LineString2d ls{{sx, sy}};
+  for (std::size_t i = 1; i != n; ++i)
+    ls.push_back({ls.back().x + 0.5 + u(ns_geo::engine), ls.back().y + u(ns_geo::engine)});
+  return ls;
+}
+
+/**
+ * @brief the textbook full-matrix discrete Frechet distance
+ */
+double frechet_naive(const ns_geo::LineString2d &a, const ns_geo::LineString2d &b) {
+  std::vector<std::vector<double>> ca(a.size(), std::vector<double>(b.size()));
+  for (std::size_t i = 0; i != a.size(); ++i)
+    for (std::size_t j = 0; j != b.size(); ++j) {
+      double d = std::hypot(a[i].x - b[j].x, a[i].y - b[j].y);
+      if (i == 0 && j == 0)
+        ca[i][j] = d;
+      else if (i == 0)
+        ca[i][j] = std::max(ca[i][j - 1], d);
+      else if (j == 0)
+        ca[i][j] = std::max(ca[i - 1][j], d);
+      else
+        ca[i][j] = std::max(std::min({ca[i - 1][j], ca[i - 1][j - 1], ca[i][j - 1]}), d);
+    }
+  return ca.back().back();
+}
+
+double hausdorff_naive(const ns_geo::LineString2d &a, const ns_geo::LineString2d &b) {
+  auto directed = [](const ns_geo::LineString2d &p, const ns_geo::LineString2d &q) {
+    double res = 0.0;
+    for (const auto &x : p) {
+      double best = std::numeric_limits<double>::infinity();
+      for (const auto &y : q)
+        best = std::min(best, std::hypot(x.x - y.x, x.y - y.y));
+      res = std::max(res, best);
+    }
+    return res;
+  };
+  return std::max(directed(a, b), directed(b, a));
+}
+
+TEST(CurveDistance, distances) {
+  ns_geo::LineString2d a{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}};
+  ns_geo::LineString2d b{{0.0, 1.0}, {2.0, 1.0}};
+  EXPECT_DOUBLE_EQ(CurveDistanced::hausdorff(a, b), std::sqrt(2.0));
+  EXPECT_DOUBLE_EQ(CurveDistanced::frechet(a, b), std::sqrt(2.0));
+  // the same vertices backwards are Hausdorff close but Frechet far
+  ns_geo::LineString2d r(a.rbegin(), a.rend());
+  EXPECT_DOUBLE_EQ(CurveDistanced::hausdorff(a, r), 0.0);
+  EXPECT_DOUBLE_EQ(CurveDistanced::frechet(a, r), 2.0);
+
+  for (int k = 0; k != 20; ++k) {
+    auto p = make_walk(30 + k, 0.0, 0.0), q = make_walk(40 - k, 0.5, 0.5);
+    double h = hausdorff_naive(p, q), f = frechet_naive(p, q);
+    EXPECT_NEAR(CurveDistanced::hausdorff(p, q), h, 1E-12);
+    EXPECT_NEAR(CurveDistanced::frechet(p, q), f, 1E-12);
+    EXPECT_TRUE(CurveDistanced::hausdorffWithin(p, q, h + 1E-9));
+    EXPECT_FALSE(CurveDistanced::hausdorffWithin(p, q, h - 1E-9));
+    EXPECT_TRUE(CurveDistanced::frechetWithin(p, q, f + 1E-9));
+    EXPECT_FALSE(CurveDistanced::frechetWithin(p, q, f - 1E-9));
+  }
+}
+
+TEST(CurveDistance, batch) {
+  auto query = make_walk(200, 0.0, 0.0);
+  std::vector<ns_geo::LineString2d> candidates;
+  std::normal_distribution<double> noise(0.0, 0.1);
+  for (int k = 0; k != 100; ++k) {
+    if (k % 4 == 0) {
+      // a noisy copy of the query
+      auto c = query;
+      for (auto &p : c)
+        p.x += noise(ns_geo::engine), p.y += noise(ns_geo::engine);
+      candidates.push_back(c);
+    } else
+      candidates.push_back(make_walk(150 + k, 0.0, 0.0));
+  }
+  for (auto metric : {ns_geo::CurveMetric::HAUSDORFF, ns_geo::CurveMetric::FRECHET}) {
+    auto ds = CurveDistanced::distances(query, candidates, metric, 4);
+    auto hits = CurveDistanced::matches(query, candidates, 1.0, metric, 4);
+    std::vector<std::size_t> expect;
+    for (std::size_t i = 0; i != candidates.size(); ++i) {
+      EXPECT_DOUBLE_EQ(ds[i], CurveDistanced::distance(query, candidates[i], metric));
+      if (ds[i] <= 1.0)
+        expect.push_back(i);
+    }
+    EXPECT_EQ(hits, expect);
+    EXPECT_GE(hits.size(), 25);
+  }
+}
+
+#endif
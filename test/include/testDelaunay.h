@@ -0,0 +1,68 @@
+#ifndef TEST_DELAUNAY_H
+#define TEST_DELAUNAY_H
+
+#include "helper.h"
+#include "include/calipers.hpp"
+#include "include/delaunay.hpp"
+
+TEST(Delaunay2, square) {
+  ns_geo::PointSet2d ps{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.5, 0.5}};
+  ns_geo::Delaunay2<double> dt(ps);
+  auto tris = dt.triangles();
+  ASSERT_EQ(tris.size(), 4);
+  double area = 0.0;
+  for (const auto &t : tris) {
+    // the centre is shared by every triangle
+    EXPECT_TRUE(t[0] == 4 || t[1] == 4 || t[2] == 4);
+    area += ns_geo::Triangle2d(ps[t[0]], ps[t[1]], ps[t[2]]).area();
+  }
+  EXPECT_NEAR(area, 1.0, 1E-12);
+}
+
+TEST(Delaunay2, emptyCircle) {
+  auto rps = ns_geo::RefPointSet2d::randomGenerator(300, 0.0, 100.0, 0.0, 50.0);
+  // a duplicated site is skipped
+  rps.insert(ns_geo::RefPoint2d(1000, rps.at(0).x, rps.at(0).y));
+  ns_geo::Delaunay2<double> dt(rps);
+  EXPECT_EQ(dt.vertexNum(), 300);
+
+  auto tris = dt.refTriangles(rps);
+  // 2n - 2 - h triangles, so at least n and at most 2n - 5
+  EXPECT_GE(tris.size(), 300);
+  EXPECT_LE(tris.size(), 595);
+  for (const auto &tri : tris) {
+    // counter-clockwise
+    auto p1 = tri.p1(), p2 = tri.p2(), p3 = tri.p3();
+    EXPECT_GT((p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x), 0.0);
+    auto cir = tri.circumCircle();
+    for (const auto &[id, p] : rps) {
+      if (id == 1000)
+        continue;
+      EXPECT_GT(ns_geo::distance(ns_geo::Point2d(p.x, p.y), cir.cen), cir.rad * (1.0 - 1E-4));
+    }
+  }
+}
+
+TEST(Delaunay2, thinHull) {
+  // near-collinear points, whose hull triangles have circumcircles far larger than the set
+  for (int trial = 0; trial != 100; ++trial) {
+    auto ps = ns_geo::PointSet2d::randomGenerator(5 + trial % 50, 0.0, 10.0, -1E-3, 1E-3);
+    for (auto &p : ps)
+      p.y += 0.5 * p.x;
+    ns_geo::Delaunay2<double> dt(ps);
+    double area = 0.0;
+    for (const auto &t : dt.triangles()) {
+      const auto &a = ps[t[0]], &b = ps[t[1]], &c = ps[t[2]];
+      area += 0.5 * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    }
+    auto hull = ns_geo::RotatingCalipers<double>::hull(ps);
+    double hullArea = 0.0;
+    for (std::size_t i = 0; i != hull.size(); ++i) {
+      const auto &a = hull[i], &b = hull[(i + 1) % hull.size()];
+      hullArea += 0.5 * (a.x * b.y - b.x * a.y);
+    }
+    EXPECT_NEAR(area, hullArea, 1E-9);
+  }
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef TEST_EARCUT_H
+#define TEST_EARCUT_H
+
+#include "helper.h"
+#include "include/earcut.hpp"
+
+using EarCutd = ns_geo::EarCut<double>;
+
+/**
+ * @brief the total area of the triangles, each must be counter-clockwise
+ */
+double earcut_area(const std::vector<EarCutd::triangle_type> &tris, const ns_geo::PointSet2d &vertices) {
+  double s = 0.0;
+  for (const auto &t : tris) {
+    const auto &a = vertices[t[0]], &b = vertices[t[1]], &c = vertices[t[2]];
+    double cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    EXPECT_GE(cross, 0.0);
+    s += 0.5 * cross;
+  }
+  return s;
+}
+
+TEST(EarCut, holes) {
+  ns_geo::Polygond square{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  auto tris = EarCutd::triangulate(square);
+  ASSERT_EQ(tris.size(), 2);
+  EXPECT_DOUBLE_EQ(earcut_area(tris, square), 1.0);
+  // the winding of the input doesn't matter
+  ns_geo::Polygond cw(square.rbegin(), square.rend());
+  EXPECT_DOUBLE_EQ(earcut_area(EarCutd::triangulate(cw), cw), 1.0);
+
+  ns_geo::Polygond outer{{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}};
+  std::vector<ns_geo::Polygond> holes{{{2.0, 2.0}, {4.0, 2.0}, {4.0, 4.0}, {2.0, 4.0}},
+                                      {{6.0, 6.0}, {8.0, 6.0}, {7.0, 8.0}}};
+  tris = EarCutd::triangulate(outer, holes);
+  // n + 2h - 2 triangles for a simple polygon with holes
+  EXPECT_EQ(tris.size(), 11 + 2 * 2 - 2);
+  ns_geo::PointSet2d all(outer.cbegin(), outer.cend());
+  for (const auto &hole : holes)
+    all.insert(all.end(), hole.cbegin(), hole.cend());
+  EXPECT_NEAR(earcut_area(tris, all), 100.0 - 4.0 - 2.0, 1E-12);
+
+  auto shapes = EarCutd::triangles(outer, holes);
+  ASSERT_EQ(shapes.size(), tris.size());
+  test_point2d_eq(shapes[3].p2, all[tris[3][1]]);
+
+  // the clipper's output goes straight in
+  ns_geo::PolygonWithHoles<double> frame(outer);
+  frame.holes.push_back(holes[0]);
+  EXPECT_NEAR(earcut_area(EarCutd::triangulate(frame), all), 96.0, 1E-12);
+}
+
+TEST(EarCut, large) {
+  // a coastline-like ring with 100k vertices
+  const std::size_t n = 100000;
+  std::uniform_real_distribution<double> r(-0.005, 0.005);
+  ns_geo::Polygond ring;
+  for (std::size_t i = 0; i != n; ++i) {
+    double theta = 2.0 * M_PI * i / n;
+    double rad = 80.0 + 10.0 * std::sin(5.0 * theta) + 5.0 * std::sin(37.0 * theta) + r(ns_geo::engine);
+    ring.push_back({rad * std::cos(theta), rad * std::sin(theta)});
+  }
+  double expect = 0.0;
+  for (std::size_t i = 0, j = n - 1; i != n; j = i++)
+    expect += 0.5 * (ring[j].x * ring[i].y - ring[i].x * ring[j].y);
+  auto tris = EarCutd::triangulate(ring);
+  EXPECT_EQ(tris.size(), n - 2);
+  EXPECT_NEAR(earcut_area(tris, ring), expect, 1E-6 * expect);
+}
+
+TEST(EarCut, batch) {
+  std::vector<ns_geo::Polygond> polys;
+  for (int k = 0; k != 500; ++k)
+    polys.push_back(ns_geo::Polygond{{0.0, 0.0}, {k + 2.0, 0.0}, {1.0, 1.0}, {0.0, k + 2.0}});
+  auto res = EarCutd::triangulateBatch(polys, 4);
+  ASSERT_EQ(res.size(), polys.size());
+  for (std::size_t k = 0; k != polys.size(); ++k) {
+    EXPECT_EQ(res[k], EarCutd::triangulate(polys[k]));
+    EXPECT_NEAR(earcut_area(res[k], polys[k]), k + 2.0, 1E-9);
+  }
+}
+
+TEST_F(TestRefPointSet2f, earcut) {
+  auto polygon = _rps->createRefPolygon({3, 5, 4, 1, 0});
+  auto tris = ns_geo::EarCut<float>::triangulate(polygon);
+  ASSERT_EQ(tris.size(), 3);
+  double s = 0.0;
+  for (const auto &t : tris) {
+    const auto &a = _rps->at(t[0]), &b = _rps->at(t[1]), &c = _rps->at(t[2]);
+    s += 0.5 * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+  }
+  EXPECT_NEAR(s, polygon.area(), 1E-5);
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef TEST_ELLIPSE_H
+#define TEST_ELLIPSE_H
+
+#include "helper.h"
+#include "include/ransac.hpp"
+
+/**
+ * @brief the distance to an ellipse by sampling it densely and polishing the angle by Newton's method
+ */
+double ellipse_reference_distance(const ns_geo::Ellipse &ell, const ns_geo::Point2d &p) {
+  double c = std::cos(ell.angle), s = std::sin(ell.angle);
+  double x = c * (p.x - ell.cen.x) + s * (p.y - ell.cen.y), y = -s * (p.x - ell.cen.x) + c * (p.y - ell.cen.y);
+  double best = std::numeric_limits<double>::infinity(), phi = 0.0;
+  for (int i = 0; i != 4000; ++i) {
+    double t = 2.0 * M_PI * i / 4000, d = std::hypot(x - ell.a * std::cos(t), y - ell.b * std::sin(t));
+    if (d < best)
+      best = d, phi = t;
+  }
+  for (int k = 0; k != 30; ++k) {
+    double ct = std::cos(phi), st = std::sin(phi), ab = ell.a * ell.a - ell.b * ell.b;
+    double f = ab * st * ct - x * ell.a * st + y * ell.b * ct, df = ab * (ct * ct - st * st) - x * ell.a * ct - y * ell.b * st;
+    if (df == 0.0)
+      break;
+    phi -= f / df;
+  }
+  return std::min(best, std::hypot(x - ell.a * std::cos(phi), y - ell.b * std::sin(phi)));
+}
+
+TEST(Ellipse, distance) {
+  ns_geo::Ellipse ell({1.0, -2.0}, 5.0, 2.0, 0.4);
+  EXPECT_EQ(ell.type(), ns_geo::GeoType::ELLIPSE);
+  test_point2d_eq(ell.nearest({1.0 + 10.0 * std::cos(0.4), -2.0 + 10.0 * std::sin(0.4)}),
+                  {1.0 + 5.0 * std::cos(0.4), -2.0 + 5.0 * std::sin(0.4)});
+  EXPECT_TRUE(ell.contains({1.0, -2.0}));
+  EXPECT_FALSE(ell.contains({1.0, 1.0}));
+
+  // the batch kernel agrees with the single form and the reference, with thin ellipses too
+  for (double ratio : {1.0, 0.5, 0.1}) {
+    ns_geo::Ellipse e({3.0, 4.0}, 6.0, 6.0 * ratio, -1.1);
+    auto ps = ns_geo::PointSet2d::randomGenerator(500, -10.0, 16.0, -8.0, 16.0);
+    auto dis = e.distances(ps);
+    for (std::size_t i = 0; i != ps.size(); ++i) {
+      EXPECT_DOUBLE_EQ(dis[i], e.distance(ps[i]));
+      EXPECT_NEAR(dis[i], ellipse_reference_distance(e, ps[i]), 1E-9);
+      auto q = e.nearest(ps[i]);
+      EXPECT_NEAR(std::hypot(q.x - ps[i].x, q.y - ps[i].y), dis[i], 1E-9);
+    }
+  }
+}
+
+TEST(Ellipse, fit) {
+  // exact points, then a short noisy arc where the circle fit is biased
+  ns_geo::Ellipse truth({10.0, -5.0}, 8.0, 3.0, 0.7);
+  auto on = [&truth](double t) {
+    double x = truth.a * std::cos(t), y = truth.b * std::sin(t), c = std::cos(truth.angle), s = std::sin(truth.angle);
+    return ns_geo::Point2d(truth.cen.x + c * x - s * y, truth.cen.y + s * x + c * y);
+  };
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 40; ++i)
+    ps.push_back(on(0.3 * i));
+  auto ell = ns_geo::Ellipse::direct(ps);
+  EXPECT_NEAR(ell.cen.x, 10.0, 1E-9);
+  EXPECT_NEAR(ell.cen.y, -5.0, 1E-9);
+  EXPECT_NEAR(ell.a, 8.0, 1E-9);
+  EXPECT_NEAR(ell.b, 3.0, 1E-9);
+  EXPECT_NEAR(ell.angle, 0.7, 1E-9);
+
+  std::normal_distribution<double> noise(0.0, 0.05);
+  std::uniform_real_distribution<double> arc(0.0, 0.8 * M_PI);
+  ps.clear();
+  for (int i = 0; i != 300; ++i) {
+    auto p = on(arc(ns_geo::engine));
+    ps.push_back({p.x + noise(ns_geo::engine), p.y + noise(ns_geo::engine)});
+  }
+  auto direct = ns_geo::Ellipse::direct(ps), geometric = ns_geo::Ellipse::fit(ps);
+  auto cost = [&ps](const ns_geo::Ellipse &e) {
+    double sum = 0.0;
+    for (const auto &p : ps)
+      sum += e.distance(p) * e.distance(p);
+    return sum;
+  };
+  EXPECT_LE(cost(geometric), cost(direct));
+  EXPECT_NEAR(cost(geometric) / ps.size(), 0.05 * 0.05, 1E-3);
+  EXPECT_NEAR(geometric.a, 8.0, 0.3);
+  EXPECT_NEAR(geometric.b, 3.0, 0.1);
+  EXPECT_NEAR(geometric.angle, 0.7, 0.02);
+  EXPECT_GT(geometric.a, geometric.b);
+
+  // degenerate sets
+  EXPECT_FALSE(std::isfinite(ns_geo::Ellipse::direct({{0.0, 0.0}, {1.0, 1.0}}).a));
+  EXPECT_FALSE(std::isfinite(ns_geo::Ellipse::direct({{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}, {4.0, 4.0}, {5.0, 5.0}}).a));
+}
+
+TEST(Ellipse, ransac) {
+  // an oblique ellipse among outliers
+  ns_geo::Ellipse truth({0.0, 0.0}, 6.0, 2.5, -0.3);
+  std::normal_distribution<double> noise(0.0, 0.02);
+  std::uniform_real_distribution<double> theta(0.0, 2.0 * M_PI), box(-10.0, 10.0);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 200; ++i) {
+    double t = theta(ns_geo::engine), x = truth.a * std::cos(t), y = truth.b * std::sin(t);
+    double c = std::cos(truth.angle), s = std::sin(truth.angle);
+    ps.push_back({c * x - s * y + noise(ns_geo::engine), s * x + c * y + noise(ns_geo::engine)});
+  }
+  for (int i = 0; i != 100; ++i)
+    ps.push_back({box(ns_geo::engine), box(ns_geo::engine)});
+  ns_geo::RansacOptions opt;
+  opt.threshold = 0.08;
+  auto res = ns_geo::Ransac<ns_geo::EllipseEstimator>(opt).run(ps);
+  ASSERT_TRUE(res.success());
+  EXPECT_GE(res.inlierNum, 195);
+  EXPECT_NEAR(res.model->a, 6.0, 0.05);
+  EXPECT_NEAR(res.model->b, 2.5, 0.05);
+  EXPECT_NEAR(res.model->angle, -0.3, 0.02);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TEST_HOUGH_H
+#define TEST_HOUGH_H
+
+#include "helper.h"
+#include "include/hough.hpp"
+#include "include/ransac.hpp"
+
+TEST(HoughTransform, lines) {
+  // three segments in heavy clutter
+  std::vector<std::array<double, 4>> segs{{0.0, 0.0, 100.0, 0.0}, {10.0, 10.0, 80.0, 90.0}, {90.0, 5.0, 20.0, 70.0}};
+  std::normal_distribution<double> noise(0.0, 0.2);
+  std::uniform_real_distribution<double> u(0.0, 1.0), box(0.0, 100.0);
+  ns_geo::PointSet2d ps;
+  for (const auto &s : segs)
+    for (int i = 0; i != 150; ++i) {
+      double t = u(ns_geo::engine);
+      ps.push_back({s[0] + t * (s[2] - s[0]) + noise(ns_geo::engine), s[1] + t * (s[3] - s[1]) + noise(ns_geo::engine)});
+    }
+  for (int i = 0; i != 1500; ++i)
+    ps.push_back({box(ns_geo::engine), box(ns_geo::engine)});
+
+  ns_geo::HoughLineOptions opt;
+  opt.minVotes = 80;
+  opt.threads = 4;
+  auto res = ns_geo::HoughTransform<double>::lines(ps, opt);
+  ASSERT_EQ(res.size(), segs.size());
+  for (std::size_t k = 1; k != res.size(); ++k)
+    EXPECT_GE(res[k - 1].votes, res[k].votes);
+  for (const auto &s : segs) {
+    // a line through both ends of the segment, within the bin sizes
+    auto iter = std::find_if(res.cbegin(), res.cend(), [&s](const auto &peak) {
+      return peak.model.distance({s[0], s[1]}) < 1.5 && peak.model.distance({s[2], s[3]}) < 1.5;
+    });
+    EXPECT_NE(iter, res.cend());
+  }
+  // the same votes on a single thread
+  opt.threads = 1;
+  auto single = ns_geo::HoughTransform<double>::lines(ps, opt);
+  ASSERT_EQ(single.size(), res.size());
+  for (std::size_t k = 0; k != res.size(); ++k)
+    EXPECT_EQ(single[k].votes, res[k].votes);
+
+  // RANSAC on the same data finds only one of the lines at a time
+  ns_geo::RansacOptions ropt;
+  ropt.threshold = 0.6;
+  auto best = ns_geo::Ransac<ns_geo::LineEstimator>(ropt).run(ps);
+  ASSERT_TRUE(best.success());
+  auto iter = std::find_if(segs.cbegin(), segs.cend(), [&best](const auto &s) {
+    return best.model->distance({s[0], s[1]}) < 1.5 && best.model->distance({s[2], s[3]}) < 1.5;
+  });
+  EXPECT_NE(iter, segs.cend());
+}
+
+TEST(HoughTransform, circles) {
+  std::vector<std::array<double, 3>> cirs{{20.0, 20.0, 6.0}, {45.0, 30.0, 9.0}, {30.0, 45.0, 4.0}};
+  std::normal_distribution<double> noise(0.0, 0.1);
+  std::uniform_real_distribution<double> theta(0.0, 2.0 * M_PI), box(0.0, 60.0);
+  ns_geo::PointSet2f ps;
+  for (const auto &c : cirs)
+    for (int i = 0; i != 100; ++i) {
+      double t = theta(ns_geo::engine);
+      ps.push_back({static_cast<float>(c[0] + c[2] * std::cos(t) + noise(ns_geo::engine)),
+                    static_cast<float>(c[1] + c[2] * std::sin(t) + noise(ns_geo::engine))});
+    }
+  for (int i = 0; i != 600; ++i)
+    ps.push_back({static_cast<float>(box(ns_geo::engine)), static_cast<float>(box(ns_geo::engine))});
+
+  ns_geo::HoughCircleOptions opt;
+  opt.minRadius = 3.0, opt.maxRadius = 10.0;
+  opt.radiusStep = 0.5;
+  // the clutter casts more votes for the larger circles
+  opt.minVotes = 70;
+  opt.threads = 3;
+  auto res = ns_geo::HoughTransform<float>::circles(ps, opt);
+  ASSERT_EQ(res.size(), cirs.size());
+  for (const auto &c : cirs) {
+    auto iter = std::find_if(res.cbegin(), res.cend(), [&c](const auto &peak) {
+      return std::abs(peak.model.cen.x - c[0]) <= 1.0 && std::abs(peak.model.cen.y - c[1]) <= 1.0 && std::abs(peak.model.rad - c[2]) <= 0.5;
+    });
+    EXPECT_NE(iter, res.cend());
+  }
+  EXPECT_TRUE(ns_geo::HoughTransform<float>::circles({}, opt).empty());
+}
+
+TEST(HoughTransform, circleVotesOnce) {
+  // at a radius of one and a half bins the last angle rounds to the bin of the first one
+  ns_geo::HoughCircleOptions opt;
+  opt.minRadius = 1.5, opt.maxRadius = 4.5;
+  opt.minVotes = 1;
+  opt.threads = 1;
+  for (int i = 0; i != 50; ++i) {
+    ns_geo::PointSet2f ps{{0.37F * i, 0.11F * i}};
+    for (const auto &peak : ns_geo::HoughTransform<float>::circles(ps, opt))
+      EXPECT_EQ(peak.votes, 1) << i;
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef TEST_INCREMENTALFIT_H
+#define TEST_INCREMENTALFIT_H
+
+#include "helper.h"
+#include "include/incrementalfit.hpp"
+
+TEST(IncrementalFit, line) {
+  // a sliding window over a noisy line far from the origin
+  std::normal_distribution<double> noise(0.0, 0.05);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 2000; ++i) {
+    double t = 0.01 * i;
+    ps.push_back({1E5 + t + noise(ns_geo::engine), -2E5 + 0.5 * t + noise(ns_geo::engine)});
+  }
+  const std::size_t window = 100;
+  ns_geo::IncrementalLineFit fit;
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    fit.add(ps[i]);
+    if (i >= window)
+      fit.remove(ps[i - window]);
+    if (i + 1 < window || i % 97 != 0)
+      continue;
+    ASSERT_EQ(fit.size(), window);
+    ns_geo::PointSet2d cur(ps.begin() + (i + 1 - window), ps.begin() + (i + 1));
+    auto batch = ns_geo::SLine2::fit(cur), inc = fit.model();
+    double s = batch.a * inc.a + batch.b * inc.b < 0.0 ? -1.0 : 1.0;
+    EXPECT_NEAR(s * inc.a, batch.a, 1E-9);
+    EXPECT_NEAR(s * inc.b, batch.b, 1E-9);
+    EXPECT_NEAR(s * inc.c, batch.c, 1E-9 * std::abs(batch.c));
+  }
+
+  // merging the halves gives the fit of the whole
+  ns_geo::IncrementalLineFit lhs, rhs, all;
+  for (std::size_t i = 0; i != 300; ++i)
+    (i < 120 ? lhs : rhs).add(ps[i]), all.add(ps[i]);
+  lhs.merge(rhs);
+  EXPECT_EQ(lhs.size(), 300);
+  EXPECT_NEAR(lhs.centroid().x, all.centroid().x, 1E-9);
+  EXPECT_NEAR(lhs.model().a, all.model().a, 1E-12);
+  EXPECT_NEAR(lhs.model().b, all.model().b, 1E-12);
+
+  // emptied and reused
+  for (std::size_t i = 0; i != 300; ++i)
+    lhs.remove(ps[i]);
+  EXPECT_EQ(lhs.size(), 0);
+  lhs.add({0.0, 0.0}), lhs.add({1.0, 1.0});
+  EXPECT_NEAR(lhs.model().distance({5.0, 5.0}), 0.0, 1E-12);
+}
+
+TEST(IncrementalFit, circle) {
+  // a sliding window over noisy circles far from the origin and from each other, so the reference moves
+  std::normal_distribution<double> noise(0.0, 0.01);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 3000; ++i) {
+    double theta = 0.05 * i, cx = 1E3 + 50.0 * (i / 300), cy = -5E2;
+    ps.push_back({cx + (5.0 + noise(ns_geo::engine)) * std::cos(theta), cy + (5.0 + noise(ns_geo::engine)) * std::sin(theta)});
+  }
+  const std::size_t window = 60;
+  ns_geo::IncrementalCircleFit fit;
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    fit.add(ps[i]);
+    if (i >= window)
+      fit.remove(ps[i - window]);
+    // the windows on a single circle
+    if (i + 1 < window || i % 300 + 1 < window || i % 23 != 0)
+      continue;
+    ns_geo::PointSet2d cur(ps.begin() + (i + 1 - window), ps.begin() + (i + 1));
+    auto m = fit.moments(), mb = ns_geo::Circle::moments(cur);
+    EXPECT_NEAR(m.mean.x, mb.mean.x, 1E-9);
+    EXPECT_NEAR(m.xx, mb.xx, 1E-8);
+    EXPECT_NEAR(m.xz, mb.xz, 1E-7);
+    EXPECT_NEAR(m.zz, mb.zz, 1E-6 * mb.zz);
+    auto batch = ns_geo::Circle::taubin(cur), inc = fit.model();
+    EXPECT_NEAR(inc.cen.x, batch.cen.x, 1E-6);
+    EXPECT_NEAR(inc.cen.y, batch.cen.y, 1E-6);
+    EXPECT_NEAR(inc.rad, batch.rad, 1E-6);
+    EXPECT_NEAR(fit.kasa().rad, ns_geo::Circle::kasa(cur).rad, 1E-6);
+    EXPECT_NEAR(fit.pratt().rad, ns_geo::Circle::pratt(cur).rad, 1E-6);
+  }
+
+  // merging fits with different references
+  ns_geo::IncrementalCircleFit lhs, rhs;
+  for (std::size_t i = 0; i != 40; ++i)
+    lhs.add(ps[i]), rhs.add(ps[i + 40]);
+  lhs.merge(rhs);
+  ns_geo::PointSet2d cur(ps.begin(), ps.begin() + 80);
+  auto merged = lhs.model(), batch = ns_geo::Circle::taubin(cur);
+  EXPECT_EQ(lhs.size(), 80);
+  EXPECT_NEAR(merged.cen.x, batch.cen.x, 1E-8);
+  EXPECT_NEAR(merged.cen.y, batch.cen.y, 1E-8);
+  EXPECT_NEAR(merged.rad, batch.rad, 1E-8);
+}
+
+#endif
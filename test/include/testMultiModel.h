@@ -0,0 +1,112 @@
+#ifndef TEST_MULTIMODEL_H
+#define TEST_MULTIMODEL_H
+
+#include "helper.h"
+#include "include/multimodel.hpp"
+
+TEST(MultiModelExtractor, lines) {
+  // walls as segments, two of them on the same line far apart, and some clutter
+  std::vector<std::array<double, 4>> walls{{0.0, 0.0, 10.0, 0.0},  {30.0, 0.0, 40.0, 0.0}, {0.0, 2.0, 0.0, 12.0},
+                                           {5.0, 5.0, 12.0, 12.0}, {20.0, 10.0, 35.0, 4.0}, {-10.0, -8.0, 5.0, -8.5}};
+  std::normal_distribution<double> noise(0.0, 0.01);
+  std::uniform_real_distribution<double> u(0.0, 1.0), cx(-10.0, 40.0), cy(-10.0, 15.0);
+  ns_geo::PointSet2d ps;
+  std::vector<int> label;
+  for (std::size_t k = 0; k != walls.size(); ++k) {
+    const auto &w = walls[k];
+    for (int i = 0; i != 200; ++i) {
+      double t = u(ns_geo::engine);
+      ps.push_back({w[0] + t * (w[2] - w[0]) + noise(ns_geo::engine), w[1] + t * (w[3] - w[1]) + noise(ns_geo::engine)});
+      label.push_back(static_cast<int>(k));
+    }
+  }
+  for (int i = 0; i != 300; ++i)
+    ps.push_back({cx(ns_geo::engine), cy(ns_geo::engine)}), label.push_back(-1);
+
+  ns_geo::MultiModelOptions opt;
+  opt.ransac.threshold = 0.05;
+  opt.ransac.seed = 7;
+  opt.radius = 1.0;
+  opt.minInliers = 50;
+  auto res = ns_geo::MultiModelExtractor<ns_geo::LineEstimator>(opt).run(ps);
+  ASSERT_EQ(res.size(), walls.size());
+  std::vector<int> found(walls.size(), 0);
+  std::vector<char> taken(ps.size(), 0);
+  for (const auto &m : res) {
+    EXPECT_TRUE(std::is_sorted(m.inliers.cbegin(), m.inliers.cend()));
+    // the inliers come from one wall, besides the clutter close to it
+    std::vector<int> votes(walls.size(), 0);
+    for (auto i : m.inliers) {
+      EXPECT_FALSE(taken[i]);
+      taken[i] = 1;
+      EXPECT_LE(m.model.distance(ps[i]), opt.ransac.threshold);
+      if (label[i] >= 0)
+        ++votes[label[i]];
+    }
+    auto k = std::max_element(votes.cbegin(), votes.cend()) - votes.cbegin();
+    EXPECT_GE(votes[k], 190);
+    EXPECT_LE(static_cast<int>(m.inliers.size()) - votes[k], 10);
+    ++found[k];
+    const auto &w = walls[k];
+    EXPECT_LT(m.model.distance({w[0], w[1]}), 0.01);
+    EXPECT_LT(m.model.distance({w[2], w[3]}), 0.01);
+  }
+  EXPECT_EQ(found, std::vector<int>(walls.size(), 1));
+
+  // the same models whatever the thread count
+  for (std::size_t threads : {1, 16}) {
+    opt.ransac.threads = threads;
+    auto other = ns_geo::MultiModelExtractor<ns_geo::LineEstimator>(opt).run(ps);
+    ASSERT_EQ(other.size(), res.size()) << threads;
+    for (std::size_t k = 0; k != res.size(); ++k)
+      EXPECT_EQ(other[k].inliers, res[k].inliers) << threads;
+  }
+}
+
+TEST(MultiModelExtractor, collinear) {
+  // a horizontal wall and a far point on its line, the grid must stay small along 'x'
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 200; ++i)
+    ps.push_back({0.05 * i, 3.0});
+  ps.push_back({1E9, 3.0});
+
+  ns_geo::MultiModelOptions opt;
+  opt.ransac.threshold = 0.01;
+  opt.ransac.seed = 7;
+  opt.minInliers = 50;
+  auto res = ns_geo::MultiModelExtractor<ns_geo::LineEstimator>(opt).run(ps);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_EQ(res.front().inliers.size(), 200);
+  EXPECT_NEAR(res.front().model.distance({-5.0, 3.0}), 0.0, 1E-9);
+}
+
+TEST(MultiModelExtractor, circles) {
+  // poles of a few radii among clutter
+  std::vector<std::array<double, 3>> poles{{0.0, 0.0, 0.3}, {5.0, 1.0, 0.5}, {2.0, 6.0, 0.2}, {8.0, 7.0, 1.0}};
+  std::normal_distribution<double> noise(0.0, 0.005);
+  std::uniform_real_distribution<double> theta(0.0, 2.0 * M_PI), cx(-2.0, 10.0), cy(-2.0, 9.0);
+  ns_geo::PointSet2d ps;
+  for (const auto &p : poles)
+    for (int i = 0; i != 120; ++i) {
+      double t = theta(ns_geo::engine), r = p[2] + noise(ns_geo::engine);
+      ps.push_back({p[0] + r * std::cos(t), p[1] + r * std::sin(t)});
+    }
+  for (int i = 0; i != 100; ++i)
+    ps.push_back({cx(ns_geo::engine), cy(ns_geo::engine)});
+
+  ns_geo::MultiModelOptions opt;
+  opt.ransac.threshold = 0.02;
+  opt.radius = 0.5;
+  opt.minInliers = 40;
+  auto res = ns_geo::MultiModelExtractor<ns_geo::CircleEstimator>(opt).run(ps);
+  ASSERT_EQ(res.size(), poles.size());
+  for (const auto &p : poles) {
+    auto iter = std::find_if(res.cbegin(), res.cend(), [&p](const auto &m) {
+      return std::abs(m.model.cen.x - p[0]) < 0.01 && std::abs(m.model.cen.y - p[1]) < 0.01 && std::abs(m.model.rad - p[2]) < 0.01;
+    });
+    ASSERT_NE(iter, res.cend());
+    EXPECT_GE(iter->inliers.size(), 115);
+  }
+}
+
+#endif
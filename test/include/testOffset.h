@@ -0,0 +1,143 @@
+#ifndef TEST_OFFSET_H
+#define TEST_OFFSET_H
+
+#include "helper.h"
+#include "include/offset.hpp"
+
+using Offsetterd = ns_geo::Offsetter<double>;
+
+double offset_area(const ns_geo::MultiPolygon<double> &mp) {
+  double s = 0.0;
+  for (const auto &poly : mp)
+    s += poly.area();
+  return s;
+}
+
+TEST(Offsetter, polygon) {
+  ns_geo::Polygond square{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  const double d = 0.25;
+
+  auto res = Offsetterd::offset(square, d);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_NEAR(offset_area(res), (1.0 + 2.0 * d) * (1.0 + 2.0 * d), 1E-9);
+
+  // the rounded square, its arcs lie within the tolerance inside the true circles
+  res = Offsetterd::offset(square, d, ns_geo::JoinType::ROUND, 2.0, 1E-4);
+  double exact = (1.0 + 2.0 * d) * (1.0 + 2.0 * d) - (4.0 - M_PI) * d * d;
+  EXPECT_LT(offset_area(res), exact);
+  EXPECT_GT(offset_area(res), exact - 1E-3);
+
+  // the corners squared off at the distance
+  res = Offsetterd::offset(square, d, ns_geo::JoinType::SQUARE);
+  ASSERT_EQ(res.size(), 1);
+  double cut = d * (std::sqrt(2.0) - 1.0);
+  EXPECT_NEAR(offset_area(res), (1.0 + 2.0 * d) * (1.0 + 2.0 * d) - 4.0 * cut * cut, 1E-9);
+
+  // the winding of the input doesn't matter, and shrinking keeps the corners sharp
+  ns_geo::Polygond cw(square.rbegin(), square.rend());
+  res = Offsetterd::offset(cw, -d, ns_geo::JoinType::ROUND);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_NEAR(offset_area(res), (1.0 - 2.0 * d) * (1.0 - 2.0 * d), 1E-9);
+  EXPECT_TRUE(Offsetterd::offset(square, -0.6).empty());
+
+  // a sharp spike is cut at the miter limit, the full miter would reach about 2.0 away
+  ns_geo::Polygond spike{{0.0, 0.0}, {10.0, 0.0}, {0.0, 1.0}};
+  res = Offsetterd::offset(spike, 0.1, ns_geo::JoinType::MITER, 2.0);
+  ASSERT_EQ(res.size(), 1);
+  for (const auto &p : res.front().outer) {
+    if (p.x > 5.0) {
+      EXPECT_LT(std::hypot(p.x - 10.0, p.y), 0.25);
+    }
+  }
+}
+
+TEST(Offsetter, holes) {
+  ns_geo::Polygond outer{{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}};
+  ns_geo::PolygonWithHoles<double> frame(outer, {{{4.0, 4.0}, {6.0, 4.0}, {6.0, 6.0}, {4.0, 6.0}}});
+
+  // growing the region shrinks its hole
+  auto res = Offsetterd::offset(frame, 0.5);
+  ASSERT_EQ(res.size(), 1);
+  ASSERT_EQ(res.front().holes.size(), 1);
+  EXPECT_NEAR(offset_area(res), 11.0 * 11.0 - 1.0, 1E-9);
+  // and closes it at last
+  res = Offsetterd::offset(frame, 1.5);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_TRUE(res.front().holes.empty());
+
+  // shrinking grows the hole, with rounded corners around it
+  res = Offsetterd::offset(frame, -0.5, ns_geo::JoinType::ROUND, 2.0, 1E-5);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_NEAR(offset_area(res), 9.0 * 9.0 - (3.0 * 3.0 - (4.0 - M_PI) * 0.25), 1E-3);
+
+  // two squares merge once they grow into each other
+  ns_geo::MultiPolygon<double> two{ns_geo::PolygonWithHoles<double>({{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}),
+                                   ns_geo::PolygonWithHoles<double>({{2.0, 0.0}, {3.0, 0.0}, {3.0, 1.0}, {2.0, 1.0}})};
+  EXPECT_EQ(Offsetterd::offset(two, 0.4).size(), 2);
+  res = Offsetterd::offset(two, 0.6);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_NEAR(offset_area(res), 4.2 * 2.2, 1E-9);
+}
+
+TEST(Offsetter, buffer) {
+  const double d = 0.5;
+  ns_geo::LineString2d ls{{0.0, 0.0}, {4.0, 0.0}, {4.0, 3.0}};
+
+  // the round buffer of a polyline turning once: the strips overlap by a square inside
+  // the turn, a quarter disc fills the outside and the caps make up a whole disc
+  auto res = Offsetterd::buffer(ls, d, ns_geo::JoinType::ROUND, 2.0, 1E-5);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_TRUE(res.front().holes.empty());
+  EXPECT_NEAR(offset_area(res), 2.0 * d * 7.0 - d * d + 1.25 * M_PI * d * d, 1E-3);
+
+  // butt caps and a miter corner
+  res = Offsetterd::buffer(ls, d, ns_geo::JoinType::MITER);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_NEAR(offset_area(res), 2.0 * d * 7.0, 1E-9);
+
+  // square caps stick out by the distance
+  res = Offsetterd::buffer(ls, d, ns_geo::JoinType::SQUARE);
+  EXPECT_NEAR(offset_area(res), 2.0 * d * 8.0 - d * d * (std::sqrt(2.0) - 1.0) * (std::sqrt(2.0) - 1.0), 1E-9);
+
+  // a line string closing on itself leaves a hole
+  ns_geo::LineString2d loop{{0.0, 0.0}, {4.0, 0.0}, {4.0, 4.0}, {0.0, 4.0}, {0.0, -1.0}};
+  res = Offsetterd::buffer(loop, d, ns_geo::JoinType::MITER);
+  ASSERT_EQ(res.size(), 1);
+  EXPECT_EQ(res.front().holes.size(), 1);
+  EXPECT_NEAR(ns_geo::PolygonWithHoles<double>::signedArea(res.front().holes.front()), -9.0, 1E-9);
+
+  // a single point becomes a disc
+  res = Offsetterd::buffer(ns_geo::LineString2d{{1.0, 1.0}}, d, ns_geo::JoinType::ROUND, 2.0, 1E-5);
+  EXPECT_NEAR(offset_area(res), M_PI * d * d, 1E-4);
+}
+
+TEST(Offsetter, coastline) {
+  // a coastline-like ring with 10k vertices
+  const std::size_t n = 10000;
+  std::uniform_real_distribution<double> r(-0.02, 0.02);
+  ns_geo::Polygond ring;
+  for (std::size_t i = 0; i != n; ++i) {
+    double theta = 2.0 * M_PI * i / n;
+    double rad = 80.0 + 10.0 * std::sin(5.0 * theta) + 5.0 * std::sin(37.0 * theta) + r(ns_geo::engine);
+    ring.push_back({rad * std::cos(theta), rad * std::sin(theta)});
+  }
+  double base = std::abs(ns_geo::PolygonWithHoles<double>::signedArea(ring));
+  double perimeter = 0.0;
+  for (std::size_t i = 0; i != n; ++i)
+    perimeter += std::hypot(ring[(i + 1) % n].x - ring[i].x, ring[(i + 1) % n].y - ring[i].y);
+
+  auto grown = Offsetterd::offset(ring, 1.0, ns_geo::JoinType::ROUND, 2.0, 0.0, 4);
+  ASSERT_EQ(grown.size(), 1);
+  EXPECT_TRUE(grown.front().holes.empty());
+  double area = offset_area(grown);
+  // the band is at most the perimeter wide plus the full disc
+  EXPECT_GT(area, base);
+  EXPECT_LT(area, base + perimeter + M_PI);
+
+  auto shrunk = Offsetterd::offset(ring, -1.0, ns_geo::JoinType::ROUND, 2.0, 0.0, 4);
+  ASSERT_EQ(shrunk.size(), 1);
+  EXPECT_LT(offset_area(shrunk), base);
+  EXPECT_GT(offset_area(shrunk), base - perimeter);
+}
+
+#endif
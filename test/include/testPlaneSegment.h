@@ -0,0 +1,105 @@
+#ifndef TEST_PLANESEGMENT_H
+#define TEST_PLANESEGMENT_H
+
+#include "helper.h"
+#include "include/planesegment.hpp"
+
+/**
+ * @brief a corner of a room, the floor 'z = 0' and the walls 'x = 0' and 'y = 4', with some noise
+ */
+ns_geo::PointSet3f plane_segment_room(std::size_t num, std::vector<int> &face) {
+  std::uniform_real_distribution<float> u(0.0F, 4.0F), h(0.0F, 2.0F);
+  std::normal_distribution<float> noise(0.0F, 0.002F);
+  ns_geo::PointSet3f ps;
+  face.clear();
+  for (std::size_t i = 0; i != num; ++i) {
+    switch (i % 3) {
+    case 0:
+      ps.push_back({u(ns_geo::engine), u(ns_geo::engine), noise(ns_geo::engine)});
+      break;
+    case 1:
+      ps.push_back({noise(ns_geo::engine), u(ns_geo::engine), h(ns_geo::engine)});
+      break;
+    default:
+      ps.push_back({u(ns_geo::engine), 4.0F + noise(ns_geo::engine), h(ns_geo::engine)});
+    }
+    face.push_back(static_cast<int>(i % 3));
+  }
+  return ps;
+}
+
+TEST(PlaneSegmenter, ransac) {
+  std::vector<int> face;
+  auto ps = plane_segment_room(30000, face);
+  ns_geo::RansacOptions opt;
+  opt.threshold = 0.01;
+  auto res = ns_geo::PlaneSegmenter<float>::ransac(ps, opt);
+  ASSERT_TRUE(res.success());
+  // one of the three faces, each holds a third of the points
+  const auto &pl = *res.model;
+  EXPECT_NEAR(std::max({std::abs(pl.a), std::abs(pl.b), std::abs(pl.c)}), 1.0, 1E-4);
+  EXPECT_NEAR(res.inlierNum, 10000, 200);
+  EXPECT_LT(res.iterations, 1000);
+
+  // the estimator on its own
+  std::vector<ns_geo::Point3d> data{{0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, 1.0}, {2.0, 2.0, 1.0}};
+  std::size_t idx[4] = {0, 1, 2, 3};
+  auto fitted = ns_geo::PlaneEstimator().fit(data, idx, 3);
+  ASSERT_TRUE(fitted);
+  EXPECT_DOUBLE_EQ(std::abs(fitted->c), 1.0);
+  fitted = ns_geo::PlaneEstimator().fit(data, idx, 4);
+  ASSERT_TRUE(fitted);
+  EXPECT_NEAR(fitted->distance({5.0, -3.0, 1.0}), 0.0, 1E-12);
+  std::vector<ns_geo::Point3d> line{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, {2.0, 2.0, 2.0}};
+  EXPECT_FALSE(ns_geo::PlaneEstimator().fit(line, idx, 3));
+}
+
+TEST(PlaneSegmenter, regionGrowing) {
+  std::vector<int> face;
+  auto ps = plane_segment_room(30000, face);
+  ns_geo::RegionGrowingOptions opt;
+  opt.radius = 0.1;
+  opt.threads = 4;
+  ns_geo::PlaneSegmenter<float> seg(opt);
+
+  auto normals = seg.normals(ps);
+  ASSERT_EQ(normals.size(), ps.size());
+  // away from the edges the normals are the axes and the neighbourhoods are flat
+  std::size_t flat = 0, inner = 0;
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    const auto &p = ps[i];
+    // the distances to the three faces, but its own
+    std::array<float, 3> dis{p.z, p.x, 4.0F - p.y};
+    dis[face[i]] = 4.0F;
+    if (*std::min_element(dis.cbegin(), dis.cend()) < 0.2F)
+      continue;
+    ++inner;
+    const auto &n = normals[i];
+    double axis = face[i] == 0 ? n.nz : (face[i] == 1 ? n.nx : n.ny);
+    flat += std::abs(axis) > 0.99 && n.curvature < 0.01;
+  }
+  EXPECT_GT(flat, inner * 99 / 100);
+
+  auto res = seg.segment(ps);
+  ASSERT_EQ(res.regions.size(), 3);
+  ASSERT_EQ(res.planes.size(), 3);
+  std::size_t labelled = 0;
+  for (std::size_t r = 0; r != 3; ++r) {
+    // the region is one face
+    std::vector<std::size_t> votes(3, 0);
+    for (auto i : res.regions[r]) {
+      EXPECT_EQ(res.labels[i], static_cast<int>(r));
+      ++votes[face[i]];
+    }
+    auto f = std::max_element(votes.cbegin(), votes.cend()) - votes.cbegin();
+    EXPECT_GT(votes[f], res.regions[r].size() * 99 / 100);
+    EXPECT_GT(votes[f], 9000);
+    labelled += res.regions[r].size();
+    const auto &pl = res.planes[r];
+    double axis = f == 0 ? pl.c : (f == 1 ? pl.a : pl.b);
+    EXPECT_NEAR(std::abs(axis), 1.0, 1E-4);
+  }
+  EXPECT_EQ(labelled, static_cast<std::size_t>(ps.size() - std::count(res.labels.cbegin(), res.labels.cend(), -1)));
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TEST_PREPAREDLINESTRING_H
+#define TEST_PREPAREDLINESTRING_H
+
+#include "helper.h"
+#include "include/preparedlinestring.hpp"
+
+TEST(PreparedLineString2, interpolate) {
+  ns_geo::LineString2d ls{{0.0, 0.0}, {3.0, 0.0}, {3.0, 4.0}, {0.0, 4.0}};
+  ns_geo::PreparedLineString2<double> pls(ls);
+  EXPECT_DOUBLE_EQ(pls.length(), 10.0);
+  EXPECT_EQ(pls.cumulative(), (std::vector<double>{0.0, 3.0, 7.0, 10.0}));
+  test_point2d_eq(pls.interpolate(-1.0), {0.0, 0.0});
+  test_point2d_eq(pls.interpolate(1.5), {1.5, 0.0});
+  test_point2d_eq(pls.interpolate(3.0), {3.0, 0.0});
+  test_point2d_eq(pls.interpolate(5.0), {3.0, 2.0});
+  test_point2d_eq(pls.interpolate(10.0), {0.0, 4.0});
+  test_point2d_eq(pls.interpolate(12.0), {0.0, 4.0});
+
+  auto ps = pls.resample(4.0);
+  ASSERT_EQ(ps.size(), 4);
+  test_point2d_eq(ps[1], {3.0, 1.0});
+  test_point2d_eq(ps[2], {2.0, 4.0});
+  test_point2d_eq(ps[3], {0.0, 4.0});
+  EXPECT_EQ(pls.resample(2.5, 2).size(), 5);
+
+  auto at = pls.interpolate(std::vector<double>{1.0, 8.0}, 2);
+  test_point2d_eq(at[1], {2.0, 4.0});
+}
+
+TEST(PreparedLineString2, project) {
+  // a long random walk
+  std::uniform_real_distribution<double> u(-1.0, 1.0);
+  ns_geo::LineString2d ls{{0.0, 0.0}};
+  for (int i = 0; i != 3000; ++i)
+    ls.push_back({ls.back().x + u(ns_geo::engine) + 0.3, ls.back().y + u(ns_geo::engine)});
+  ns_geo::PreparedLineString2<double> pls(ls);
+
+  auto ps = ns_geo::PointSet2d::randomGenerator(500, -5.0, 1000.0, -40.0, 40.0);
+  auto res = pls.project(ps, 4);
+  ASSERT_EQ(res.size(), ps.size());
+  for (std::size_t k = 0; k != ps.size(); ++k) {
+    // brute force over all the segments
+    double best = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i + 1 < ls.size(); ++i) {
+      double dx = ls[i + 1].x - ls[i].x, dy = ls[i + 1].y - ls[i].y;
+      double t = std::min(1.0, std::max(0.0, ((ps[k].x - ls[i].x) * dx + (ps[k].y - ls[i].y) * dy) / (dx * dx + dy * dy)));
+      best = std::min(best, std::hypot(ps[k].x - ls[i].x - t * dx, ps[k].y - ls[i].y - t * dy));
+    }
+    EXPECT_NEAR(res[k].offset, best, 1E-9);
+    EXPECT_NEAR(std::hypot(res[k].point.x - ps[k].x, res[k].point.y - ps[k].y), best, 1E-9);
+    // the arc length leads back to the projected point
+    auto back = pls.interpolate(res[k].along);
+    EXPECT_NEAR(back.x, res[k].point.x, 1E-6);
+    EXPECT_NEAR(back.y, res[k].point.y, 1E-6);
+  }
+}
+
+TEST(PreparedLineString3, project) {
+  ns_geo::LineString3d ls{{0.0, 0.0, 0.0}, {0.0, 0.0, 10.0}, {5.0, 0.0, 10.0}};
+  ns_geo::PreparedLineString3<double> pls(ls);
+  EXPECT_DOUBLE_EQ(pls.length(), 15.0);
+  test_point3d_eq(pls.interpolate(12.0), {2.0, 0.0, 10.0});
+  // the planar boxes overlap, the height decides
+  auto pr = pls.project({1.0, 0.5, 9.0});
+  EXPECT_EQ(pr.segment, 1);
+  EXPECT_DOUBLE_EQ(pr.along, 11.0);
+  EXPECT_NEAR(pr.offset, std::sqrt(1.25), 1E-12);
+  pr = pls.project({0.2, 0.0, 3.0});
+  EXPECT_EQ(pr.segment, 0);
+  EXPECT_DOUBLE_EQ(pr.along, 3.0);
+  EXPECT_DOUBLE_EQ(pr.offset, 0.2);
+}
+
+TEST_F(TestRefPointSet2f, preparedLineString) {
+  ns_geo::PreparedLineString2<float> pls(_rps->createRefLineString2({3, 0, 1}));
+  EXPECT_NEAR(pls.length(), std::sqrt(5.0) + std::sqrt(2.0), 1E-5);
+  auto pr = pls.project({0.0f, 0.0f});
+  EXPECT_EQ(pr.segment, 0);
+  EXPECT_NEAR(pr.offset, 2.0 / std::sqrt(5.0), 1E-5);
+}
+
+#endif
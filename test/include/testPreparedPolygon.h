@@ -0,0 +1,61 @@
+#ifndef TEST_PREPAREDPOLYGON_H
+#define TEST_PREPAREDPOLYGON_H
+
+#include "helper.h"
+#include "include/preparedpolygon.hpp"
+
+/**
+ * @brief the plain crossing-number test the prepared polygon must agree with
+ */
+bool naive_contains(const ns_geo::Polygond &poly, const ns_geo::Point2d &p) {
+  bool in = false;
+  for (std::size_t i = 0, j = poly.size() - 1; i != poly.size(); j = i++) {
+    const auto &a = poly[i], &b = poly[j];
+    if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)
+      in = !in;
+  }
+  return in;
+}
+
+TEST(PreparedPolygon, concave) {
+  // a 'U' shape
+  ns_geo::Polygond poly{{0.0, 0.0}, {3.0, 0.0}, {3.0, 3.0}, {2.0, 3.0}, {2.0, 1.0}, {1.0, 1.0}, {1.0, 3.0}, {0.0, 3.0}};
+  ns_geo::PreparedPolygon<double> pp(poly);
+  EXPECT_TRUE(pp.contains({0.5, 2.5}));
+  EXPECT_TRUE(pp.contains({1.5, 0.5}));
+  EXPECT_FALSE(pp.contains({1.5, 2.0}));
+  EXPECT_FALSE(pp.contains({-1.0, 0.5}));
+  EXPECT_FALSE(pp.contains({4.0, 0.5}));
+
+  // a hole by the even-odd rule
+  pp.addRing(ns_geo::Polygond{{0.25, 0.25}, {0.75, 0.25}, {0.75, 0.75}, {0.25, 0.75}});
+  EXPECT_FALSE(pp.contains({0.5, 0.5}));
+  EXPECT_TRUE(pp.contains({0.1, 0.5}));
+}
+
+TEST(PreparedPolygon, batch) {
+  // a star with many vertices
+  ns_geo::Polygond poly;
+  for (int i = 0; i != 1000; ++i) {
+    double theta = 2.0 * M_PI * i / 1000, r = (i % 2 == 0) ? 10.0 : 4.0 + (i % 7);
+    poly.push_back({r * std::cos(theta), r * std::sin(theta)});
+  }
+  ns_geo::PreparedPolygon<double> pp(poly);
+  auto ps = ns_geo::PointSet2d::randomGenerator(5000, -11.0, 11.0, -11.0, 11.0);
+  auto mask = pp.contains(ps, 2);
+  ASSERT_EQ(mask.size(), (ps.size() + 63) / 64);
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    bool expect = naive_contains(poly, ps[i]);
+    EXPECT_EQ(pp.contains(ps[i]), expect);
+    EXPECT_EQ(ns_geo::PreparedPolygon<double>::test(mask, i), expect);
+  }
+}
+
+TEST_F(TestRefPointSet2f, preparedRefPolygon) {
+  auto polygon = _rps->createRefPolygon({0, 3, 5, 2, 1});
+  ns_geo::PreparedPolygon<float> pp(polygon);
+  EXPECT_TRUE(pp.contains({0.5f, 0.0f}));
+  EXPECT_FALSE(pp.contains({2.5f, 1.0f}));
+}
+
+#endif
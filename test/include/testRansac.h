@@ -0,0 +1,82 @@
+#ifndef TEST_RANSAC_H
+#define TEST_RANSAC_H
+
+#include "helper.h"
+#include "include/ransac.hpp"
+
+TEST(Ransac, line) {
+  // 'y = 0.5x + 1' with noise, and 60% outliers
+  std::normal_distribution<double> noise(0.0, 0.02);
+  std::uniform_real_distribution<double> u(-10.0, 10.0);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 400; ++i) {
+    double x = u(ns_geo::engine);
+    ps.push_back({x, 0.5 * x + 1.0 + noise(ns_geo::engine)});
+  }
+  for (int i = 0; i != 600; ++i)
+    ps.push_back({u(ns_geo::engine), u(ns_geo::engine)});
+
+  ns_geo::RansacOptions opt;
+  opt.threshold = 0.1;
+  opt.seed = 7;
+  ns_geo::Ransac<ns_geo::LineEstimator> ransac(opt);
+  auto res = ransac.run(ps);
+  ASSERT_TRUE(res.success());
+  const auto &l = *res.model;
+  EXPECT_NEAR(-l.a / l.b, 0.5, 1E-2);
+  EXPECT_NEAR(-l.c / l.b, 1.0, 2E-2);
+  ASSERT_EQ(res.inliers.size(), ps.size());
+  // all the true points and a few outliers near the line
+  EXPECT_GE(res.inlierNum, 395);
+  EXPECT_LE(res.inlierNum, 440);
+  for (int i = 0; i != 400; ++i)
+    EXPECT_EQ(res.inliers[i] != 0, l.distance(ps[i]) <= opt.threshold);
+  // the iterations adapt to the inlier ratio, far below the limit
+  EXPECT_LT(res.iterations, 200);
+
+  // the same seed gives the same result on any number of threads
+  for (std::size_t threads : {1, 16}) {
+    opt.threads = threads;
+    auto other = ns_geo::Ransac<ns_geo::LineEstimator>(opt).run(ps);
+    EXPECT_EQ(other.iterations, res.iterations) << threads;
+    EXPECT_EQ(other.inliers, res.inliers) << threads;
+    EXPECT_DOUBLE_EQ(other.cost, res.cost) << threads;
+  }
+
+  // too few data
+  EXPECT_FALSE(ransac.run({{1.0, 1.0}}).success());
+}
+
+TEST(Ransac, circle) {
+  std::normal_distribution<double> noise(0.0, 0.05);
+  std::uniform_real_distribution<double> u(0.0, 2.0 * M_PI), box(-20.0, 20.0);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 300; ++i) {
+    double theta = u(ns_geo::engine), r = 5.0 + noise(ns_geo::engine);
+    ps.push_back({3.0 + r * std::cos(theta), -2.0 + r * std::sin(theta)});
+  }
+  for (int i = 0; i != 300; ++i)
+    ps.push_back({box(ns_geo::engine), box(ns_geo::engine)});
+
+  ns_geo::RansacOptions opt;
+  opt.threshold = 0.2;
+  auto res = ns_geo::Ransac<ns_geo::CircleEstimator>(opt).run(ps);
+  ASSERT_TRUE(res.success());
+  double err = std::hypot(res.model->cen.x - 3.0, res.model->cen.y + 2.0) + std::abs(res.model->rad - 5.0);
+  EXPECT_LT(err, 0.05);
+  EXPECT_GE(res.inlierNum, 295);
+
+  // the fixed-count 'Circle::ransac' scores by the summed distance, which the outliers dominate
+  auto old = ns_geo::Circle::ransac(ps);
+  double oldErr = std::hypot(old.cen.x - 3.0, old.cen.y + 2.0) + std::abs(old.rad - 5.0);
+  EXPECT_LT(err, oldErr);
+
+  // without the preemptive test and local optimization it still finds the circle
+  opt.preemptive = 0, opt.localIterations = 0;
+  auto plain = ns_geo::Ransac<ns_geo::CircleEstimator>(opt).run(ps);
+  ASSERT_TRUE(plain.success());
+  EXPECT_LT(std::abs(plain.model->rad - 5.0), 0.2);
+  EXPECT_GE(plain.cost, res.cost);
+}
+
+#endif
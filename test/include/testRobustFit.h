@@ -0,0 +1,100 @@
+#ifndef TEST_ROBUSTFIT_H
+#define TEST_ROBUSTFIT_H
+
+#include "helper.h"
+#include "include/robustfit.hpp"
+
+TEST(Plane, normalTesting) {
+  ns_geo::Plane pl({0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, 1.0});
+  EXPECT_DOUBLE_EQ(pl.c, 1.0);
+  EXPECT_DOUBLE_EQ(pl.signedDistance({3.0, 4.0, 3.0}), 2.0);
+  EXPECT_DOUBLE_EQ(pl.distance({3.0, 4.0, -1.0}), 2.0);
+  test_point3d_eq(pl.nearest({3.0, 4.0, -1.0}), {3.0, 4.0, 1.0});
+  EXPECT_EQ(pl.type(), ns_geo::GeoType::PLANE);
+
+  // 'x + 2y - z + 3 = 0' through scattered points
+  ns_geo::PointSet3d ps;
+  std::uniform_real_distribution<double> u(-10.0, 10.0);
+  for (int i = 0; i != 50; ++i) {
+    double x = u(ns_geo::engine), y = u(ns_geo::engine);
+    ps.push_back({x, y, x + 2.0 * y + 3.0});
+  }
+  pl = ns_geo::Plane::fit(ps);
+  for (const auto &p : ps)
+    EXPECT_NEAR(pl.distance(p), 0.0, 1E-9);
+  EXPECT_NEAR(std::abs(pl.b / pl.a), 2.0, 1E-9);
+}
+
+TEST(RobustFitter, line) {
+  // 'y = 2x - 1' with a tenth of gross errors on one side
+  std::normal_distribution<double> noise(0.0, 0.05);
+  std::uniform_real_distribution<double> u(0.0, 10.0), gross(5.0, 30.0);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 500; ++i) {
+    double x = u(ns_geo::engine);
+    ps.push_back({x, 2.0 * x - 1.0 + (i % 10 == 0 ? gross(ns_geo::engine) : noise(ns_geo::engine))});
+  }
+  auto plain = ns_geo::SLine2::fit(ps);
+  double plainErr = std::abs(-plain.c / plain.b + 1.0);
+  for (auto loss : {ns_geo::Loss::HUBER, ns_geo::Loss::TUKEY, ns_geo::Loss::CAUCHY}) {
+    ns_geo::RobustOptions opt;
+    opt.loss = loss;
+    ns_geo::RobustFitter fitter(opt);
+    auto l = fitter.fitLine(ps);
+    EXPECT_NEAR(-l.a / l.b, 2.0, 2E-2);
+    EXPECT_LT(std::abs(-l.c / l.b + 1.0), plainErr);
+    EXPECT_GT(fitter.iterations(), 0);
+    ASSERT_EQ(fitter.weights().size(), ps.size());
+    // the gross errors weigh less than the rest
+    EXPECT_LT(fitter.weights()[0], fitter.weights()[1]);
+    if (loss == ns_geo::Loss::TUKEY) {
+      EXPECT_NEAR(-l.c / l.b, -1.0, 2E-2);
+      EXPECT_DOUBLE_EQ(fitter.weights()[0], 0.0);
+    }
+  }
+}
+
+TEST(RobustFitter, circleAndPlane) {
+  // heavy-tailed noise from a student-t distribution
+  std::student_t_distribution<double> heavy(1.5);
+  std::uniform_real_distribution<double> u(0.0, 2.0 * M_PI);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 400; ++i) {
+    double theta = u(ns_geo::engine), r = 10.0 + 0.05 * heavy(ns_geo::engine);
+    ps.push_back({-4.0 + r * std::cos(theta), 6.0 + r * std::sin(theta)});
+  }
+  ns_geo::RobustOptions opt;
+  opt.loss = ns_geo::Loss::CAUCHY;
+  ns_geo::RobustFitter fitter(opt);
+  auto cir = fitter.fitCircle(ps);
+  EXPECT_NEAR(cir.cen.x, -4.0, 2E-2);
+  EXPECT_NEAR(cir.cen.y, 6.0, 2E-2);
+  EXPECT_NEAR(cir.rad, 10.0, 2E-2);
+
+  // a tilted plane with a cluster of outliers above it, the same fitter again
+  ns_geo::PointSet3d pts;
+  std::normal_distribution<double> noise(0.0, 0.01);
+  std::uniform_real_distribution<double> v(-5.0, 5.0);
+  for (int i = 0; i != 300; ++i) {
+    double x = v(ns_geo::engine), y = v(ns_geo::engine);
+    pts.push_back({x, y, 0.3 * x - 0.2 * y + 1.0 + noise(ns_geo::engine) + (i % 8 == 0 ? 3.0 : 0.0)});
+  }
+  auto pl = fitter.fitPlane(pts);
+  EXPECT_NEAR(-pl.a / pl.c, 0.3, 1E-2);
+  EXPECT_NEAR(-pl.b / pl.c, -0.2, 1E-2);
+  EXPECT_NEAR(-pl.d / pl.c, 1.0, 2E-2);
+  EXPECT_GT(std::abs(-ns_geo::Plane::fit(pts).d / ns_geo::Plane::fit(pts).c - 1.0), 0.1);
+}
+
+TEST(RobustFitter, empty) {
+  // a model of NaNs, as for 'SLine2::fit'
+  EXPECT_TRUE(std::isnan(ns_geo::Plane::fit(ns_geo::PointSet3d()).a));
+  ns_geo::RobustFitter fitter;
+  EXPECT_TRUE(std::isnan(fitter.fitLine(ns_geo::PointSet2d()).a));
+  EXPECT_EQ(fitter.iterations(), 0);
+  EXPECT_TRUE(std::isnan(fitter.fitPlane(ns_geo::PointSet3d()).d));
+  EXPECT_TRUE(std::isnan(fitter.fitCircle(ns_geo::PointSet2d()).rad));
+  EXPECT_TRUE(fitter.weights().empty());
+}
+
+#endif
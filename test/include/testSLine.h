@@ -20,4 +20,51 @@ TEST(SLine2, normalTesting) {
   EXPECT_EQ(l.type(), ns_geo::GeoType::SLINE2);
 }
 
+TEST(SLine2, fit) {
+  // a near-vertical line 'x = 0.001y + 3' with noise, where 'y = kx + b' breaks down
+  std::normal_distribution<double> noise(0.0, 0.01);
+  std::uniform_real_distribution<double> u(-50.0, 50.0);
+  ns_geo::PointSet2d ps;
+  for (int i = 0; i != 500; ++i) {
+    double y = u(ns_geo::engine);
+    ps.push_back({0.001 * y + 3.0 + noise(ns_geo::engine), y});
+  }
+  auto l = ns_geo::SLine2::fit(ps);
+  EXPECT_NEAR(-l.b / l.a, 0.001, 1E-4);
+  EXPECT_NEAR(-l.c / l.a, 3.0, 1E-2);
+  // the orthogonal fit beats the two end points in the summed squared distance
+  double fitCost = 0.0, pairCost = 0.0;
+  ns_geo::SLine2 pair(ps.front(), ps.back());
+  for (const auto &p : ps)
+    fitCost += l.distance(p) * l.distance(p), pairCost += pair.distance(p) * pair.distance(p);
+  EXPECT_LE(fitCost, pairCost);
+
+  // exactly vertical and exactly horizontal
+  l = ns_geo::SLine2::fit({{2.0, 0.0}, {2.0, 1.0}, {2.0, 5.0}});
+  EXPECT_NEAR(l.b, 0.0, 1E-15);
+  EXPECT_NEAR(l.distance({5.0, 9.0}), 3.0, 1E-12);
+  l = ns_geo::SLine2::fit({{0.0, -1.0}, {3.0, -1.0}, {1.0, -1.0}});
+  EXPECT_NEAR(l.a, 0.0, 1E-15);
+  EXPECT_NEAR(l.distance({0.0, 1.0}), 2.0, 1E-12);
+
+  // a zero weight ignores the outlier
+  ps = {{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}, {0.0, 10.0}};
+  l = ns_geo::SLine2::fit(ps, {1.0, 1.0, 1.0, 1.0, 0.0});
+  EXPECT_NEAR(l.distance({5.0, 5.0}), 0.0, 1E-12);
+  EXPECT_GT(ns_geo::SLine2::fit(ps).distance({5.0, 5.0}), 0.1);
+
+  // the line through two points
+  ns_geo::SLine2 two({1.0, 2.0}, {1.0, 7.0});
+  EXPECT_DOUBLE_EQ(two.distance({4.0, 0.0}), 3.0);
+  EXPECT_DOUBLE_EQ(two.distance({1.0, 100.0}), 0.0);
+  // a repeated point gives the horizontal line through it
+  ns_geo::SLine2 same({1.0, 2.0}, {1.0, 2.0});
+  EXPECT_DOUBLE_EQ(same.distance({1.0, 2.0}), 0.0);
+  EXPECT_DOUBLE_EQ(same.distance({-3.0, 5.0}), 3.0);
+
+  // no points, no line
+  EXPECT_TRUE(std::isnan(ns_geo::SLine2::fit(ns_geo::PointSet2d()).a));
+  EXPECT_TRUE(std::isnan(ns_geo::SLine2::fit(ns_geo::PointSet2d(), {}).a));
+}
+
 #endif
\ No newline at end of file
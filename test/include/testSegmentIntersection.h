@@ -0,0 +1,73 @@
+#ifndef TEST_SEGMENTINTERSECTION_H
+#define TEST_SEGMENTINTERSECTION_H
+
+#include "helper.h"
+#include "include/segmentintersection.hpp"
+
+TEST(SegmentIntersector, lines) {
+  std::uniform_real_distribution<double> u(0.0, 100.0), d(-4.0, 4.0);
+  std::vector<ns_geo::Line2d> lines;
+  for (int i = 0; i != 1500; ++i) {
+    double x = u(ns_geo::engine), y = u(ns_geo::engine);
+    lines.emplace_back(x, y, x + d(ns_geo::engine), y + d(ns_geo::engine));
+  }
+  // a few long ones crossing many tiles, and some on the grid lines
+  lines.emplace_back(0.0, 0.0, 100.0, 100.0);
+  lines.emplace_back(0.0, 50.0, 100.0, 50.0);
+  lines.emplace_back(50.0, 0.0, 50.0, 100.0);
+  lines.emplace_back(20.0, 50.0, 80.0, 50.0);
+
+  std::vector<std::pair<uint, uint>> expect;
+  ns_geo::Point2d p;
+  for (uint i = 0; i != lines.size(); ++i)
+    for (uint j = i + 1; j != lines.size(); ++j)
+      if (ns_geo::SegmentIntersector<double>::intersect(lines[i], lines[j], p) != 0)
+        expect.push_back({i, j});
+
+  ns_geo::SegmentIntersector<double> si(lines);
+  EXPECT_EQ(si.size(), lines.size());
+  for (std::size_t threads : {1, 4}) {
+    auto res = si.crossings(threads);
+    std::vector<std::pair<uint, uint>> pairs;
+    for (const auto &c : res)
+      pairs.push_back({c.first, c.second});
+    EXPECT_EQ(pairs, expect);
+  }
+
+  // the overlap of the two horizontal lines starts at its left end
+  auto res = si.crossings();
+  auto iter = std::find_if(res.cbegin(), res.cend(), [&](const auto &c) { return c.first == 1501 && c.second == 1503; });
+  ASSERT_NE(iter, res.cend());
+  EXPECT_EQ(iter->point.x, 20.0);
+  EXPECT_EQ(iter->point.y, 50.0);
+}
+
+TEST(SegmentIntersector, lineStrings) {
+  std::vector<ns_geo::LineString2d> roads{
+      // a closed square, whose consecutive segments only touch
+      {{0.0, 0.0}, {4.0, 0.0}, {4.0, 4.0}, {0.0, 4.0}, {0.0, 0.0}},
+      // crosses the square twice
+      {{-1.0, 2.0}, {2.0, 2.0}, {5.0, 3.0}},
+      // folds back over itself
+      {{10.0, 0.0}, {12.0, 0.0}, {11.0, 0.0}}};
+  ns_geo::SegmentIntersector<double> si(roads);
+  EXPECT_EQ(si.size(), 8);
+  EXPECT_EQ(si.locate(5), std::make_pair(std::size_t(1), std::size_t(1)));
+
+  auto res = si.crossings(2);
+  ASSERT_EQ(res.size(), 3);
+  EXPECT_EQ(res[0].first, 1);
+  EXPECT_EQ(res[0].second, 5);
+  EXPECT_NEAR(res[0].point.x, 4.0, 1E-12);
+  EXPECT_NEAR(res[0].point.y, 2.0 + 2.0 / 3.0, 1E-12);
+  EXPECT_EQ(res[1].first, 3);
+  EXPECT_EQ(res[1].second, 4);
+  EXPECT_EQ(res[1].point.x, 0.0);
+  EXPECT_EQ(res[1].point.y, 2.0);
+  EXPECT_EQ(res[2].first, 6);
+  EXPECT_EQ(res[2].second, 7);
+  EXPECT_EQ(res[2].point.x, 11.0);
+  EXPECT_EQ(res[2].point.y, 0.0);
+}
+
+#endif
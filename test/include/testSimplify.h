@@ -0,0 +1,104 @@
+#ifndef TEST_SIMPLIFY_H
+#define TEST_SIMPLIFY_H
+
+#include "helper.h"
+#include "include/simplify.hpp"
+
+using Simplifierd = ns_geo::Simplifier<double>;
+
+/**
+ * @brief the max distance of the dropped vertices to the kept segment spanning them
+ */
+double simplify_deviation(const ns_geo::LineString2d &ls, const std::vector<std::size_t> &kept) {
+  double worst = 0.0;
+  for (std::size_t j = 0; j + 1 < kept.size(); ++j) {
+    const auto &a = ls[kept[j]], &b = ls[kept[j + 1]];
+    double dx = b.x - a.x, dy = b.y - a.y, len2 = dx * dx + dy * dy;
+    for (std::size_t i = kept[j] + 1; i < kept[j + 1]; ++i) {
+      double t = std::min(1.0, std::max(0.0, ((ls[i].x - a.x) * dx + (ls[i].y - a.y) * dy) / len2));
+      worst = std::max(worst, std::hypot(ls[i].x - a.x - t * dx, ls[i].y - a.y - t * dy));
+    }
+  }
+  return worst;
+}
+
+ns_geo::LineString2d make_trajectory(std::size_t n, double noise) {
+  std::uniform_real_distribution<double> u(-noise, noise);
+  ns_geo::LineString2d ls;
+  for (std::size_t i = 0; i != n; ++i) {
+    double t = 0.01 * i;
+    ls.push_back({t, std::sin(t) * 3.0 + u(ns_geo::engine)});
+  }
+  return ls;
+}
+
+TEST(Simplifier, douglasPeucker) {
+  auto ls = make_trajectory(5000, 0.01);
+  auto kept = Simplifierd::douglasPeucker(ls, 0.05);
+  ASSERT_GE(kept.size(), 3);
+  EXPECT_LT(kept.size(), ls.size() / 10);
+  EXPECT_EQ(kept.front(), 0);
+  EXPECT_EQ(kept.back(), ls.size() - 1);
+  EXPECT_TRUE(std::is_sorted(kept.cbegin(), kept.cend()));
+  EXPECT_LE(simplify_deviation(ls, kept), 0.05);
+
+  // a straight line collapses to its end points
+  ns_geo::LineString2d line{{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}};
+  EXPECT_EQ(Simplifierd::douglasPeucker(line, 1E-9), (std::vector<std::size_t>{0, 3}));
+
+  ns_geo::LineString3d ls3{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.51}, {2.0, 0.0, 1.0}, {3.0, 0.0, 0.0}};
+  EXPECT_EQ(Simplifierd::douglasPeucker(ls3, 0.1), (std::vector<std::size_t>{0, 2, 3}));
+
+  // a square with points along its sides keeps its corners
+  ns_geo::Polygond square{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {2.0, 1.0}, {2.0, 2.0}, {1.0, 2.0}, {0.0, 2.0}, {0.0, 1.0}};
+  EXPECT_EQ(Simplifierd::douglasPeucker(square, 1E-6), (std::vector<std::size_t>{0, 2, 4, 6}));
+  EXPECT_EQ(Simplifierd::douglasPeucker(square, 10.0).size(), 3);
+}
+
+TEST(Simplifier, visvalingam) {
+  auto ls = make_trajectory(5000, 0.01);
+  auto kept = Simplifierd::visvalingam(ls, 0.01);
+  EXPECT_LT(kept.size(), ls.size() / 10);
+  EXPECT_EQ(kept.front(), 0);
+  EXPECT_EQ(kept.back(), ls.size() - 1);
+  // every surviving interior vertex spans a big enough triangle
+  for (std::size_t j = 1; j + 1 < kept.size(); ++j) {
+    const auto &a = ls[kept[j - 1]], &b = ls[kept[j]], &c = ls[kept[j + 1]];
+    EXPECT_GE(0.5 * std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)), 0.01);
+  }
+  // a bigger threshold keeps a subset
+  auto coarse = Simplifierd::visvalingam(ls, 0.1);
+  EXPECT_LT(coarse.size(), kept.size());
+  EXPECT_TRUE(std::includes(kept.cbegin(), kept.cend(), coarse.cbegin(), coarse.cend()));
+
+  ns_geo::Polygond square{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {2.0, 1.0}, {2.0, 2.0}, {1.0, 2.0}, {0.0, 2.0}, {0.0, 1.0}};
+  EXPECT_EQ(Simplifierd::visvalingam(square, 1E-6), (std::vector<std::size_t>{0, 2, 4, 6}));
+  EXPECT_EQ(Simplifierd::visvalingam(square, 100.0).size(), 3);
+}
+
+TEST(Simplifier, batch) {
+  std::vector<ns_geo::LineString2d> trajectories;
+  for (int i = 0; i != 64; ++i)
+    trajectories.push_back(make_trajectory(2000, 0.02));
+  auto dp = Simplifierd::douglasPeuckerBatch(trajectories, 0.05, 4);
+  auto vw = Simplifierd::visvalingamBatch(trajectories, 0.01, 4);
+  ASSERT_EQ(dp.size(), trajectories.size());
+  ASSERT_EQ(vw.size(), trajectories.size());
+  for (std::size_t i = 0; i != trajectories.size(); ++i) {
+    EXPECT_EQ(dp[i], Simplifierd::douglasPeucker(trajectories[i], 0.05));
+    EXPECT_EQ(vw[i], Simplifierd::visvalingam(trajectories[i], 0.01));
+  }
+  auto simplified = Simplifierd::pick(trajectories[0], dp[0]);
+  EXPECT_EQ(simplified.size(), dp[0].size());
+  EXPECT_DOUBLE_EQ(simplified.back().x, trajectories[0].back().x);
+}
+
+TEST_F(TestRefPointSet2f, simplify) {
+  auto ls = _rps->createRefLineString2({0, 1, 2, 4});
+  EXPECT_EQ(ns_geo::Simplifier<float>::douglasPeucker(ls, 1E-3), (std::vector<std::size_t>{0, 1, 2, 3}));
+  EXPECT_EQ(ns_geo::Simplifier<float>::douglasPeucker(ls, 10.0), (std::vector<std::size_t>{0, 3}));
+  EXPECT_EQ(ns_geo::Simplifier<float>::visvalingam(ls, 1E-3), (std::vector<std::size_t>{0, 1, 2, 3}));
+  EXPECT_EQ(ns_geo::Simplifier<float>::visvalingam(ls, 10.0), (std::vector<std::size_t>{0, 3}));
+}
+
+#endif
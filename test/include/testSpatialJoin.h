@@ -0,0 +1,66 @@
+#ifndef TEST_SPATIALJOIN_H
+#define TEST_SPATIALJOIN_H
+
+#include "helper.h"
+#include "include/spatialjoin.hpp"
+
+TEST(RTree, query) {
+  std::vector<ns_geo::RTree::box_type> boxes;
+  for (int i = 0; i != 50; ++i)
+    for (int j = 0; j != 50; ++j)
+      boxes.push_back({double(i), double(j), i + 0.5, j + 0.5});
+  ns_geo::RTree tree(boxes, 4);
+  EXPECT_EQ(tree.size(), 2500);
+  auto res = tree.query({10.2, 10.2, 12.2, 11.2});
+  std::sort(res.begin(), res.end());
+  EXPECT_EQ(res, (std::vector<std::size_t>{10 * 50 + 10, 10 * 50 + 11, 11 * 50 + 10, 11 * 50 + 11, 12 * 50 + 10, 12 * 50 + 11}));
+  EXPECT_TRUE(tree.query({0.6, 0.6, 0.9, 0.9}).empty());
+
+  // the box distance is the item distance here
+  double best = std::numeric_limits<double>::infinity();
+  auto item = tree.nearest(10.8, 3.2, [&](std::size_t i) { return ns_geo::RTree::boxDistance(boxes[i], 10.8, 3.2); }, best);
+  EXPECT_EQ(item, 11 * 50 + 3);
+  EXPECT_NEAR(best, 0.2, 1E-12);
+  best = 0.1;
+  EXPECT_EQ(tree.nearest(10.8, 3.2, [&](std::size_t i) { return ns_geo::RTree::boxDistance(boxes[i], 10.8, 3.2); }, best), tree.size());
+}
+
+TEST(SpatialJoin, grid) {
+  // 20 x 20 unit squares with gaps, plus a big overlapping triangle
+  std::vector<ns_geo::Polygond> polys;
+  for (int i = 0; i != 20; ++i)
+    for (int j = 0; j != 20; ++j)
+      polys.push_back(ns_geo::Polygond{{i + 0.0, j + 0.0}, {i + 0.9, j + 0.0}, {i + 0.9, j + 0.9}, {i + 0.0, j + 0.9}});
+  polys.push_back(ns_geo::Polygond{{0.0, 0.0}, {20.0, 0.0}, {0.0, 20.0}});
+  ns_geo::SpatialJoin<double> join(polys);
+
+  auto ps = ns_geo::PointSet2d::randomGenerator(20000, -1.0, 21.0, -1.0, 21.0);
+  auto res = join.join(ps, 3);
+  ASSERT_EQ(res.size(), ps.size());
+  std::vector<ns_geo::PreparedPolygon<double>> prepared;
+  for (const auto &poly : polys)
+    prepared.emplace_back(poly);
+  for (std::size_t i = 0; i != ps.size(); ++i) {
+    int expect = ns_geo::SpatialJoin<double>::NONE;
+    for (std::size_t k = 0; k != polys.size() && expect == ns_geo::SpatialJoin<double>::NONE; ++k)
+      if (prepared[k].contains(ps[i]))
+        expect = static_cast<int>(k);
+    EXPECT_EQ(res[i], expect);
+  }
+}
+
+TEST_F(TestRefPointSet2f, spatialJoin) {
+  std::vector<ns_geo::RefPolygonf> polys{_rps->createRefPolygon({3, 5, 1}), _rps->createRefPolygon({5, 4, 2})};
+  ns_geo::SpatialJoin<float> join(polys);
+
+  ns_geo::RefPointSet2f queries;
+  queries.insert(ns_geo::RefPoint2f(7, 0.0f, 0.0f));
+  queries.insert(ns_geo::RefPoint2f(3, 2.0f, -1.2f));
+  queries.insert(ns_geo::RefPoint2f(5, 5.0f, 5.0f));
+  auto res = join.join(queries, 2);
+  ASSERT_EQ(res.size(), 2);
+  EXPECT_EQ(res[0], std::make_pair(3u, 1));
+  EXPECT_EQ(res[1], std::make_pair(7u, 0));
+}
+
+#endif
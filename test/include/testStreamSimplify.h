@@ -0,0 +1,76 @@
+#ifndef TEST_STREAMSIMPLIFY_H
+#define TEST_STREAMSIMPLIFY_H
+
+#include "helper.h"
+#include "include/simplify.hpp"
+#include "include/streamsimplify.hpp"
+
+ns_geo::LineString2d make_gps_track(std::size_t n) {
+  std::normal_distribution<double> turn(0.0, 0.15), jitter(0.0, 0.05);
+  ns_geo::LineString2d ls;
+  double x = 0.0, y = 0.0, heading = 0.0;
+  for (std::size_t i = 0; i != n; ++i) {
+    heading += turn(ns_geo::engine);
+    x += std::cos(heading), y += std::sin(heading);
+    ls.push_back({x + jitter(ns_geo::engine), y + jitter(ns_geo::engine)});
+  }
+  return ls;
+}
+
+TEST(StreamSimplifier, errorBound) {
+  auto ls = make_gps_track(20000);
+  const double tol = 0.5;
+  ns_geo::StreamSimplifier<double> ss(tol);
+  // flush now and then, as a stream would be stored
+  ns_geo::LineString2d out;
+  for (std::size_t i = 0; i != ls.size(); ++i) {
+    ss.push(ls[i]);
+    if (i % 1000 == 999) {
+      auto part = ss.flush();
+      out.insert(out.end(), part.begin(), part.end());
+    }
+  }
+  ss.finish();
+  auto part = ss.flush();
+  out.insert(out.end(), part.begin(), part.end());
+  EXPECT_EQ(ss.consumed(), ls.size());
+  EXPECT_EQ(ss.retainedNum(), out.size());
+  EXPECT_EQ(out.size(), ns_geo::StreamSimplifier<double>::simplify(ls, tol).size());
+
+  // the retained vertices are a subsequence, every dropped point is close to its segment
+  std::size_t j = 0;
+  std::vector<std::size_t> kept;
+  for (std::size_t i = 0; i != ls.size() && j != out.size(); ++i)
+    if (ls[i].x == out[j].x && ls[i].y == out[j].y)
+      kept.push_back(i), ++j;
+  ASSERT_EQ(kept.size(), out.size());
+  EXPECT_EQ(kept.front(), 0);
+  EXPECT_EQ(kept.back(), ls.size() - 1);
+  for (std::size_t k = 0; k + 1 < kept.size(); ++k) {
+    const auto &a = ls[kept[k]], &b = ls[kept[k + 1]];
+    double dx = b.x - a.x, dy = b.y - a.y, len2 = dx * dx + dy * dy;
+    for (std::size_t i = kept[k] + 1; i < kept[k + 1]; ++i) {
+      double t = std::min(1.0, std::max(0.0, ((ls[i].x - a.x) * dx + (ls[i].y - a.y) * dy) / len2));
+      EXPECT_LE(std::hypot(ls[i].x - a.x - t * dx, ls[i].y - a.y - t * dy), tol + 1E-9);
+    }
+  }
+
+  // the online result stays close to the offline Douglas-Peucker one in size
+  auto dp = ns_geo::Simplifier<double>::douglasPeucker(ls, tol);
+  EXPECT_LT(out.size(), ls.size() / 3);
+  EXPECT_LT(out.size(), 2 * dp.size());
+}
+
+TEST(StreamSimplifier, degenerate) {
+  ns_geo::StreamSimplifier<double> ss(0.1);
+  ss.finish();
+  EXPECT_TRUE(ss.retained().empty());
+  // repeated points, a straight run and a U-turn
+  ns_geo::LineString2d ls{{0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {2.0, 0.0}, {1.0, 0.0}};
+  auto out = ns_geo::StreamSimplifier<double>::simplify(ls, 0.1);
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_DOUBLE_EQ(out[1].x, 3.0);
+  EXPECT_DOUBLE_EQ(out[2].x, 1.0);
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef TEST_VALIDATOR_H
+#define TEST_VALIDATOR_H
+
+#include "helper.h"
+#include "include/segmentintersection.hpp"
+#include "include/validator.hpp"
+
+using PolygonValidatord = ns_geo::PolygonValidator<double>;
+
+/**
+ * @brief whether two non-adjacent edges meet, by testing all the pairs
+ */
+bool validator_brute_force(const ns_geo::Polygond &poly) {
+  std::size_t n = poly.size();
+  ns_geo::Point2d p;
+  for (std::size_t i = 0; i != n; ++i)
+    for (std::size_t j = i + 2; j < n; ++j) {
+      if (i == 0 && j == n - 1)
+        continue;
+      ns_geo::Line2d a(poly[i], poly[(i + 1) % n]), b(poly[j], poly[(j + 1) % n]);
+      if (ns_geo::SegmentIntersector<double>::intersect(a, b, p) != 0)
+        return true;
+    }
+  return false;
+}
+
+TEST(PolygonValidator, check) {
+  ns_geo::Polygond square{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  auto rep = PolygonValidatord::check(square);
+  EXPECT_TRUE(rep.valid());
+  EXPECT_EQ(rep.orientation, ns_geo::Orientation::COUNTER_CLOCKWISE);
+
+  // the bow tie crosses itself, its halves cancel out in the shoelace sum
+  ns_geo::Polygond bowtie{{0.0, 0.0}, {1.0, 1.0}, {1.0, 0.0}, {0.0, 1.0}};
+  rep = PolygonValidatord::check(bowtie);
+  EXPECT_FALSE(rep.valid());
+  EXPECT_TRUE(rep.selfIntersecting);
+  EXPECT_EQ(rep.crossing, (std::array<std::size_t, 2>{0, 2}));
+  EXPECT_EQ(rep.orientation, ns_geo::Orientation::DEGENERATE);
+
+  // repeated vertices, also across the closing edge
+  ns_geo::Polygond dup{{0.0, 0.0}, {1.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}};
+  rep = PolygonValidatord::check(dup);
+  EXPECT_TRUE(rep.valid());
+  EXPECT_EQ(rep.duplicates, (std::vector<std::size_t>{0, 2}));
+  EXPECT_EQ(PolygonValidatord::removeDuplicates(dup), 2);
+  EXPECT_EQ(dup.size(), 4);
+
+  // a spike running out of the square and back
+  ns_geo::Polygond spike{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  rep = PolygonValidatord::check(spike);
+  EXPECT_FALSE(rep.valid());
+  EXPECT_EQ(rep.spikes, (std::vector<std::size_t>{2}));
+
+  // two squares touching at a vertex
+  ns_geo::Polygond touch{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {2.0, 1.0}, {2.0, 2.0}, {1.0, 2.0}, {1.0, 1.0}, {0.0, 1.0}};
+  EXPECT_FALSE(PolygonValidatord::isSimple(touch));
+
+  EXPECT_FALSE(PolygonValidatord::isValid({{0.0, 0.0}, {1.0, 1.0}}));
+  EXPECT_FALSE(PolygonValidatord::isValid({{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}}));
+
+  // fix the winding in place
+  ns_geo::Polygond cw(square.rbegin(), square.rend());
+  EXPECT_EQ(PolygonValidatord::orientation(cw), ns_geo::Orientation::CLOCKWISE);
+  EXPECT_TRUE(PolygonValidatord::fixOrientation(cw));
+  EXPECT_FALSE(PolygonValidatord::fixOrientation(cw));
+  EXPECT_EQ(PolygonValidatord::orientation(cw), ns_geo::Orientation::COUNTER_CLOCKWISE);
+  EXPECT_TRUE(PolygonValidatord::fixOrientation(cw, false));
+  test_point2d_eq(cw[1], {1.0, 1.0});
+}
+
+TEST(PolygonValidator, sweep) {
+  // star-shaped rings are simple, moving a vertex may break them
+  std::uniform_real_distribution<double> r(5.0, 10.0), jump(-10.0, 10.0);
+  std::uniform_int_distribution<std::size_t> pick(0, 199);
+  std::vector<ns_geo::Polygond> polys;
+  for (int k = 0; k != 400; ++k) {
+    ns_geo::Polygond poly;
+    for (int i = 0; i != 200; ++i) {
+      double theta = 2.0 * M_PI * i / 200, rad = r(ns_geo::engine);
+      poly.push_back({rad * std::cos(theta), rad * std::sin(theta)});
+    }
+    if (k % 2 != 0) {
+      auto &p = poly[pick(ns_geo::engine)];
+      p = {p.x + jump(ns_geo::engine), p.y + jump(ns_geo::engine)};
+    }
+    // snap to a coarse grid now and then, so edges touch and overlap
+    if (k % 4 == 3)
+      for (auto &p : poly)
+        p = {std::round(p.x), std::round(p.y)};
+    polys.push_back(poly);
+  }
+  auto reps = PolygonValidatord::check(polys, 4);
+  ASSERT_EQ(reps.size(), polys.size());
+  std::size_t bad = 0;
+  for (std::size_t k = 0; k != polys.size(); ++k) {
+    bool expect = validator_brute_force(polys[k]);
+    if (k % 4 == 3) {
+      // the snapped rings may repeat vertices, which the brute force sees as touching
+      ns_geo::Polygond dedup = polys[k];
+      PolygonValidatord::removeDuplicates(dedup);
+      expect = validator_brute_force(dedup);
+    }
+    EXPECT_EQ(reps[k].selfIntersecting, expect) << k;
+    bad += expect;
+  }
+  EXPECT_GT(bad, 0);
+  EXPECT_LT(bad, polys.size());
+}
+
+TEST(PolygonValidator, spikeOverlap) {
+  // the boundary of a square with a vertex every unit, the bottom starting with a spike that
+  // runs back over the first edge, so the edge after the spike overlaps it
+  auto ring = [](int side) {
+    ns_geo::Polygond poly{{0.0, 0.0}, {2.0, 0.0}, {1.0, 0.0}};
+    for (int i = 3; i != side; ++i)
+      poly.push_back({double(i), 0.0});
+    for (int i = 0; i != side; ++i)
+      poly.push_back({double(side), double(i)});
+    for (int i = side; i != 0; --i)
+      poly.push_back({double(i), double(side)});
+    for (int i = side; i != 0; --i)
+      poly.push_back({0.0, double(i)});
+    return poly;
+  };
+  // the small ring tests all the pairs, the large one runs the sweep
+  for (int side : {4, 12}) {
+    auto poly = ring(side);
+    auto rep = PolygonValidatord::check(poly);
+    EXPECT_EQ(rep.spikes, (std::vector<std::size_t>{1, 2})) << poly.size();
+    EXPECT_TRUE(rep.selfIntersecting) << poly.size();
+    EXPECT_EQ(rep.crossing, (std::array<std::size_t, 2>{0, 2})) << poly.size();
+  }
+  EXPECT_GT(ring(12).size(), 32);
+}
+
+TEST_F(TestRefPointSet2f, validator) {
+  auto poly = _rps->createRefPolygon({3, 0, 1, 5});
+  auto rep = ns_geo::PolygonValidator<float>::check(poly);
+  EXPECT_EQ(rep.orientation, ns_geo::Orientation::CLOCKWISE);
+  EXPECT_TRUE(ns_geo::PolygonValidator<float>::fixOrientation(poly));
+  EXPECT_EQ(poly.front(), 5);
+  EXPECT_EQ(ns_geo::PolygonValidator<float>::check(poly).orientation, ns_geo::Orientation::COUNTER_CLOCKWISE);
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TEST_VORONOI_H
+#define TEST_VORONOI_H
+
+#include "helper.h"
+#include "include/voronoi.hpp"
+
+TEST(Voronoi2, cells) {
+  ns_geo::RefPointSet2d rps;
+  rps.insert(ns_geo::RefPoint2d(0, 0.0, 0.0));
+  rps.insert(ns_geo::RefPoint2d(1, 2.0, 0.0));
+  rps.insert(ns_geo::RefPoint2d(2, 2.0, 2.0));
+  rps.insert(ns_geo::RefPoint2d(3, 0.0, 2.0));
+  rps.insert(ns_geo::RefPoint2d(4, 1.0, 1.0));
+  ns_geo::Voronoi2<double> vor(rps, ns_geo::Rectangled(-1.0, 3.0, 3.0, -1.0));
+
+  // the centre site owns a diamond
+  auto cell = vor.cellOf(4);
+  ASSERT_EQ(cell.size(), 4);
+  EXPECT_NEAR(cell.area(), 2.0, 1E-6);
+  for (const auto &p : cell)
+    EXPECT_NEAR(std::abs(p.x - 1.0) + std::abs(p.y - 1.0), 1.0, 1E-9);
+
+  // a corner site is clipped by the bound
+  EXPECT_NEAR(vor.cellOf(0).area(), 3.5, 1E-6);
+  EXPECT_THROW(vor.cellOf(10), std::out_of_range);
+}
+
+TEST(Voronoi2, partition) {
+  auto rps = ns_geo::RefPointSet2d::randomGenerator(200, 0.0, 10.0, 0.0, 10.0);
+  ns_geo::Voronoi2<double> vor(rps, ns_geo::Rectangled(2.0, 8.0, 8.0, 2.0));
+  auto cells = vor.cells(2);
+  ASSERT_EQ(cells.size(), 200);
+  double area = 0.0;
+  for (const auto &[id, cell] : cells) {
+    if (cell.empty())
+      continue;
+    area += cell.area();
+    // every corner is at least as close to its own site as to any other
+    const auto &site = rps.at(id);
+    for (const auto &p : cell) {
+      double own = ns_geo::distance(p, ns_geo::Point2d(site.x, site.y));
+      for (const auto &[oid, other] : rps)
+        EXPECT_LE(own, ns_geo::distance(p, ns_geo::Point2d(other.x, other.y)) + 1E-4);
+    }
+  }
+  // the cells tile the bound
+  EXPECT_NEAR(area, 36.0, 1E-3);
+}
+
+TEST(Voronoi2, farBound) {
+  // the hull cells run out to a bound far larger than the sites
+  auto rps = ns_geo::RefPointSet2d::randomGenerator(50, 0.0, 1.0, 0.0, 1.0);
+  for (double half : {400.0, 1E3, 1E4, 1E6}) {
+    ns_geo::Voronoi2<double> vor(rps, ns_geo::Rectangled(-half, half, half, -half));
+    double area = 0.0;
+    for (const auto &[id, cell] : vor.cells())
+      area += cell.area();
+    EXPECT_NEAR(area, 4.0 * half * half, 1E-6 * half * half) << half;
+  }
+}
+
+#endif
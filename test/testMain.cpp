@@ -8,16 +8,39 @@
  *
  */
 
+#include "testBatchFit.h"
+#include "testCalipers.h"
 #include "testCircle.h"
+#include "testClipping.h"
+#include "testContour.h"
+#include "testCurveDistance.h"
+#include "testDelaunay.h"
+#include "testEarCut.h"
+#include "testEllipse.h"
+#include "testHough.h"
+#include "testIncrementalFit.h"
 #include "testLine.h"
 #include "testLinestring.h"
+#include "testMultiModel.h"
+#include "testOffset.h"
 #include "testOstream.h"
+#include "testPlaneSegment.h"
 #include "testPoint.h"
 #include "testPolygon.h"
+#include "testPreparedLineString.h"
+#include "testPreparedPolygon.h"
+#include "testRansac.h"
 #include "testRectangle.h"
+#include "testRobustFit.h"
 #include "testSLine.h"
+#include "testSegmentIntersection.h"
+#include "testSimplify.h"
+#include "testStreamSimplify.h"
+#include "testSpatialJoin.h"
 #include "testTriangle.h"
 #include "testUtility.h"
+#include "testValidator.h"
+#include "testVoronoi.h"
 
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);